@@ -115,6 +115,7 @@ SOURCES += \
     qbuffer.cpp \
     qbytearray.cpp \
     qbytearraymatcher.cpp \
+    qcontainerarena.cpp \
     qcryptographichash.cpp \
     qdatetime.cpp \
     qdir.cpp \
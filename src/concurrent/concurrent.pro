@@ -11,6 +11,7 @@ QMAKE_DOCS = $$PWD/doc/qtconcurrent.qdocconf
 PRECOMPILED_HEADER = ../corelib/global/qt_pch.h
 
 SOURCES += \
+        qtconcurrentalgorithms.cpp \
         qtconcurrentfilter.cpp \
         qtconcurrentmap.cpp \
         qtconcurrentrun.cpp \
@@ -19,6 +20,8 @@ SOURCES += \
 
 HEADERS += \
         qtconcurrent_global.h \
+        qtconcurrentalgorithmkernel.h \
+        qtconcurrentalgorithms.h \
         qtconcurrentcompilertest.h \
         qtconcurrentexception.h \
         qtconcurrentfilter.h \
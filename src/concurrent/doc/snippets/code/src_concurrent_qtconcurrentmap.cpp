@@ -197,3 +197,8 @@ struct Scaled
 QList<QImage> images = ...;
 QFuture<QImage> thumbnails = QtConcurrent::mapped(images, Scaled(100));
 //! [14]
+
+//! [15]
+QVector<double> samples = ...;
+QtConcurrent::blockingMap(samples, normalize, QtConcurrent::StaticPartitioning);
+//! [15]
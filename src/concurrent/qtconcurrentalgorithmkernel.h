@@ -0,0 +1,369 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTCONCURRENT_ALGORITHMKERNEL_H
+#define QTCONCURRENT_ALGORITHMKERNEL_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined (Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentiteratekernel.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qscopedpointer.h>
+
+#include <algorithm>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtConcurrent {
+
+// Splits count items into at most maxChunkCount chunks of at least
+// minimumChunkSize items, rounding the number of chunks down to a power of two.
+inline int algorithmChunkCount(int count, int maxChunkCount, int minimumChunkSize = 1024)
+{
+    int chunkCount = 1;
+    while (chunkCount * 2 <= maxChunkCount && count / (chunkCount * 2) >= minimumChunkSize)
+        chunkCount *= 2;
+    return chunkCount;
+}
+
+// Runs a set of tasks that may be extended while it runs: a task that
+// completes the inputs of another task adds that task, and the thread that
+// added it keeps going with it. Threads exit when they find no task left.
+template <typename Task>
+class TaskKernel : public ThreadEngine<void>
+{
+public:
+    typedef void ResultType;
+
+    virtual void runTask(const Task &task) = 0;
+
+    void addTask(const Task &task)
+    {
+        QMutexLocker locker(&mutex);
+        tasks.append(task);
+    }
+
+    bool shouldStartThread() override
+    {
+        {
+            QMutexLocker locker(&mutex);
+            if (tasks.isEmpty())
+                return false;
+        }
+        return ThreadEngine<void>::shouldStartThread();
+    }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        for (;;) {
+            if (this->isCanceled())
+                break;
+
+            Task task;
+            {
+                QMutexLocker locker(&mutex);
+                if (tasks.isEmpty())
+                    break;
+                task = tasks.takeLast();
+            }
+
+            this->waitForResume(); // (only waits if the qfuture is paused.)
+
+            if (shouldStartThread())
+                this->startThread();
+
+            runTask(task);
+
+            if (this->shouldThrottleThread())
+                return ThrottleThread;
+        }
+        return ThreadFinished;
+    }
+
+private:
+    QMutex mutex;
+    QVector<Task> tasks;
+};
+
+// Sorts the chunks of the sequence concurrently, then merges them pairwise.
+// The tasks are the nodes of a complete binary tree numbered from 1 at the
+// root, where the leaves chunkCount to 2 * chunkCount - 1 are the chunks.
+template <typename Iterator, typename LessThan>
+class SortKernel : public TaskKernel<int>
+{
+public:
+    SortKernel(Iterator _begin, Iterator _end, LessThan _lessThan)
+        : begin(_begin), count(int(std::distance(_begin, _end))), lessThan(_lessThan),
+          chunkCount(algorithmChunkCount(count, 2 * qMax(1, threadPool->maxThreadCount()))),
+          pendingChildren(new QAtomicInt[chunkCount])
+    { }
+
+    void start() override
+    {
+        for (int node = 1; node < chunkCount; ++node)
+            pendingChildren[node].store(2);
+        for (int node = chunkCount; node < 2 * chunkCount; ++node)
+            addTask(node);
+    }
+
+    void runTask(const int &node) override
+    {
+        if (node >= chunkCount) {
+            std::sort(begin + chunkBegin(node - chunkCount),
+                      begin + chunkBegin(node - chunkCount + 1), lessThan);
+        } else {
+            int first = node;
+            int last = node + 1;
+            while (first < chunkCount) {
+                first *= 2;
+                last *= 2;
+            }
+            std::inplace_merge(begin + chunkBegin(first - chunkCount),
+                               begin + chunkBegin((first + last) / 2 - chunkCount),
+                               begin + chunkBegin(last - chunkCount), lessThan);
+        }
+
+        // The sibling that finishes second merges both halves.
+        const int parent = node / 2;
+        if (parent > 0 && !pendingChildren[parent].deref())
+            addTask(parent);
+    }
+
+private:
+    int chunkBegin(int chunk) const
+    {
+        return int(qint64(count) * chunk / chunkCount);
+    }
+
+    const Iterator begin;
+    const int count;
+    LessThan lessThan;
+    const int chunkCount;
+    QScopedArrayPointer<QAtomicInt> pendingChildren;
+};
+
+struct InclusiveScanTask
+{
+    InclusiveScanTask(int _chunk = 0, bool _applyCarry = false)
+        : chunk(_chunk), applyCarry(_applyCarry) { }
+
+    int chunk;
+    bool applyCarry;
+};
+
+// Scans the chunks of the sequence concurrently, then combines the items of
+// each chunk with the result for all chunks before it. Those carries are
+// computed by the thread that finishes the last chunk.
+template <typename Iterator, typename BinaryOperation>
+class InclusiveScanKernel : public TaskKernel<InclusiveScanTask>
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+public:
+    InclusiveScanKernel(Iterator _begin, Iterator _end, BinaryOperation _operation)
+        : begin(_begin), count(int(std::distance(_begin, _end))), operation(_operation),
+          chunkCount(algorithmChunkCount(count, qMax(1, threadPool->maxThreadCount()))),
+          pendingChunks(chunkCount), carries(chunkCount)
+    { }
+
+    void start() override
+    {
+        for (int chunk = 0; chunk < chunkCount; ++chunk)
+            addTask(InclusiveScanTask(chunk));
+    }
+
+    void runTask(const InclusiveScanTask &task) override
+    {
+        const Iterator first = begin + chunkBegin(task.chunk);
+        const Iterator last = begin + chunkBegin(task.chunk + 1);
+
+        if (task.applyCarry) {
+            const T &carry = carries.at(task.chunk);
+            for (Iterator it = first; it != last; ++it)
+                *it = operation(carry, *it);
+            return;
+        }
+
+        if (first != last) {
+            for (Iterator previous = first, it = first + 1; it != last; previous = it, ++it)
+                *it = operation(*previous, *it);
+        }
+
+        if (pendingChunks.deref())
+            return;
+
+        // Every chunk is scanned now, so the carries are known.
+        for (int chunk = 1; chunk < chunkCount; ++chunk) {
+            const T &previousLast = *(begin + (chunkBegin(chunk) - 1));
+            carries[chunk] = (chunk == 1) ? previousLast : operation(carries.at(chunk - 1), previousLast);
+        }
+        for (int chunk = 1; chunk < chunkCount; ++chunk)
+            addTask(InclusiveScanTask(chunk, true));
+    }
+
+private:
+    int chunkBegin(int chunk) const
+    {
+        return int(qint64(count) * chunk / chunkCount);
+    }
+
+    const Iterator begin;
+    const int count;
+    BinaryOperation operation;
+    const int chunkCount;
+    QAtomicInt pendingChunks;
+    QVector<T> carries;
+};
+
+// Transforms the items of each block and reduces them to a partial result,
+// which is then reduced into the total under a mutex.
+template <typename Iterator, typename T, typename ReduceFunctor, typename TransformFunctor>
+class TransformReduceKernel : public IterateKernel<Iterator, T>
+{
+public:
+    typedef T ReturnType;
+    typedef T ResultType;
+
+    TransformReduceKernel(Iterator begin, Iterator end, const T &init,
+                          ReduceFunctor _reduce, TransformFunctor _transform)
+        : IterateKernel<Iterator, T>(begin, end), reducedResult(init),
+          reduce(_reduce), transform(_transform)
+    { }
+
+    bool runIteration(Iterator it, int, T *) override
+    {
+        T partial = transform(*it);
+        QMutexLocker locker(&mutex);
+        reducedResult = reduce(reducedResult, partial);
+        return false;
+    }
+
+    bool runIterations(Iterator sequenceBeginIterator, int begin, int end, T *) override
+    {
+        Iterator it = sequenceBeginIterator;
+        std::advance(it, begin);
+        T partial = transform(*it);
+        for (int i = begin + 1; i < end; ++i) {
+            std::advance(it, 1);
+            partial = reduce(partial, transform(*it));
+        }
+
+        QMutexLocker locker(&mutex);
+        reducedResult = reduce(reducedResult, partial);
+        return false;
+    }
+
+    T *result() override
+    {
+        return &reducedResult;
+    }
+
+private:
+    QMutex mutex;
+    T reducedResult;
+    ReduceFunctor reduce;
+    TransformFunctor transform;
+};
+
+template <typename Sequence, typename Base, typename T, typename Functor1, typename Functor2>
+struct SequenceHolder3 : public Base
+{
+    SequenceHolder3(const Sequence &_sequence, const T &init, Functor1 functor1, Functor2 functor2)
+        : Base(_sequence.begin(), _sequence.end(), init, functor1, functor2),
+          sequence(_sequence)
+    { }
+
+    Sequence sequence;
+
+    void finish() override
+    {
+        Base::finish();
+        // Clear the sequence to make sure all temporaries are destroyed
+        // before finished is signaled.
+        sequence = Sequence();
+    }
+};
+
+//! [qtconcurrentalgorithmkernel-1]
+template <typename Iterator, typename LessThan>
+inline ThreadEngineStarter<void> startSort(Iterator begin, Iterator end, LessThan lessThan)
+{
+    return startThreadEngine(new SortKernel<Iterator, LessThan>(begin, end, lessThan));
+}
+
+//! [qtconcurrentalgorithmkernel-2]
+template <typename Iterator, typename BinaryOperation>
+inline ThreadEngineStarter<void> startInclusiveScan(Iterator begin, Iterator end, BinaryOperation operation)
+{
+    return startThreadEngine(new InclusiveScanKernel<Iterator, BinaryOperation>(begin, end, operation));
+}
+
+//! [qtconcurrentalgorithmkernel-3]
+template <typename T, typename Iterator, typename ReduceFunctor, typename TransformFunctor>
+inline ThreadEngineStarter<T> startTransformReduce(Iterator begin, Iterator end, const T &init,
+                                                   ReduceFunctor reduce, TransformFunctor transform)
+{
+    typedef TransformReduceKernel<Iterator, T, ReduceFunctor, TransformFunctor> KernelType;
+    return startThreadEngine(new KernelType(begin, end, init, reduce, transform));
+}
+
+//! [qtconcurrentalgorithmkernel-4]
+template <typename T, typename Sequence, typename ReduceFunctor, typename TransformFunctor>
+inline ThreadEngineStarter<T> startTransformReduce(const Sequence &sequence, const T &init,
+                                                   ReduceFunctor reduce, TransformFunctor transform)
+{
+    typedef TransformReduceKernel<typename Sequence::const_iterator, T, ReduceFunctor, TransformFunctor> KernelType;
+    typedef SequenceHolder3<Sequence, KernelType, T, ReduceFunctor, TransformFunctor> SequenceHolderType;
+    return startThreadEngine(new SequenceHolderType(sequence, init, reduce, transform));
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
@@ -0,0 +1,348 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+/*!
+  \class QtConcurrent::TaskKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::SortKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::InclusiveScanKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::TransformReduceKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::SequenceHolder3
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-1] ThreadEngineStarter<void> QtConcurrent::startSort(Iterator begin, Iterator end, LessThan lessThan)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-2] ThreadEngineStarter<void> QtConcurrent::startInclusiveScan(Iterator begin, Iterator end, BinaryOperation operation)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-3] ThreadEngineStarter<T> QtConcurrent::startTransformReduce(Iterator begin, Iterator end, const T &init, ReduceFunctor reduce, TransformFunctor transform)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-4] ThreadEngineStarter<T> QtConcurrent::startTransformReduce(const Sequence &sequence, const T &init, ReduceFunctor reduce, TransformFunctor transform)
+  \internal
+*/
+
+/*!
+    \page qtconcurrentalgorithms.html
+    \title Concurrent Sort, Scan and Transform-Reduce
+    \ingroup thread
+
+    The QtConcurrent::sort(), QtConcurrent::inclusiveScan() and
+    QtConcurrent::transformReduce() functions run common algorithms in
+    parallel on the items of a container with random-access iterators, such
+    as QVector or QList.
+
+    These functions are part of the \l {Qt Concurrent} framework. Like the
+    map and filter functions, they use the threads of the global
+    QThreadPool, and return a QFuture that can be used to wait for the
+    algorithm, to pause or to cancel it. Each function has a blocking variant
+    that returns once the algorithm is done.
+
+    \section1 Concurrent Sort
+
+    QtConcurrent::sort() sorts the items of a container in-place. The
+    container is split into blocks that are sorted concurrently and then
+    merged. The items are compared with \c{operator<()}, unless a comparison
+    function is passed:
+
+    \snippet code/src_concurrent_qtconcurrentalgorithms.cpp 0
+
+    The sort is not stable. If it is canceled, the items are left in an
+    unspecified order.
+
+    \section1 Concurrent Inclusive Scan
+
+    QtConcurrent::inclusiveScan() replaces each item of a container with the
+    result of combining it with all the items before it, which is the sum of
+    the items unless a binary operation is passed:
+
+    \snippet code/src_concurrent_qtconcurrentalgorithms.cpp 1
+
+    Since the items are combined in blocks, the operation must be
+    associative. It is called concurrently from several threads.
+
+    \section1 Concurrent Transform-Reduce
+
+    QtConcurrent::transformReduce() calls a transform function on each item
+    of a container, and combines the results and an initial value with a
+    binary reduce operation:
+
+    \snippet code/src_concurrent_qtconcurrentalgorithms.cpp 2
+
+    Unlike QtConcurrent::mappedReduced(), the reduce operation combines two
+    values and returns the result, and it is called concurrently for
+    different parts of the container. It must be associative and
+    commutative, because the order in which the partial results are combined
+    is undefined.
+*/
+
+/*!
+    \fn template <typename Sequence> QFuture<void> QtConcurrent::sort(Sequence &sequence)
+    \since 5.12
+
+    Sorts the items of \a sequence in ascending order, comparing them with
+    \c{operator<()}.
+
+    \sa blockingSort(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::sort(Sequence &sequence, LessThan lessThan)
+    \since 5.12
+
+    Sorts the items of \a sequence in the order defined by \a lessThan, which
+    must return \c true if its first argument is less than its second.
+
+    \sa blockingSort(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator> QFuture<void> QtConcurrent::sort(Iterator begin, Iterator end)
+    \since 5.12
+
+    Sorts the items from \a begin to \a end in ascending order, comparing
+    them with \c{operator<()}.
+
+    \sa blockingSort(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> QFuture<void> QtConcurrent::sort(Iterator begin, Iterator end, LessThan lessThan)
+    \since 5.12
+
+    Sorts the items from \a begin to \a end in the order defined by
+    \a lessThan.
+
+    \sa blockingSort(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence> void QtConcurrent::blockingSort(Sequence &sequence)
+    \since 5.12
+
+    Sorts the items of \a sequence in ascending order, comparing them with
+    \c{operator<()}.
+
+    \note This function will block until the sequence is sorted.
+
+    \sa sort(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingSort(Sequence &sequence, LessThan lessThan)
+    \since 5.12
+
+    Sorts the items of \a sequence in the order defined by \a lessThan.
+
+    \note This function will block until the sequence is sorted.
+
+    \sa sort(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator> void QtConcurrent::blockingSort(Iterator begin, Iterator end)
+    \since 5.12
+
+    Sorts the items from \a begin to \a end in ascending order, comparing
+    them with \c{operator<()}.
+
+    \note This function will block until the items are sorted.
+
+    \sa sort(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> void QtConcurrent::blockingSort(Iterator begin, Iterator end, LessThan lessThan)
+    \since 5.12
+
+    Sorts the items from \a begin to \a end in the order defined by
+    \a lessThan.
+
+    \note This function will block until the items are sorted.
+
+    \sa sort(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence> QFuture<void> QtConcurrent::inclusiveScan(Sequence &sequence)
+    \since 5.12
+
+    Replaces each item of \a sequence with the sum of itself and all the
+    items before it.
+
+    \sa blockingInclusiveScan(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(Sequence &sequence, BinaryOperation operation)
+    \since 5.12
+
+    Replaces each item of \a sequence with the result of combining itself
+    and all the items before it using \a operation, which must be
+    associative.
+
+    \sa blockingInclusiveScan(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(Iterator begin, Iterator end, BinaryOperation operation)
+    \since 5.12
+
+    Replaces each item from \a begin to \a end with the result of combining
+    itself and all the items before it using \a operation, which must be
+    associative.
+
+    \sa blockingInclusiveScan(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence> void QtConcurrent::blockingInclusiveScan(Sequence &sequence)
+    \since 5.12
+
+    Replaces each item of \a sequence with the sum of itself and all the
+    items before it.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(Sequence &sequence, BinaryOperation operation)
+    \since 5.12
+
+    Replaces each item of \a sequence with the result of combining itself
+    and all the items before it using \a operation, which must be
+    associative.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(Iterator begin, Iterator end, BinaryOperation operation)
+    \since 5.12
+
+    Replaces each item from \a begin to \a end with the result of combining
+    itself and all the items before it using \a operation, which must be
+    associative.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename ReduceFunctor, typename TransformFunctor> QFuture<T> QtConcurrent::transformReduce(const Sequence &sequence, T init, ReduceFunctor reduce, TransformFunctor transform)
+    \since 5.12
+
+    Calls \a transform once for each item in \a sequence, and combines the
+    results and \a init using \a reduce. The future holds the final value.
+
+    \a reduce is called concurrently, and in an undefined order, so it must
+    be associative and commutative.
+
+    \sa blockingTransformReduce(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename T, typename ReduceFunctor, typename TransformFunctor> QFuture<T> QtConcurrent::transformReduce(Iterator begin, Iterator end, T init, ReduceFunctor reduce, TransformFunctor transform)
+    \since 5.12
+
+    Calls \a transform once for each item from \a begin to \a end, and
+    combines the results and \a init using \a reduce. The future holds the
+    final value.
+
+    \sa blockingTransformReduce(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename ReduceFunctor, typename TransformFunctor> T QtConcurrent::blockingTransformReduce(const Sequence &sequence, T init, ReduceFunctor reduce, TransformFunctor transform)
+    \since 5.12
+
+    Calls \a transform once for each item in \a sequence, and returns the
+    combination of the results and \a init using \a reduce.
+
+    \note This function will block until all items have been processed.
+
+    \sa transformReduce(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename T, typename ReduceFunctor, typename TransformFunctor> T QtConcurrent::blockingTransformReduce(Iterator begin, Iterator end, T init, ReduceFunctor reduce, TransformFunctor transform)
+    \since 5.12
+
+    Calls \a transform once for each item from \a begin to \a end, and
+    returns the combination of the results and \a init using \a reduce.
+
+    \note This function will block until all items have been processed.
+
+    \sa transformReduce(), {Concurrent Sort, Scan and Transform-Reduce}
+*/
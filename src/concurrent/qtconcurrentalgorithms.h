@@ -0,0 +1,189 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTCONCURRENT_ALGORITHMS_H
+#define QTCONCURRENT_ALGORITHMS_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentalgorithmkernel.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+
+
+namespace QtConcurrent {
+
+// sort() on sequences
+template <typename Sequence>
+QFuture<void> sort(Sequence &sequence)
+{
+    return startSort(sequence.begin(), sequence.end(), std::less<typename Sequence::value_type>());
+}
+
+template <typename Sequence, typename LessThan>
+QFuture<void> sort(Sequence &sequence, LessThan lessThan)
+{
+    return startSort(sequence.begin(), sequence.end(), lessThan);
+}
+
+// sort() on iterators
+template <typename Iterator>
+QFuture<void> sort(Iterator begin, Iterator end)
+{
+    return startSort(begin, end, std::less<typename std::iterator_traits<Iterator>::value_type>());
+}
+
+template <typename Iterator, typename LessThan>
+QFuture<void> sort(Iterator begin, Iterator end, LessThan lessThan)
+{
+    return startSort(begin, end, lessThan);
+}
+
+// blockingSort() on sequences
+template <typename Sequence>
+void blockingSort(Sequence &sequence)
+{
+    startSort(sequence.begin(), sequence.end(), std::less<typename Sequence::value_type>()).startBlocking();
+}
+
+template <typename Sequence, typename LessThan>
+void blockingSort(Sequence &sequence, LessThan lessThan)
+{
+    startSort(sequence.begin(), sequence.end(), lessThan).startBlocking();
+}
+
+// blockingSort() on iterators
+template <typename Iterator>
+void blockingSort(Iterator begin, Iterator end)
+{
+    startSort(begin, end, std::less<typename std::iterator_traits<Iterator>::value_type>()).startBlocking();
+}
+
+template <typename Iterator, typename LessThan>
+void blockingSort(Iterator begin, Iterator end, LessThan lessThan)
+{
+    startSort(begin, end, lessThan).startBlocking();
+}
+
+// inclusiveScan() on sequences
+template <typename Sequence>
+QFuture<void> inclusiveScan(Sequence &sequence)
+{
+    return startInclusiveScan(sequence.begin(), sequence.end(), std::plus<typename Sequence::value_type>());
+}
+
+template <typename Sequence, typename BinaryOperation>
+QFuture<void> inclusiveScan(Sequence &sequence, BinaryOperation operation)
+{
+    return startInclusiveScan(sequence.begin(), sequence.end(), operation);
+}
+
+// inclusiveScan() on iterators
+template <typename Iterator, typename BinaryOperation>
+QFuture<void> inclusiveScan(Iterator begin, Iterator end, BinaryOperation operation)
+{
+    return startInclusiveScan(begin, end, operation);
+}
+
+// blockingInclusiveScan() on sequences
+template <typename Sequence>
+void blockingInclusiveScan(Sequence &sequence)
+{
+    startInclusiveScan(sequence.begin(), sequence.end(), std::plus<typename Sequence::value_type>()).startBlocking();
+}
+
+template <typename Sequence, typename BinaryOperation>
+void blockingInclusiveScan(Sequence &sequence, BinaryOperation operation)
+{
+    startInclusiveScan(sequence.begin(), sequence.end(), operation).startBlocking();
+}
+
+// blockingInclusiveScan() on iterators
+template <typename Iterator, typename BinaryOperation>
+void blockingInclusiveScan(Iterator begin, Iterator end, BinaryOperation operation)
+{
+    startInclusiveScan(begin, end, operation).startBlocking();
+}
+
+// transformReduce() on sequences
+template <typename Sequence, typename T, typename ReduceFunctor, typename TransformFunctor>
+QFuture<T> transformReduce(const Sequence &sequence, T init,
+                           ReduceFunctor reduce, TransformFunctor transform)
+{
+    return startTransformReduce<T>(sequence, init, reduce, transform);
+}
+
+// transformReduce() on iterators
+template <typename Iterator, typename T, typename ReduceFunctor, typename TransformFunctor>
+QFuture<T> transformReduce(Iterator begin, Iterator end, T init,
+                           ReduceFunctor reduce, TransformFunctor transform)
+{
+    return startTransformReduce<T>(begin, end, init, reduce, transform);
+}
+
+// blockingTransformReduce() on sequences
+template <typename Sequence, typename T, typename ReduceFunctor, typename TransformFunctor>
+T blockingTransformReduce(const Sequence &sequence, T init,
+                          ReduceFunctor reduce, TransformFunctor transform)
+{
+    return startTransformReduce<T>(sequence, init, reduce, transform).startBlocking();
+}
+
+// blockingTransformReduce() on iterators
+template <typename Iterator, typename T, typename ReduceFunctor, typename TransformFunctor>
+T blockingTransformReduce(Iterator begin, Iterator end, T init,
+                          ReduceFunctor reduce, TransformFunctor transform)
+{
+    return startTransformReduce<T>(begin, end, init, reduce, transform).startBlocking();
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
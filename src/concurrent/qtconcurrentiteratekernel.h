@@ -113,12 +113,18 @@ private:
     Q_DISABLE_COPY(BlockSizeManagerV2)
 };
 
+enum Partitioning {
+    AdaptivePartitioning,
+    StaticPartitioning,
+    GuidedPartitioning
+};
+
 template <typename T>
 class ResultReporter
 {
 public:
-    ResultReporter(ThreadEngine<T> *_threadEngine)
-    :threadEngine(_threadEngine)
+    ResultReporter(ThreadEngine<T> *_threadEngine, T *_contiguousResults = nullptr)
+    :threadEngine(_threadEngine), contiguousResults(_contiguousResults)
     {
 
     }
@@ -126,11 +132,18 @@ public:
     void reserveSpace(int resultCount)
     {
         currentResultCount = resultCount;
-        vector.resize(qMax(resultCount, vector.count()));
+        if (!contiguousResults)
+            vector.resize(qMax(resultCount, vector.count()));
     }
 
     void reportResults(int begin)
     {
+        if (contiguousResults) {
+            // The results were written straight into the result store.
+            threadEngine->reportContiguousResults(begin, currentResultCount);
+            return;
+        }
+
         const int useVectorThreshold = 4; // Tunable parameter.
         if (currentResultCount > useVectorThreshold) {
             vector.resize(currentResultCount);
@@ -141,13 +154,14 @@ public:
         }
     }
 
-    inline T * getPointer()
+    inline T * getPointer(int begin)
     {
-        return vector.data();
+        return contiguousResults ? contiguousResults + begin : vector.data();
     }
 
     int currentResultCount;
     ThreadEngine<T> *threadEngine;
+    T *contiguousResults;
     QVector<T> vector;
 };
 
@@ -155,10 +169,10 @@ template <>
 class ResultReporter<void>
 {
 public:
-    inline ResultReporter(ThreadEngine<void> *) { }
+    inline ResultReporter(ThreadEngine<void> *, void * = nullptr) { }
     inline void reserveSpace(int) { }
     inline void reportResults(int) { }
-    inline void * getPointer() { return nullptr; }
+    inline void * getPointer(int) { return nullptr; }
 };
 
 inline bool selectIteration(std::bidirectional_iterator_tag)
@@ -184,7 +198,8 @@ public:
 
     IterateKernel(Iterator _begin, Iterator _end)
         : begin(_begin), end(_end), current(_begin), currentIndex(0),
-           forIteration(selectIteration(typename std::iterator_traits<Iterator>::iterator_category())), progressReportingEnabled(true)
+           forIteration(selectIteration(typename std::iterator_traits<Iterator>::iterator_category())), progressReportingEnabled(true),
+           contiguousResults(nullptr), partitioning(AdaptivePartitioning)
     {
         iterationCount =  forIteration ? std::distance(_begin, _end) : 0;
     }
@@ -219,16 +234,40 @@ public:
             return this->whileThreadFunction();
     }
 
+    // Returns the number of iterations the calling thread reserves next.
+    int nextBlockSize(BlockSizeManagerV2 &blockSizeManager, int threadCount)
+    {
+        switch (partitioning) {
+        case StaticPartitioning:
+            // One contiguous block per thread, counting the calling thread of
+            // a blocking call.
+            return qMax(1, (iterationCount + threadCount - 1) / threadCount);
+        case GuidedPartitioning: {
+            // Blocks shrink with the remaining work, so the threads finish together.
+            const int remaining = iterationCount - currentIndex.load();
+            return qMax(1, (remaining + threadCount - 1) / threadCount);
+        }
+        case AdaptivePartitioning:
+            break;
+        }
+        return blockSizeManager.blockSize();
+    }
+
     ThreadFunctionResult forThreadFunction()
     {
         BlockSizeManagerV2 blockSizeManager(iterationCount);
-        ResultReporter<T> resultReporter(this);
+        ResultReporter<T> resultReporter(this, contiguousResults);
+        // Without a future, the kernel runs in the calling thread as well
+        // (startBlocking()), which takes blocks next to the pool threads.
+        const int threadCount = qMax(1, this->threadPool->maxThreadCount())
+                + (this->futureInterface ? 0 : 1);
+        const bool adaptive = (partitioning == AdaptivePartitioning);
 
         for(;;) {
             if (this->isCanceled())
                 break;
 
-            const int currentBlockSize = blockSizeManager.blockSize();
+            const int currentBlockSize = nextBlockSize(blockSizeManager, threadCount);
 
             if (currentIndex.load() >= iterationCount)
                 break;
@@ -251,9 +290,11 @@ public:
             resultReporter.reserveSpace(finalBlockSize);
 
             // Call user code with the current iteration range.
-            blockSizeManager.timeBeforeUser();
-            const bool resultsAvailable = this->runIterations(begin, beginIndex, endIndex, resultReporter.getPointer());
-            blockSizeManager.timeAfterUser();
+            if (adaptive)
+                blockSizeManager.timeBeforeUser();
+            const bool resultsAvailable = this->runIterations(begin, beginIndex, endIndex, resultReporter.getPointer(beginIndex));
+            if (adaptive)
+                blockSizeManager.timeAfterUser();
 
             if (resultsAvailable)
                 resultReporter.reportResults(beginIndex);
@@ -292,7 +333,7 @@ public:
             if (shouldStartThread())
                 this->startThread();
 
-            const bool resultAavailable = this->runIteration(prev, index, resultReporter.getPointer());
+            const bool resultAavailable = this->runIteration(prev, index, resultReporter.getPointer(index));
             if (resultAavailable)
                 resultReporter.reportResults(index);
 
@@ -318,6 +359,13 @@ public:
 
     bool progressReportingEnabled;
     QAtomicInt completed;
+
+    // When set by the kernel in start(), each block of results is written in
+    // place into the future's result store instead of a per-thread vector.
+    T *contiguousResults;
+
+    // How the iterations of a sequence of known size are split into blocks.
+    Partitioning partitioning;
 };
 
 } // namespace QtConcurrent
@@ -94,17 +94,17 @@
 */
 
 /*!
-  \fn [qtconcurrentmapkernel-1] ThreadEngineStarter<void> QtConcurrent::startMap(Iterator begin, Iterator end, Functor functor)
+  \fn [qtconcurrentmapkernel-1] ThreadEngineStarter<void> QtConcurrent::startMap(Iterator begin, Iterator end, Functor functor, Partitioning partitioning)
   \internal
 */
 
 /*!
-  \fn [qtconcurrentmapkernel-2] ThreadEngineStarter<T> QtConcurrent::startMapped(Iterator begin, Iterator end, Functor functor)
+  \fn [qtconcurrentmapkernel-2] ThreadEngineStarter<T> QtConcurrent::startMapped(Iterator begin, Iterator end, Functor functor, Partitioning partitioning)
   \internal
 */
 
 /*!
-  \fn [qtconcurrentmapkernel-3] ThreadEngineStarter<T> QtConcurrent::startMapped(const Sequence &sequence, Functor functor)
+  \fn [qtconcurrentmapkernel-3] ThreadEngineStarter<T> QtConcurrent::startMapped(const Sequence &sequence, Functor functor, Partitioning partitioning)
   \internal
 */
 
@@ -223,6 +223,20 @@
 
     \section1 Additional API Features
 
+    \section2 Choosing How the Work Is Split
+
+    For sequences with random access iterators, QtConcurrent::map(),
+    QtConcurrent::mapped() and QtConcurrent::blockingMap() take an optional
+    QtConcurrent::Partitioning argument that selects how the items are
+    divided between the threads:
+
+    \snippet code/src_concurrent_qtconcurrentmap.cpp 15
+
+    The default, QtConcurrent::AdaptivePartitioning, suits map functions of
+    unknown or varying cost. When each item takes about the same time,
+    QtConcurrent::StaticPartitioning gives every thread one contiguous part
+    of the sequence, which keeps each thread working on the same memory.
+
     \section2 Using Iterators instead of Sequence
 
     Each of the above functions has a variant that takes an iterator range
@@ -291,41 +305,68 @@
 */
 
 /*!
-    \fn template <typename Sequence, typename MapFunctor> QFuture<void> QtConcurrent::map(Sequence &sequence, MapFunctor function)
+    \enum QtConcurrent::Partitioning
+    \since 5.12
+
+    This enum specifies how the items of a sequence with random access
+    iterators are divided into blocks that the threads process.
+
+    \value AdaptivePartitioning Each thread starts with blocks of one item,
+    and doubles the block size while the time spent in the map function is
+    small compared with the time spent distributing the work. This is the
+    default.
+    \value StaticPartitioning The sequence is split into one contiguous
+    block per thread of the thread pool. The blocking functions also run
+    the map function in the calling thread, which gets a block as well.
+    This has the least overhead, but threads that finish early stay idle.
+    \value GuidedPartitioning Each block covers an equal share of the
+    remaining items for every thread, so blocks get smaller towards the end
+    of the sequence.
+
+    Sequences without random access iterators are always processed one item
+    at a time.
+*/
+
+/*!
+    \fn template <typename Sequence, typename MapFunctor> QFuture<void> QtConcurrent::map(Sequence &sequence, MapFunctor function, QtConcurrent::Partitioning partitioning)
 
     Calls \a function once for each item in \a sequence. The \a function is
     passed a reference to the item, so that any modifications done to the item
-    will appear in \a sequence.
+    will appear in \a sequence. The items are divided between the threads as
+    specified by \a partitioning.
 
     \sa {Concurrent Map and Map-Reduce}
 */
 
 /*!
-    \fn template <typename Iterator, typename MapFunctor> QFuture<void> QtConcurrent::map(Iterator begin, Iterator end, MapFunctor function)
+    \fn template <typename Iterator, typename MapFunctor> QFuture<void> QtConcurrent::map(Iterator begin, Iterator end, MapFunctor function, QtConcurrent::Partitioning partitioning)
 
     Calls \a function once for each item from \a begin to \a end. The
     \a function is passed a reference to the item, so that any modifications
     done to the item will appear in the sequence which the iterators belong to.
+    The items are divided between the threads as specified by \a partitioning.
 
     \sa {Concurrent Map and Map-Reduce}
 */
 
 /*!
-    \fn template <typename Sequence, typename MapFunctor> QFuture<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType> QtConcurrent::mapped(const Sequence &sequence, MapFunctor function)
+    \fn template <typename Sequence, typename MapFunctor> QFuture<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType> QtConcurrent::mapped(const Sequence &sequence, MapFunctor function, QtConcurrent::Partitioning partitioning)
 
     Calls \a function once for each item in \a sequence and returns a future
     with each mapped item as a result. You can use QFuture::const_iterator or
-    QFutureIterator to iterate through the results.
+    QFutureIterator to iterate through the results. The items are divided
+    between the threads as specified by \a partitioning.
 
     \sa {Concurrent Map and Map-Reduce}
 */
 
 /*!
-    \fn template <typename Iterator, typename MapFunctor> QFuture<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType> QtConcurrent::mapped(Iterator begin, Iterator end, MapFunctor function)
+    \fn template <typename Iterator, typename MapFunctor> QFuture<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType> QtConcurrent::mapped(Iterator begin, Iterator end, MapFunctor function, QtConcurrent::Partitioning partitioning)
 
     Calls \a function once for each item from \a begin to \a end and returns a
     future with each mapped item as a result. You can use
     QFuture::const_iterator or QFutureIterator to iterate through the results.
+    The items are divided between the threads as specified by \a partitioning.
 
     \sa {Concurrent Map and Map-Reduce}
 */
@@ -359,11 +400,12 @@
 */
 
 /*!
-  \fn template <typename Sequence, typename MapFunctor> void QtConcurrent::blockingMap(Sequence &sequence, MapFunctor function)
+  \fn template <typename Sequence, typename MapFunctor> void QtConcurrent::blockingMap(Sequence &sequence, MapFunctor function, QtConcurrent::Partitioning partitioning)
 
   Calls \a function once for each item in \a sequence. The \a function is
   passed a reference to the item, so that any modifications done to the item
-  will appear in \a sequence.
+  will appear in \a sequence. The items are divided between the threads as
+  specified by \a partitioning.
 
   \note This function will block until all items in the sequence have been processed.
 
@@ -371,11 +413,12 @@
 */
 
 /*!
-  \fn template <typename Iterator, typename MapFunctor> void QtConcurrent::blockingMap(Iterator begin, Iterator end, MapFunctor function)
+  \fn template <typename Iterator, typename MapFunctor> void QtConcurrent::blockingMap(Iterator begin, Iterator end, MapFunctor function, QtConcurrent::Partitioning partitioning)
 
   Calls \a function once for each item from \a begin to \a end. The
   \a function is passed a reference to the item, so that any modifications
   done to the item will appear in the sequence which the iterators belong to.
+  The items are divided between the threads as specified by \a partitioning.
 
   \note This function will block until the iterator reaches the end of the
   sequence being processed.
@@ -170,6 +170,16 @@ public:
     MappedEachKernel(Iterator begin, Iterator end, MapFunctor _map)
         : IterateKernel<Iterator, T>(begin, end), map(_map) { }
 
+    void start() override
+    {
+        IterateKernel<Iterator, T>::start();
+
+        // Every index of a sequence of known size gets a result, so the
+        // results can be stored in one array that the threads fill in place.
+        if (this->forIteration && this->iterationCount > 0)
+            this->contiguousResults = this->reserveContiguousResults(this->iterationCount);
+    }
+
     bool runIteration(Iterator it, int,  T *result) override
     {
         *result = map(*it);
@@ -192,16 +202,22 @@ public:
 
 //! [qtconcurrentmapkernel-1]
 template <typename Iterator, typename Functor>
-inline ThreadEngineStarter<void> startMap(Iterator begin, Iterator end, Functor functor)
+inline ThreadEngineStarter<void> startMap(Iterator begin, Iterator end, Functor functor,
+                                          Partitioning partitioning = AdaptivePartitioning)
 {
-    return startThreadEngine(new MapKernel<Iterator, Functor>(begin, end, functor));
+    MapKernel<Iterator, Functor> *kernel = new MapKernel<Iterator, Functor>(begin, end, functor);
+    kernel->partitioning = partitioning;
+    return startThreadEngine(kernel);
 }
 
 //! [qtconcurrentmapkernel-2]
 template <typename T, typename Iterator, typename Functor>
-inline ThreadEngineStarter<T> startMapped(Iterator begin, Iterator end, Functor functor)
+inline ThreadEngineStarter<T> startMapped(Iterator begin, Iterator end, Functor functor,
+                                          Partitioning partitioning = AdaptivePartitioning)
 {
-    return startThreadEngine(new MappedEachKernel<Iterator, Functor>(begin, end, functor));
+    MappedEachKernel<Iterator, Functor> *kernel = new MappedEachKernel<Iterator, Functor>(begin, end, functor);
+    kernel->partitioning = partitioning;
+    return startThreadEngine(kernel);
 }
 
 /*
@@ -228,13 +244,16 @@ struct SequenceHolder1 : public Base
 
 //! [qtconcurrentmapkernel-3]
 template <typename T, typename Sequence, typename Functor>
-inline ThreadEngineStarter<T> startMapped(const Sequence &sequence, Functor functor)
+inline ThreadEngineStarter<T> startMapped(const Sequence &sequence, Functor functor,
+                                          Partitioning partitioning = AdaptivePartitioning)
 {
     typedef SequenceHolder1<Sequence,
                             MappedEachKernel<typename Sequence::const_iterator , Functor>, Functor>
                             SequenceHolderType;
 
-    return startThreadEngine(new SequenceHolderType(sequence, functor));
+    SequenceHolderType *kernel = new SequenceHolderType(sequence, functor);
+    kernel->partitioning = partitioning;
+    return startThreadEngine(kernel);
 }
 
 //! [qtconcurrentmapkernel-4]
@@ -114,7 +114,7 @@ public:
         }
 #endif
 
-        this->reportResult(result);
+        this->reportAndMoveResult(std::move(result));
         this->reportFinished();
     }
     T result;
@@ -191,6 +191,17 @@ public:
         if (futureInterface)
             futureInterfaceTyped()->reportResults(_result, index, count);
     }
+
+    T *reserveContiguousResults(int count)
+    {
+        return futureInterface ? futureInterfaceTyped()->reserveContiguousResults(count) : nullptr;
+    }
+
+    void reportContiguousResults(int index, int count)
+    {
+        if (futureInterface)
+            futureInterfaceTyped()->reportContiguousResults(index, count);
+    }
 };
 
 // The ThreadEngineStarter class ecapsulates the return type
@@ -72,3 +72,15 @@ i.toBack();
 while (i.hasPrevious())
     qDebug() << i.previous();
 //! [2]
+
+
+//! [3]
+QFuture<QImage> image = QtConcurrent::run(loadImage, fileName);
+QFuture<QImage> thumbnail = image
+        .then([](QImage image) { return image.scaled(64, 64); })
+        .then(label, [label](QImage thumbnail) {
+            label->setPixmap(QPixmap::fromImage(thumbnail));
+            return thumbnail;
+        })
+        .onFailed([](const QException &) { return QImage(); });
+//! [3]
@@ -1291,7 +1291,9 @@ public:
         DirectConnection,
         QueuedConnection,
         BlockingQueuedConnection,
-        UniqueConnection =  0x80
+        UniqueConnection =  0x80,
+        BatchedConnection = 0x100,
+        ConflatedConnection = 0x200
     };
 
     enum ShortcutContext {
@@ -168,8 +168,7 @@ ParsedSettingsMap QConfFile::mergedKeyMap() const
 
     for (i = removedKeys.begin(); i != removedKeys.end(); ++i)
         result.remove(i.key());
-    for (i = addedKeys.begin(); i != addedKeys.end(); ++i)
-        result.insert(i.key(), i.value());
+    result.insert(addedKeys);
     return result;
 }
 
@@ -1729,6 +1728,10 @@ bool QConfFileSettingsPrivate::readIniSection(const QSettingsKey &section, const
     int lineLen;
     int position = section.originalKeyPosition();
 
+    // collect the section's keys and merge them into the map in one go
+    QVector<QSettingsKey> keys;
+    QVector<QVariant> values;
+
     while (readIniLine(data, dataPos, lineStart, lineLen, equalsPos)) {
         char ch = data.at(lineStart);
         Q_ASSERT(ch != '[');
@@ -1763,13 +1766,14 @@ bool QConfFileSettingsPrivate::readIniSection(const QSettingsKey &section, const
             QSettingsKey by passing Qt::CaseSensitive when the
             key is already in lowercase.
         */
-        settingsMap->insert(QSettingsKey(key, keyIsLowercase ? Qt::CaseSensitive
-                                                             : IniCaseSensitivity,
-                                         position),
-                            variant);
+        keys.append(QSettingsKey(key, keyIsLowercase ? Qt::CaseSensitive
+                                                     : IniCaseSensitivity,
+                                 position));
+        values.append(variant);
         ++position;
     }
 
+    settingsMap->insert(ParsedSettingsMap(keys, values));
     return ok;
 }
 
@@ -629,10 +629,17 @@ bool QConfFileSettingsPrivate::readPlistFile(const QByteArray &data, ParsedSetti
     QVarLengthArray<CFPropertyListRef> values(size);
     CFDictionaryGetKeysAndValues(cfdict, keys.data(), values.data());
 
+    // the dictionary is unordered, so build the map in one go
+    QVector<QSettingsKey> mapKeys;
+    QVector<QVariant> mapValues;
+    mapKeys.reserve(size);
+    mapValues.reserve(size);
     for (int i = 0; i < size; ++i) {
         QString key = qtKey(static_cast<CFStringRef>(keys[i]));
-        map->insert(QSettingsKey(key, Qt::CaseSensitive), qtValue(values[i]));
+        mapKeys.append(QSettingsKey(key, Qt::CaseSensitive));
+        mapValues.append(qtValue(values[i]));
     }
+    map->insert(ParsedSettingsMap(mapKeys, mapValues));
     return true;
 }
 
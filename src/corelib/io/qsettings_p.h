@@ -60,6 +60,7 @@
 #ifndef QT_NO_QOBJECT
 #include "private/qobject_p.h"
 #endif
+#include "private/qflatmap_p.h"
 #include "private/qscopedpointer_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -81,6 +82,7 @@ static const Qt::CaseSensitivity IniCaseSensitivity = Qt::CaseSensitive;
 class QSettingsKey : public QString
 {
 public:
+    inline QSettingsKey() {}
     inline QSettingsKey(const QString &key, Qt::CaseSensitivity cs, int /* position */ = -1)
         : QString(key) { Q_ASSERT(cs == Qt::CaseSensitive); Q_UNUSED(cs); }
 
@@ -93,6 +95,7 @@ static const Qt::CaseSensitivity IniCaseSensitivity = Qt::CaseInsensitive;
 class QSettingsKey : public QString
 {
 public:
+    inline QSettingsKey() : theOriginalKeyPosition(-1) {}
     inline QSettingsKey(const QString &key, Qt::CaseSensitivity cs, int position = -1)
          : QString(key), theOriginalKey(key), theOriginalKeyPosition(position)
     {
@@ -111,8 +114,9 @@ private:
 
 Q_DECLARE_TYPEINFO(QSettingsKey, Q_MOVABLE_TYPE);
 
-typedef QMap<QSettingsKey, QByteArray> UnparsedSettingsMap;
-typedef QMap<QSettingsKey, QVariant> ParsedSettingsMap;
+// settings are read far more often than written, so keep them sorted in flat arrays
+typedef QFlatMap<QSettingsKey, QByteArray> UnparsedSettingsMap;
+typedef QFlatMap<QSettingsKey, QVariant> ParsedSettingsMap;
 
 class QSettingsGroup
 {
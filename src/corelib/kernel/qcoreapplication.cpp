@@ -371,7 +371,10 @@ bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
-    return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
+    return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset
+            + currentThreadData->postEventList.lockFreeEventCount()
+            + currentThreadData->postEventList.deferredDeletes.count()
+            - currentThreadData->postEventList.deferredDeletes.pendingMarkers();
 }
 
 QAbstractEventDispatcher *QCoreApplicationPrivate::eventDispatcher = 0;
@@ -519,15 +522,17 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         QMutexLocker locker(&threadData->postEventList.mutex);
+        threadData->postEventList.takeLockFreeEvents();
         for (int i = 0; i < threadData->postEventList.size(); ++i) {
             const QPostEvent &pe = threadData->postEventList.at(i);
             if (pe.event) {
-                --pe.receiver->d_func()->postedEvents;
+                pe.receiver->d_func()->postedEventCount.deref();
                 pe.event->posted = false;
                 delete pe.event;
             }
         }
         threadData->postEventList.clear();
+        threadData->postEventList.deferredDeletes.clear();
         threadData->postEventList.recursion = 0;
         threadData->quitNow = false;
         threadData_clean = true;
@@ -1454,6 +1459,37 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // compressEvent() is only called when the receiver has events posted
+    // already, so only events for other receivers can skip the mutex; any
+    // other event may be compressed with those, by any reimplementation
+    if (QPostEventList::canAddEventLockFree(event, priority)
+            && !receiver->d_func()->postedEventCount.load()) {
+        // Fast path: queue the event without taking the mutex. Announcing
+        // ourselves in lockFreePosters before checking the thread data lets
+        // moveToThread() wait for us and carry the event along with the
+        // receiver.
+        QPostEventList &list = data->postEventList;
+        list.lockFreePosters.ref();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (data == *pdata) {
+            event->posted = true;
+            receiver->d_func()->postedEventCount.ref();
+            const bool pushed = list.addEventLockFree(receiver, event);
+            list.lockFreePosters.deref();
+            if (pushed) {
+                QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+                if (dispatcher)
+                    dispatcher->wakeUp();
+                return;
+            }
+            // the queue is full, fall back to the locked path
+            event->posted = false;
+            receiver->d_func()->postedEventCount.deref();
+        } else {
+            list.lockFreePosters.deref();
+        }
+    }
+
     // lock the post event mutex
     data->postEventList.mutex.lock();
 
@@ -1473,12 +1509,22 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QMutexUnlocker locker(&data->postEventList.mutex);
 
+    // keep the events queued without the mutex ahead of this one
+    data->postEventList.takeLockFreeEvents();
+
     // if this is one of the compressible events, do compression
-    if (receiver->d_func()->postedEvents
+    if (receiver->d_func()->postedEventCount.load()
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
         return;
     }
 
+    if (event->type() == QEvent::DeferredDelete
+        && receiver->d_func()->deferredDeleteIndex >= 0) {
+        // already waiting in the deferred deletion list
+        delete event;
+        return;
+    }
+
     if (event->type() == QEvent::DeferredDelete)
         receiver->d_ptr->deleteLaterCalled = true;
 
@@ -1501,7 +1547,18 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         int scopeLevel = data->scopeLevel;
         if (scopeLevel == 0 && loopLevel != 0)
             scopeLevel = 1;
-        static_cast<QDeferredDeleteEvent *>(event)->level = loopLevel + scopeLevel;
+
+        // instead of queueing one event per object, remember the object and
+        // the level; sendPostedEvents() deletes them at the marker
+        data->postEventList.addDeferredDelete(receiver, loopLevel + scopeLevel);
+        data->canWait = false;
+        locker.unlock();
+        delete event;
+
+        QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+        if (dispatcher)
+            dispatcher->wakeUp();
+        return;
     }
 
     // delete the event on exceptions to protect against memory leaks till the event is
@@ -1510,7 +1567,7 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     data->postEventList.addEvent(QPostEvent(receiver, event, priority));
     eventDeleter.take();
     event->posted = true;
-    ++receiver->d_func()->postedEvents;
+    receiver->d_func()->postedEventCount.ref();
     data->canWait = false;
     locker.unlock();
 
@@ -1531,7 +1588,7 @@ bool QCoreApplication::compressEvent(QEvent *event, QObject *receiver, QPostEven
     Q_ASSERT(postedEvents);
 
     // compress posted timers to this object.
-    if (event->type() == QEvent::Timer && receiver->d_func()->postedEvents > 0) {
+    if (event->type() == QEvent::Timer && receiver->d_func()->postedEventCount.load() > 0) {
         int timerId = ((QTimerEvent *) event)->timerId();
         for (int i=0; i<postedEvents->size(); ++i) {
             const QPostEvent &e = postedEvents->at(i);
@@ -1556,7 +1613,7 @@ bool QCoreApplication::compressEvent(QEvent *event, QObject *receiver, QPostEven
         return false;
     }
 
-    if (event->type() == QEvent::Quit && receiver->d_func()->postedEvents > 0) {
+    if (event->type() == QEvent::Quit && receiver->d_func()->postedEventCount.load() > 0) {
         for (int i = 0; i < postedEvents->size(); ++i) {
             const QPostEvent &cur = postedEvents->at(i);
             if (cur.receiver != receiver
@@ -1615,13 +1672,17 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.takeLockFreeEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
     // events, canWait will be set to false.
-    data->canWait = (data->postEventList.size() == 0);
+    QDeferredDeleteList &deferredDeletes = data->postEventList.deferredDeletes;
+    data->canWait = (data->postEventList.size() == 0 && deferredDeletes.isEmpty());
 
-    if (data->postEventList.size() == 0 || (receiver && !receiver->d_func()->postedEvents)) {
+    if (data->canWait
+        || (receiver && !receiver->d_func()->postedEventCount.load()
+            && receiver->d_func()->deferredDeleteIndex < 0)) {
         --data->postEventList.recursion;
         return;
     }
@@ -1668,6 +1729,56 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     };
     CleanUp cleanup(receiver, event_type, data);
 
+    // sending the posted events might delete the receiver
+    const int receiverDeferredDeleteIndex = receiver ? receiver->d_func()->deferredDeleteIndex : -1;
+
+    // don't delete objects whose deleteLater() is called during this pass
+    const uint lastMarker = deferredDeletes.lastPostedMarker();
+    // the markers this pass went past, if it does not deliver them
+    uint markersSeen = 0;
+
+    struct MutexUnlocker
+    {
+        QMutexLocker &m;
+        MutexUnlocker(QMutexLocker &m) : m(m) { m.unlock(); }
+        ~MutexUnlocker() { m.relock(); }
+    };
+
+    // Deletes the objects of the entries from j up to end that belong to a
+    // marker up to \a marker. Returns false if the loop level did not allow
+    // deleting some of them yet; their entries are kept.
+    const auto sendDeferredDeletes = [&](int j, int end, uint marker) {
+        bool sentAll = true;
+        for (; j < end && j < deferredDeletes.size(); ++j) {
+            const QDeferredDeleteList::Entry &entry = deferredDeletes.at(j);
+            if (entry.marker > marker)
+                break;
+            if (!entry.object)
+                continue;
+
+            // the same rules as for DeferredDelete events, see below
+            const int eventLevel = entry.level;
+            const int loopLevel = data->loopLevel + data->scopeLevel;
+            const bool allowDeferredDelete =
+                (eventLevel > loopLevel
+                 || (!eventLevel && loopLevel > 0)
+                 || (event_type == QEvent::DeferredDelete
+                     && eventLevel == loopLevel));
+            if (!allowDeferredDelete) {
+                sentAll = false;
+                continue;
+            }
+
+            QObject *r = deferredDeletes.take(j);
+            MutexUnlocker unlocker(locker);
+
+            QDeferredDeleteEvent e;
+            e.level = eventLevel;
+            QCoreApplication::sendEvent(r, &e);
+        }
+        return sentAll;
+    };
+
     while (i < data->postEventList.size()) {
         // avoid live-lock
         if (i >= data->postEventList.insertionOffset)
@@ -1676,6 +1787,26 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         const QPostEvent &pe = data->postEventList.at(i);
         ++i;
 
+        if (QPostEventList::isDeferredDeleteMarker(pe)) {
+            // the deleteLater() calls made up to here; markers are always
+            // delivered in order, so that the receiver-only passes know
+            // which one they are at without consuming it
+            if (!event_type && !receiver) {
+                if (!sendDeferredDeletes(deferredDeletes.first(), INT_MAX, deferredDeletes.deliverMarker())) {
+                    // re-post the marker, so that the pending ones aren't lost
+                    data->postEventList.addDeferredDeleteMarker();
+                }
+            } else {
+                ++markersSeen;
+                if (!event_type && receiverDeferredDeleteIndex >= 0) {
+                    sendDeferredDeletes(receiverDeferredDeleteIndex, receiverDeferredDeleteIndex + 1,
+                                        deferredDeletes.lastDeliveredMarker() + markersSeen);
+                }
+                data->canWait = false;
+            }
+            continue;
+        }
+
         if (!pe.event)
             continue;
         if ((receiver && receiver != pe.receiver) || (event_type && event_type != pe.event->type())) {
@@ -1723,19 +1854,13 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         QEvent *e = pe.event;
         QObject * r = pe.receiver;
 
-        --r->d_func()->postedEvents;
-        Q_ASSERT(r->d_func()->postedEvents >= 0);
+        r->d_func()->postedEventCount.deref();
+        Q_ASSERT(r->d_func()->postedEventCount.load() >= 0);
 
         // next, update the data structure so that we're ready
         // for the next event.
         const_cast<QPostEvent &>(pe).event = 0;
 
-        struct MutexUnlocker
-        {
-            QMutexLocker &m;
-            MutexUnlocker(QMutexLocker &m) : m(m) { m.unlock(); }
-            ~MutexUnlocker() { m.relock(); }
-        };
         MutexUnlocker unlocker(locker);
 
         QScopedPointer<QEvent> event_deleter(e); // will delete the event (with the mutex unlocked)
@@ -1748,6 +1873,19 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         // function depends on.
     }
 
+    // a pass for DeferredDelete events only delivers no other events the
+    // deletions could be ordered against, and doesn't wait for the markers;
+    // the entries taken are nulled out, so that recursive calls skip them,
+    // and only dropped by the outermost call
+    if (event_type == QEvent::DeferredDelete && !deferredDeletes.isEmpty()) {
+        if (!receiver)
+            sendDeferredDeletes(deferredDeletes.first(), INT_MAX, lastMarker);
+        else if (receiverDeferredDeleteIndex >= 0)
+            sendDeferredDeletes(receiverDeferredDeleteIndex, receiverDeferredDeleteIndex + 1, lastMarker);
+    }
+    if (data->postEventList.recursion == 1 && deferredDeletes.count() != deferredDeletes.size())
+        deferredDeletes.squeeze();
+
     cleanup.exceptionCaught = false;
 }
 
@@ -1775,12 +1913,25 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     QThreadData *data = receiver ? receiver->d_func()->threadData : QThreadData::current();
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.takeLockFreeEvents();
+
+    if (eventType == 0 || eventType == QEvent::DeferredDelete) {
+        QDeferredDeleteList &deferredDeletes = data->postEventList.deferredDeletes;
+        if (receiver) {
+            deferredDeletes.remove(receiver);
+        } else {
+            for (int i = 0; i < deferredDeletes.size(); ++i)
+                deferredDeletes.take(i);
+            if (!data->postEventList.recursion)
+                deferredDeletes.squeeze();
+        }
+    }
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
     // and when we get here, we may not have any more posted events
     // for this object.
-    if (receiver && !receiver->d_func()->postedEvents)
+    if (receiver && !receiver->d_func()->postedEventCount.load())
         return;
 
     //we will collect all the posted events for the QObject
@@ -1794,7 +1945,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 
         if ((!receiver || pe.receiver == receiver)
             && (pe.event && (eventType == 0 || pe.event->type() == eventType))) {
-            --pe.receiver->d_func()->postedEvents;
+            pe.receiver->d_func()->postedEventCount.deref();
             pe.event->posted = false;
             events.append(pe.event);
             const_cast<QPostEvent &>(pe).event = 0;
@@ -1807,7 +1958,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 
 #ifdef QT_DEBUG
     if (receiver && eventType == 0) {
-        Q_ASSERT(!receiver->d_func()->postedEvents);
+        Q_ASSERT(!receiver->d_func()->postedEventCount.load());
     }
 #endif
 
@@ -1840,6 +1991,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.takeLockFreeEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -1858,7 +2010,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
                      pe.receiver->metaObject()->className(),
                      pe.receiver->objectName().toLocal8Bit().data());
 #endif
-            --pe.receiver->d_func()->postedEvents;
+            pe.receiver->d_func()->postedEventCount.deref();
             pe.event->posted = false;
             delete pe.event;
             const_cast<QPostEvent &>(pe).event = 0;
@@ -1042,7 +1042,7 @@ void QCoreApplicationPrivate::removePostedTimerEvent(QObject *object, int timerI
                 && pe.event
                 && (pe.event->type() == QEvent::Timer || pe.event->type() == QEvent::ZeroTimerEvent)
                 && static_cast<QTimerEvent *>(pe.event)->timerId() == timerId) {
-            --pe.receiver->d_func()->postedEvents;
+            pe.receiver->d_func()->postedEventCount.deref();
             pe.event->posted = false;
             delete pe.event;
             const_cast<QPostEvent &>(pe).event = 0;
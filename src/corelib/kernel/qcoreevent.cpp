@@ -39,10 +39,12 @@
 ****************************************************************************/
 
 #include "qcoreevent.h"
+#include "qcoreevent_p.h"
 #include "qcoreapplication.h"
 #include "qcoreapplication_p.h"
 
 #include "qbasicatomic.h"
+#include "private/qfreelist_p.h"
 
 #include <limits>
 
@@ -657,6 +659,109 @@ QDeferredDeleteEvent::~QDeferredDeleteEvent()
     \sa QObject::deleteLater()
 */
 
+/*
+    QEventPool keeps the memory of pooled events in a lock-free QFreeList,
+    which fits events being allocated in one thread and deleted in another.
+    Each slot starts with a header that stores the slot's id, so that
+    deallocate() can find it again; memory that did not come from the pool
+    has an id of -1 in the same header.
+*/
+namespace {
+union QEventPoolHeader
+{
+    int id;
+    // keep the event behind the header suitably aligned
+    double alignDouble;
+    qint64 alignInteger;
+    void *alignPointer;
+};
+
+struct QEventPoolSlot
+{
+    QEventPoolHeader header;
+    char event[QEventPool::MaxEventSize];
+};
+
+struct QEventPoolConstants : QFreeListDefaultConstants
+{
+    enum {
+        BlockCount = 4,
+        Capacity = 0x40 + 0x100 + 0x400 + 0x1000
+    };
+    static const int Sizes[BlockCount];
+};
+
+const int QEventPoolConstants::Sizes[QEventPoolConstants::BlockCount] = {
+    0x40,
+    0x100,
+    0x400,
+    0x1000
+};
+
+typedef QFreeList<QEventPoolSlot, QEventPoolConstants> QEventFreeList;
+}
+
+Q_GLOBAL_STATIC(QEventFreeList, eventFreeList)
+// number of slots in use; QFreeList must never be asked for more than its capacity
+static QBasicAtomicInt eventPoolSlotsInUse = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+/*!
+    \internal
+
+    Returns memory for an event of \a size bytes, from the pool if the event
+    is small enough and the pool is not exhausted.
+*/
+void *QEventPool::allocate(std::size_t size)
+{
+    if (size <= std::size_t(MaxEventSize)) {
+        if (eventPoolSlotsInUse.fetchAndAddRelaxed(1) < QEventPoolConstants::Capacity) {
+            if (QEventFreeList *list = eventFreeList()) {
+                const int id = list->next();
+                QEventPoolSlot &slot = (*list)[id];
+                slot.header.id = id;
+                return slot.event;
+            }
+        }
+        eventPoolSlotsInUse.fetchAndAddRelaxed(-1);
+    }
+
+    QEventPoolHeader *header = static_cast<QEventPoolHeader *>(::operator new(sizeof(QEventPoolHeader) + size));
+    header->id = -1;
+    return header + 1;
+}
+
+/*!
+    \internal
+
+    Returns the memory at \a ptr, obtained from allocate(), to the pool.
+*/
+void QEventPool::deallocate(void *ptr) Q_DECL_NOTHROW
+{
+    if (!ptr)
+        return;
+
+    QEventPoolHeader *header = static_cast<QEventPoolHeader *>(ptr) - 1;
+    if (header->id < 0) {
+        ::operator delete(header);
+        return;
+    }
+
+    // during global destruction the slots are gone with the list
+    if (QEventFreeList *list = eventFreeList())
+        list->release(header->id);
+    eventPoolSlotsInUse.fetchAndAddRelaxed(-1);
+}
+
+/*!
+    \internal
+
+    Returns the number of pool slots currently holding an event.
+*/
+int QEventPool::allocatedCount() Q_DECL_NOTHROW
+{
+    return eventPoolSlotsInUse.load();
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qcoreevent.cpp"
@@ -380,6 +380,7 @@ public:
 private:
     int level;
     friend class QCoreApplication;
+    friend class QCoreApplicationPrivate;
 };
 
 QT_END_NAMESPACE
@@ -59,6 +59,11 @@
 #  include <sys/eventfd.h>
 #endif
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#  include <sys/timerfd.h>
+#endif
+
 // VxWorks doesn't correctly set the _POSIX_... options
 #if defined(Q_OS_VXWORKS)
 #  if defined(_POSIX_MONOTONIC_CLOCK) && (_POSIX_MONOTONIC_CLOCK <= 0)
@@ -223,15 +228,29 @@ int QThreadPipe::check(const pollfd &pfd)
 }
 
 QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
+#if QT_CONFIG(epoll)
+    : epollFd(-1), timerFd(-1)
+#endif
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Can not continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    timerFdDeadline.tv_sec = 0;
+    timerFdDeadline.tv_nsec = 0;
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0 && !initEpoll())
+        qWarning("QEventDispatcherUNIXPrivate: epoll is unavailable, falling back to poll");
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
-    // cleanup timers
-    qDeleteAll(timerList);
+#if QT_CONFIG(epoll)
+    if (timerFd != -1)
+        qt_safe_close(timerFd);
+    if (epollFd != -1)
+        qt_safe_close(epollFd);
+#endif
 }
 
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
@@ -255,38 +274,43 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
         if (pfd.fd < 0 || pfd.revents == 0)
             continue;
 
-        auto it = socketNotifiers.find(pfd.fd);
-        Q_ASSERT(it != socketNotifiers.end());
-
-        const QSocketNotifierSetUNIX &sn_set = it.value();
-
-        static const struct {
-            QSocketNotifier::Type type;
-            short flags;
-        } notifiers[] = {
-            { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
-            { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
-            { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
-        };
+        auto it = socketNotifiers.constFind(pfd.fd);
+        Q_ASSERT(it != socketNotifiers.cend());
 
-        for (const auto &n : notifiers) {
-            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+        markPendingSocketNotifiers(pfd.fd, it.value(), pfd.revents);
+    }
 
-            if (!notifier)
-                continue;
+    pollfds.clear();
+}
 
-            if (pfd.revents & POLLNVAL) {
-                qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
-                         it.key(), socketType(n.type));
-                notifier->setEnabled(false);
-            }
+// sn_set is taken by value: disabling a notifier may erase it from socketNotifiers
+void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers(int fd, QSocketNotifierSetUNIX sn_set,
+                                                             short revents)
+{
+    static const struct {
+        QSocketNotifier::Type type;
+        short flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
+        { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
+        { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
+    };
+
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
+
+        if (!notifier)
+            continue;
 
-            if (pfd.revents & n.flags)
-                setSocketNotifierPending(notifier);
+        if (revents & POLLNVAL) {
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     fd, socketType(n.type));
+            notifier->setEnabled(false);
         }
-    }
 
-    pollfds.clear();
+        if (revents & n.flags)
+            setSocketNotifierPending(notifier);
+    }
 }
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
@@ -308,6 +332,162 @@ int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
     return n_activated;
 }
 
+#if QT_CONFIG(epoll)
+// epoll reports the same bits as poll for the events we use
+Q_STATIC_ASSERT(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT && EPOLLPRI == POLLPRI);
+Q_STATIC_ASSERT(EPOLLERR == POLLERR && EPOLLHUP == POLLHUP);
+
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1)
+        return false;
+
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    bool ok = timerFd != -1;
+
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    if (ok) {
+        ev.data.fd = threadPipe.fds[0];
+        ok = epoll_ctl(epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == 0;
+    }
+    if (ok) {
+        ev.data.fd = timerFd;
+        ok = epoll_ctl(epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == 0;
+    }
+
+    if (!ok) {
+        if (timerFd != -1)
+            qt_safe_close(timerFd);
+        qt_safe_close(epollFd);
+        timerFd = -1;
+        epollFd = -1;
+    }
+    return ok;
+}
+
+/*
+    Updates the epoll interest list after the notifier set of \a fd changed.
+    \a op is the epoll_ctl() operation the caller expects to be correct; a
+    descriptor that was closed and reused behind our back is handled by
+    switching between EPOLL_CTL_ADD and EPOLL_CTL_MOD.
+*/
+void QEventDispatcherUNIXPrivate::updateEpollInterest(int op, int fd, short events)
+{
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.fd = fd;
+
+    if (op == EPOLL_CTL_DEL) {
+        // fails harmlessly if fd was already closed
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev);
+        unpollableFds.remove(fd);
+        return;
+    }
+
+    int ret = epoll_ctl(epollFd, op, fd, &ev);
+    if (ret == -1 && op == EPOLL_CTL_ADD && errno == EEXIST)
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    else if (ret == -1 && op == EPOLL_CTL_MOD && errno == ENOENT)
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+
+    if (ret == 0) {
+        if (!unpollableFds.isEmpty())
+            unpollableFds.remove(fd);
+        return;
+    }
+
+    switch (errno) {
+    case EPERM:
+        // regular files and directories, which poll() reports as always ready
+        unpollableFds.insert(fd, POLLIN | POLLOUT);
+        break;
+    case EBADF:
+        unpollableFds.insert(fd, POLLNVAL);
+        break;
+    default:
+        perror("QEventDispatcherUNIXPrivate: epoll_ctl");
+        break;
+    }
+}
+
+/*
+    Waits for the thread pipe, the socket notifiers and the timers, and marks
+    the socket notifiers that are ready as pending. \a tm is the time until
+    the next timer expires, or null to wait without a timeout; the deadline is
+    handed to timerFd, so it is kept at nanosecond precision instead of being
+    rounded to the millisecond timeout of epoll_wait().
+*/
+int QEventDispatcherUNIXPrivate::epollWait(const timespec *tm)
+{
+    int timeout = -1;
+    if (!unpollableFds.isEmpty() || (tm && tm->tv_sec == 0 && tm->tv_nsec == 0)) {
+        timeout = 0;
+    } else if (tm) {
+        // timerWait() has just updated timerList.currentTime
+        const timespec deadline = timerList.currentTime + *tm;
+        const timespec oneMillisecond = { 0, 1000 * 1000 };
+        const bool armed = timerFdDeadline.tv_sec != 0 || timerFdDeadline.tv_nsec != 0;
+
+        // timerWait() rounds up to the millisecond, so the deadline of the
+        // same timer moves a little on every iteration; don't rearm for that
+        if (!armed || deadline + oneMillisecond < timerFdDeadline
+                || timerFdDeadline + oneMillisecond < deadline) {
+            itimerspec spec;
+            memset(&spec, 0, sizeof(spec));
+            spec.it_value = *tm;
+            if (timerfd_settime(timerFd, 0, &spec, nullptr) == 0) {
+                timerFdDeadline = deadline;
+            } else {
+                perror("QEventDispatcherUNIXPrivate: timerfd_settime");
+                timeout = int(tm->tv_sec * 1000 + (tm->tv_nsec + 999999) / (1000 * 1000));
+            }
+        }
+    }
+
+    epoll_event events[64];
+    int nfds;
+    EINTR_LOOP(nfds, epoll_wait(epollFd, events, sizeof(events) / sizeof(events[0]), timeout));
+    if (nfds == -1) {
+        perror("epoll_wait");
+        return 0;
+    }
+
+    int nevents = 0;
+    for (int i = 0; i < nfds; ++i) {
+        const int fd = events[i].data.fd;
+        const short revents = short(events[i].events);
+
+        if (fd == threadPipe.fds[0]) {
+            pollfd pfd = threadPipe.prepare();
+            pfd.revents = revents;
+            nevents += threadPipe.check(pfd);
+        } else if (fd == timerFd) {
+            quint64 expirations;
+            if (::read(timerFd, &expirations, sizeof(expirations)) == sizeof(expirations))
+                timerFdDeadline.tv_sec = timerFdDeadline.tv_nsec = 0;
+        } else {
+            auto it = socketNotifiers.constFind(fd);
+            if (it != socketNotifiers.cend())
+                markPendingSocketNotifiers(fd, it.value(), revents);
+        }
+    }
+
+    // iterate over a copy, disabling an invalid notifier modifies unpollableFds
+    const QHash<int, short> unpollable = unpollableFds;
+    for (auto it = unpollable.cbegin(); it != unpollable.cend(); ++it) {
+        auto sn = socketNotifiers.constFind(it.key());
+        if (sn != socketNotifiers.cend())
+            markPendingSocketNotifiers(it.key(), sn.value(), it.value());
+    }
+
+    return nevents;
+}
+#endif // QT_CONFIG(epoll)
+
 QEventDispatcherUNIX::QEventDispatcherUNIX(QObject *parent)
     : QAbstractEventDispatcher(*new QEventDispatcherUNIXPrivate, parent)
 { }
@@ -411,7 +591,16 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = notifier;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd != -1 && sn_set.events() != oldEvents)
+        d->updateEpollInterest(oldEvents ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, sockfd, sn_set.events());
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -452,6 +641,11 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
 
     sn_set.notifiers[type] = nullptr;
 
+#if QT_CONFIG(epoll)
+    if (d->epollFd != -1)
+        d->updateEpollInterest(sn_set.isEmpty() ? EPOLL_CTL_DEL : EPOLL_CTL_MOD, sockfd, sn_set.events());
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -485,29 +679,37 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
-    d->pollfds.clear();
-    d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
-
-    if (include_notifiers)
-        for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
-            d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
-
-    // This must be last, as it's popped off the end below
-    d->pollfds.append(d->threadPipe.prepare());
-
     int nevents = 0;
 
-    switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
-    case -1:
-        perror("qt_safe_poll");
-        break;
-    case 0:
-        break;
-    default:
-        nevents += d->threadPipe.check(d->pollfds.takeLast());
+#if QT_CONFIG(epoll)
+    if (d->epollFd != -1 && include_notifiers) {
+        nevents += d->epollWait(tm);
+        nevents += d->activateSocketNotifiers();
+    } else
+#endif
+    {
+        d->pollfds.clear();
+        d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+
         if (include_notifiers)
-            nevents += d->activateSocketNotifiers();
-        break;
+            for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
+                d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+
+        // This must be last, as it's popped off the end below
+        d->pollfds.append(d->threadPipe.prepare());
+
+        switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
+        case -1:
+            perror("qt_safe_poll");
+            break;
+        case 0:
+            break;
+        default:
+            nevents += d->threadPipe.check(d->pollfds.takeLast());
+            if (include_notifiers)
+                nevents += d->activateSocketNotifiers();
+            break;
+        }
     }
 
     if (include_timers)
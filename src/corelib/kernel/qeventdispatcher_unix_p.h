@@ -51,6 +51,7 @@
 // We mean it.
 //
 
+#include <QtCore/private/qglobal_p.h>
 #include "QtCore/qabstracteventdispatcher.h"
 #include "QtCore/qlist.h"
 #include "private/qabstracteventdispatcher_p.h"
@@ -137,9 +138,16 @@ public:
     int activateTimers();
 
     void markPendingSocketNotifiers();
+    void markPendingSocketNotifiers(int fd, QSocketNotifierSetUNIX sn_set, short revents);
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpollInterest(int op, int fd, short events);
+    int epollWait(const timespec *tm);
+#endif
+
     QThreadPipe threadPipe;
     QVector<pollfd> pollfds;
 
@@ -148,6 +156,18 @@ public:
 
     QTimerInfoList timerList;
     QAtomicInt interrupt; // bool
+
+#if QT_CONFIG(epoll)
+    // epoll(7) backend, selected with QT_EVENT_DISPATCHER_EPOLL=1. The socket
+    // notifiers, the thread pipe and timerFd stay registered in epollFd, so
+    // processEvents() does not rebuild the pollfds vector on every iteration.
+    int epollFd;
+    int timerFd;
+    timespec timerFdDeadline; // {0, 0} if timerFd is not armed
+    // fds epoll_ctl() refused, with the poll(2) revents they stand for
+    // (regular files are always ready, bad descriptors are POLLNVAL)
+    QHash<int, short> unpollableFds;
+#endif
 };
 
 inline QSocketNotifierSetUNIX::QSocketNotifierSetUNIX() Q_DECL_NOTHROW
@@ -56,6 +56,7 @@
 #include "QtCore/qhash.h"
 
 #include "qabstracteventdispatcher_p.h"
+#include "qcoreevent_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -150,6 +151,9 @@ public:
     explicit inline QZeroTimerEvent(int timerId)
         : QTimerEvent(timerId)
     { t = QEvent::ZeroTimerEvent; }
+
+    // posted for every activation of a zero timer, so recycle the memory
+    Q_DECLARE_POOLED_EVENT
 };
 
 typedef QList<WinTimerInfo*>  WinTimerVec;      // vector of TimerInfo structs
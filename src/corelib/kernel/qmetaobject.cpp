@@ -598,6 +598,26 @@ static inline int indexOfMethodRelative(const QMetaObject **baseObject,
         const int end = (MethodType == MethodSlot)
                         ? (priv(m->d.data)->signalCount) : 0;
 
+        if (priv(m->d.data)->revision >= 8 && priv(m->d.data)->methodHashData) {
+            const uint *table = m->d.data + priv(m->d.data)->methodHashData;
+            const uint bucket = QMetaObjectPrivate::methodNameHash(name.constData(), name.size(), table[1])
+                    & (table[0] - 1);
+            const uint *offsets = table + 2;
+            const uint *indexes = offsets + table[0] + 1;
+            // the indexes in a bucket are sorted in descending order, like the scan below
+            for (uint k = offsets[bucket]; k < offsets[bucket + 1]; ++k) {
+                const int index = indexes[k];
+                if (index > i || index < end)
+                    continue;
+                int handle = priv(m->d.data)->methodData + 5*index;
+                if (methodMatch(m, handle, name, argc, types)) {
+                    *baseObject = m;
+                    return index;
+                }
+            }
+            continue;
+        }
+
         for (; i >= end; --i) {
             int handle = priv(m->d.data)->methodData + 5*i;
             if (methodMatch(m, handle, name, argc, types)) {
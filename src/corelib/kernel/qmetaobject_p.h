@@ -171,7 +171,8 @@ class QMutex;
 struct QMetaObjectPrivate
 {
     // revision 7 is Qt 5.0 everything lower is not supported
-    enum { OutputRevision = 7 }; // Used by moc, qmetaobjectbuilder and qdbus
+    // revision 8 is Qt 5.12: It adds the method name hash table
+    enum { OutputRevision = 8 }; // Used by moc, qmetaobjectbuilder and qdbus
 
     int revision;
     int className;
@@ -182,10 +183,33 @@ struct QMetaObjectPrivate
     int constructorCount, constructorData;
     int flags;
     int signalCount;
+    int methodHashData; // since revision 8, 0 if there is no table
 
     static inline const QMetaObjectPrivate *get(const QMetaObject *metaobject)
     { return reinterpret_cast<const QMetaObjectPrivate*>(metaobject->d.data); }
 
+    // The method name hash table, at methodHashData, looks like this:
+    //   bucketCount (a power of two)
+    //   seed for methodNameHash()
+    //   bucketCount + 1 offsets into the index list where each bucket starts
+    //   methodCount method indexes, grouped by bucket and in descending
+    //   order inside a bucket
+    // moc picks the seed so that distinct names don't share a bucket if it
+    // can find one.
+    static inline uint methodNameHash(const char *name, int length, uint seed) Q_DECL_NOTHROW
+    {
+        uint hash = 2166136261u ^ seed;
+        for (int i = 0; i < length; ++i)
+            hash = (hash ^ uchar(name[i])) * 16777619u;
+        // the table only uses the low bits, mix the high ones into them
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
     static int originalClone(const QMetaObject *obj, int local_method_index);
 
     static QByteArray decodeMethodSignature(const char *signature,
@@ -231,7 +255,9 @@ struct QMetaObjectPrivate
                            DisconnectType = DisconnectAll);
     static inline bool disconnectHelper(QObjectPrivate::Connection *c,
                                         const QObject *receiver, int method_index, void **slot,
-                                        QMutex *senderMutex, DisconnectType = DisconnectAll);
+                                        QMutex *senderMutex,
+                                        QVector<QObjectPrivate::Connection *> *slotConnections,
+                                        DisconnectType = DisconnectAll);
 #endif
 };
 
@@ -489,20 +489,41 @@ struct DefinedTypesFilter {
     Destructs this object.
 */
 
+/*
+    FNV-1a hash of a normalized type name. It is constexpr so that the hashes
+    of the builtin type names are computed at compile time.
+*/
+static Q_DECL_CONSTEXPR uint qMetaTypeNameHash(const char *name, int length,
+                                              uint hash = 2166136261u) Q_DECL_NOTHROW
+{
+    return length ? qMetaTypeNameHash(name + 1, length - 1, (hash ^ uchar(*name)) * 16777619u)
+                  : hash;
+}
+
+namespace {
+struct QMetaTypeNameEntry
+{
+    const char *typeName;
+    int typeNameLength;
+    int type;
+    uint hash;
+};
+}
+
 #define QT_ADD_STATIC_METATYPE(MetaTypeName, MetaTypeId, RealName) \
-    { #RealName, sizeof(#RealName) - 1, MetaTypeId },
+    { #RealName, sizeof(#RealName) - 1, MetaTypeId, qMetaTypeNameHash(#RealName, sizeof(#RealName) - 1) },
 
 #define QT_ADD_STATIC_METATYPE_ALIASES_ITER(MetaTypeName, MetaTypeId, AliasingName, RealNameStr) \
-    { RealNameStr, sizeof(RealNameStr) - 1, QMetaType::MetaTypeName },
+    { RealNameStr, sizeof(RealNameStr) - 1, QMetaType::MetaTypeName, qMetaTypeNameHash(RealNameStr, sizeof(RealNameStr) - 1) },
 
 #define QT_ADD_STATIC_METATYPE_HACKS_ITER(MetaTypeName, TypeId, Name) \
     QT_ADD_STATIC_METATYPE(MetaTypeName, MetaTypeName, Name)
 
-static const struct { const char * typeName; int typeNameLength; int type; } types[] = {
+static const QMetaTypeNameEntry types[] = {
     QT_FOR_EACH_STATIC_TYPE(QT_ADD_STATIC_METATYPE)
     QT_FOR_EACH_STATIC_ALIAS_TYPE(QT_ADD_STATIC_METATYPE_ALIASES_ITER)
     QT_FOR_EACH_STATIC_HACKS_TYPE(QT_ADD_STATIC_METATYPE_HACKS_ITER)
-    {0, 0, QMetaType::UnknownType}
+    {0, 0, QMetaType::UnknownType, 0}
 };
 
 Q_CORE_EXPORT const QMetaTypeInterface *qMetaTypeGuiHelper = 0;
@@ -581,7 +602,191 @@ union CheckThatItIsPod
 }
 
 Q_DECLARE_TYPEINFO(QCustomTypeInfo, Q_MOVABLE_TYPE);
-Q_GLOBAL_STATIC(QVector<QCustomTypeInfo>, customTypes)
+
+/*
+    The custom types, stored in pages that never move so that a registered
+    type can be looked up by its id without locking customTypesLock(). Only
+    the parts of an entry that can change after registration (the name,
+    which is cleared by QMetaType::unregisterType(), and the stream
+    operators) need the lock for reading.
+*/
+class QCustomTypeInfoList
+{
+public:
+    enum { PageShift = 8, PageSize = 1 << PageShift, MaxPages = 4096 };
+
+    QCustomTypeInfoList() : unregisteredCount(0) {}
+    ~QCustomTypeInfoList()
+    {
+        for (QAtomicPointer<QCustomTypeInfo> &page : pages)
+            delete [] page.load();
+    }
+
+    int count() const { return size.loadAcquire(); }
+
+    // index must be smaller than count()
+    const QCustomTypeInfo &at(int index) const
+    { return pages[index >> PageShift].load()[index & (PageSize - 1)]; }
+    QCustomTypeInfo &operator[](int index)
+    { return pages[index >> PageShift].load()[index & (PageSize - 1)]; }
+
+    // customTypesLock() must be locked for writing
+    int append(const QCustomTypeInfo &info)
+    {
+        const int index = size.load();
+        if (Q_UNLIKELY(index >= MaxPages * PageSize))
+            return -1;
+        QAtomicPointer<QCustomTypeInfo> &page = pages[index >> PageShift];
+        if (!page.load())
+            page.store(new QCustomTypeInfo[PageSize]);
+        (*this)[index] = info;
+        size.storeRelease(index + 1);
+        return index;
+    }
+
+    // returns the index of an entry freed by QMetaType::unregisterType(), or -1
+    int takeUnregisteredIndex()
+    {
+        if (!unregisteredCount)
+            return -1;
+        for (int v = 0; v < count(); ++v) {
+            if (at(v).typeName.isEmpty()) {
+                --unregisteredCount;
+                return v;
+            }
+        }
+        return -1;
+    }
+
+    int unregisteredCount;
+
+private:
+    QAtomicInt size;
+    QAtomicPointer<QCustomTypeInfo> pages[MaxPages];
+};
+
+/*
+    Maps normalized type names to type ids, for both the builtin and the
+    custom types, using open addressing on the names' hashes. Lookups don't
+    lock: an entry never changes once it has been added, and entries that
+    are removed as well as tables that have been outgrown are only deleted
+    with the index. Adding and removing names requires customTypesLock() to
+    be locked for writing.
+*/
+class QMetaTypeNameIndex
+{
+public:
+    QMetaTypeNameIndex()
+        : table(new Table(256))
+    {
+        for (const QMetaTypeNameEntry *e = types; e->typeName; ++e) {
+            // the first of several entries with the same name wins
+            if (find(e->typeName, e->typeNameLength, e->hash) == QMetaType::UnknownType)
+                insert(e);
+        }
+    }
+
+    ~QMetaTypeNameIndex()
+    {
+        delete table.load();
+        qDeleteAll(retiredTables);
+        for (QMetaTypeNameEntry *e : qAsConst(customEntries))
+            ::free(e);
+    }
+
+    int find(const char *typeName, int length, uint hash) const
+    {
+        const Table *t = table.loadAcquire();
+        for (uint i = hash & t->mask; ; i = (i + 1) & t->mask) {
+            const QMetaTypeNameEntry *e = t->entries[i].loadAcquire();
+            if (!e)
+                return QMetaType::UnknownType;
+            if (e->hash == hash && e->typeNameLength == length && e != &removedEntry
+                    && !memcmp(e->typeName, typeName, length)) {
+                return e->type;
+            }
+        }
+    }
+
+    void insert(const QByteArray &typeName, int type, uint hash)
+    {
+        const int length = typeName.size();
+        QMetaTypeNameEntry *e = static_cast<QMetaTypeNameEntry *>(
+                    ::malloc(sizeof(QMetaTypeNameEntry) + length + 1));
+        Q_CHECK_PTR(e);
+        char *name = reinterpret_cast<char *>(e + 1);
+        memcpy(name, typeName.constData(), length + 1);
+        e->typeName = name;
+        e->typeNameLength = length;
+        e->type = type;
+        e->hash = hash;
+        customEntries.append(e);
+        insert(e);
+    }
+
+    // removes all names of the type with the id \a type
+    void remove(int type)
+    {
+        Table *t = table.load();
+        for (uint i = 0; i <= t->mask; ++i) {
+            const QMetaTypeNameEntry *e = t->entries[i].load();
+            if (e && e != &removedEntry && e->type == type)
+                t->entries[i].storeRelease(&removedEntry);
+        }
+    }
+
+private:
+    struct Table
+    {
+        explicit Table(uint capacity)
+            : mask(capacity - 1), used(0), entries(new QAtomicPointer<const QMetaTypeNameEntry>[capacity])
+        {}
+        ~Table() { delete [] entries; }
+
+        uint mask;
+        uint used; // including the removed entries
+        QAtomicPointer<const QMetaTypeNameEntry> *entries;
+    };
+
+    void insert(const QMetaTypeNameEntry *e)
+    {
+        Table *t = table.load();
+        if ((t->used + 1) * 4 > (t->mask + 1) * 3) {
+            // rehash into a new table, so that concurrent lookups in the
+            // old one can continue
+            Table *newTable = new Table((t->mask + 1) * 2);
+            for (uint i = 0; i <= t->mask; ++i) {
+                const QMetaTypeNameEntry *old = t->entries[i].load();
+                if (old && old != &removedEntry)
+                    insertUnique(newTable, old);
+            }
+            table.storeRelease(newTable);
+            retiredTables.append(t);
+            t = newTable;
+        }
+        insertUnique(t, e);
+    }
+
+    static void insertUnique(Table *t, const QMetaTypeNameEntry *e)
+    {
+        uint i = e->hash & t->mask;
+        while (t->entries[i].load())
+            i = (i + 1) & t->mask;
+        t->entries[i].storeRelease(e);
+        ++t->used;
+    }
+
+    static const QMetaTypeNameEntry removedEntry;
+
+    QAtomicPointer<Table> table;
+    QVector<Table *> retiredTables;
+    QVector<QMetaTypeNameEntry *> customEntries;
+};
+
+const QMetaTypeNameEntry QMetaTypeNameIndex::removedEntry = { "", -1, QMetaType::UnknownType, 0 };
+
+Q_GLOBAL_STATIC(QCustomTypeInfoList, customTypes)
+Q_GLOBAL_STATIC(QMetaTypeNameIndex, customTypeNames)
 Q_GLOBAL_STATIC(QReadWriteLock, customTypesLock)
 Q_GLOBAL_STATIC(QMetaTypeConverterRegistry, customTypesConversionRegistry)
 Q_GLOBAL_STATIC(QMetaTypeComparatorRegistry, customTypesComparatorRegistry)
@@ -825,7 +1030,7 @@ void QMetaType::registerStreamOperators(int idx, SaveOperator saveOp,
 {
     if (idx < User)
         return; //builtin types should not be registered;
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeInfoList *ct = customTypes();
     if (!ct)
         return;
     QWriteLocker locker(customTypesLock());
@@ -944,7 +1149,7 @@ const char *QMetaType::typeName(int typeId)
         return nullptr; // It can happen when someone cast int to QVariant::Type, we should not crash...
     }
 
-    const QVector<QCustomTypeInfo> * const ct = customTypes();
+    const QCustomTypeInfoList * const ct = customTypes();
     QReadLocker locker(customTypesLock());
     return ct && uint(ct->count()) > type - QMetaType::User && !ct->at(type - QMetaType::User).typeName.isEmpty()
             ? ct->at(type - QMetaType::User).typeName.constData()
@@ -955,6 +1160,7 @@ const char *QMetaType::typeName(int typeId)
 
 /*
     Similar to QMetaType::type(), but only looks in the static set of types.
+    Used once customTypeNames() has been destroyed.
 */
 static inline int qMetaTypeStaticType(const char *typeName, int length)
 {
@@ -967,31 +1173,15 @@ static inline int qMetaTypeStaticType(const char *typeName, int length)
 }
 
 /*
-    Similar to QMetaType::type(), but only looks in the custom set of
-    types, and doesn't lock the mutex.
-    The extra \a firstInvalidIndex parameter is an easy way to avoid
-    iterating over customTypes() a second time in registerNormalizedType().
+    Looks up the builtin or custom type with the normalized name \a typeName,
+    without locking. For typedefs, the id of the aliased type is returned.
 */
-static int qMetaTypeCustomType_unlocked(const char *typeName, int length, int *firstInvalidIndex = 0)
+static inline int qMetaTypeFindType(const char *typeName, int length)
 {
-    const QVector<QCustomTypeInfo> * const ct = customTypes();
-    if (!ct)
-        return QMetaType::UnknownType;
-
-    if (firstInvalidIndex)
-        *firstInvalidIndex = -1;
-    for (int v = 0; v < ct->count(); ++v) {
-        const QCustomTypeInfo &customInfo = ct->at(v);
-        if ((length == customInfo.typeName.size())
-            && !memcmp(typeName, customInfo.typeName.constData(), length)) {
-            if (customInfo.alias >= 0)
-                return customInfo.alias;
-            return v + QMetaType::User;
-        }
-        if (firstInvalidIndex && (*firstInvalidIndex < 0) && customInfo.typeName.isEmpty())
-            *firstInvalidIndex = v;
-    }
-    return QMetaType::UnknownType;
+    const QMetaTypeNameIndex * const index = customTypeNames();
+    if (Q_UNLIKELY(!index))
+        return qMetaTypeStaticType(typeName, length);
+    return index->find(typeName, length, qMetaTypeNameHash(typeName, length));
 }
 
 /*!
@@ -1022,21 +1212,26 @@ int QMetaType::registerType(const char *typeName, Deleter deleter,
 bool QMetaType::unregisterType(int type)
 {
     QWriteLocker locker(customTypesLock());
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeInfoList *ct = customTypes();
+    QMetaTypeNameIndex *index = customTypeNames();
 
     // check if user type
-    if ((type < User) || ((type - User) >= ct->size()))
+    if (!ct || !index || (type < User) || ((type - User) >= ct->count()))
         return false;
 
     // only types without Q_DECLARE_METATYPE can be unregistered
-    if (ct->data()[type - User].flags & WasDeclaredAsMetaType)
+    if (ct->at(type - User).flags & WasDeclaredAsMetaType)
         return false;
 
     // invalidate type and all its alias entries
     for (int v = 0; v < ct->count(); ++v) {
-        if (((v + User) == type) || (ct->at(v).alias == type))
-            ct->data()[v].typeName.clear();
+        QCustomTypeInfo &inf = (*ct)[v];
+        if (!inf.typeName.isEmpty() && (((v + User) == type) || (inf.alias == type))) {
+            inf.typeName.clear();
+            ++ct->unregisteredCount;
+        }
     }
+    index->remove(type);
     return true;
 }
 
@@ -1102,21 +1297,19 @@ int QMetaType::registerNormalizedType(const NS(QByteArray) &normalizedTypeName,
                             Constructor constructor,
                             int size, TypeFlags flags, const QMetaObject *metaObject)
 {
-    QVector<QCustomTypeInfo> *ct = customTypes();
-    if (!ct || normalizedTypeName.isEmpty() || !destructor || !constructor)
+    QCustomTypeInfoList *ct = customTypes();
+    QMetaTypeNameIndex *index = customTypeNames();
+    if (!ct || !index || normalizedTypeName.isEmpty() || !destructor || !constructor)
         return -1;
 
-    int idx = qMetaTypeStaticType(normalizedTypeName.constData(),
-                                  normalizedTypeName.size());
+    const uint hash = qMetaTypeNameHash(normalizedTypeName.constData(), normalizedTypeName.size());
+    int idx = index->find(normalizedTypeName.constData(), normalizedTypeName.size(), hash);
 
     int previousSize = 0;
     QMetaType::TypeFlags::Int previousFlags = 0;
     if (idx == UnknownType) {
         QWriteLocker locker(customTypesLock());
-        int posInVector = -1;
-        idx = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                           normalizedTypeName.size(),
-                                           &posInVector);
+        idx = index->find(normalizedTypeName.constData(), normalizedTypeName.size(), hash);
         if (idx == UnknownType) {
             QCustomTypeInfo inf;
             inf.typeName = normalizedTypeName;
@@ -1130,29 +1323,33 @@ int QMetaType::registerNormalizedType(const NS(QByteArray) &normalizedTypeName,
             inf.size = size;
             inf.flags = flags;
             inf.metaObject = metaObject;
+            int posInVector = ct->takeUnregisteredIndex();
             if (posInVector == -1) {
-                idx = ct->size() + User;
-                ct->append(inf);
+                posInVector = ct->append(inf);
+                if (Q_UNLIKELY(posInVector == -1))
+                    return -1;
             } else {
-                idx = posInVector + User;
-                ct->data()[posInVector] = inf;
+                (*ct)[posInVector] = inf;
             }
+            idx = posInVector + User;
+            index->insert(normalizedTypeName, idx, hash);
             return idx;
         }
+    }
 
-        if (idx >= User) {
-            previousSize = ct->at(idx - User).size;
-            previousFlags = ct->at(idx - User).flags;
-
-            // Set new/additional flags in case of old library/app.
-            // Ensures that older code works in conjunction with new Qt releases
-            // requiring the new flags.
-            if (flags != previousFlags) {
-                QCustomTypeInfo &inf = ct->data()[idx - User];
-                inf.flags |= flags;
-                if (metaObject)
-                    inf.metaObject = metaObject;
-            }
+    if (idx >= User) {
+        previousSize = ct->at(idx - User).size;
+        previousFlags = ct->at(idx - User).flags;
+
+        // Set new/additional flags in case of old library/app.
+        // Ensures that older code works in conjunction with new Qt releases
+        // requiring the new flags.
+        if (flags != previousFlags) {
+            QWriteLocker locker(customTypesLock());
+            QCustomTypeInfo &inf = (*ct)[idx - User];
+            inf.flags |= flags;
+            if (metaObject)
+                inf.metaObject = metaObject;
         }
     }
 
@@ -1210,28 +1407,30 @@ int QMetaType::registerTypedef(const char* typeName, int aliasId)
 */
 int QMetaType::registerNormalizedTypedef(const NS(QByteArray) &normalizedTypeName, int aliasId)
 {
-    QVector<QCustomTypeInfo> *ct = customTypes();
-    if (!ct || normalizedTypeName.isEmpty())
+    QCustomTypeInfoList *ct = customTypes();
+    QMetaTypeNameIndex *index = customTypeNames();
+    if (!ct || !index || normalizedTypeName.isEmpty())
         return -1;
 
-    int idx = qMetaTypeStaticType(normalizedTypeName.constData(),
-                                  normalizedTypeName.size());
+    const uint hash = qMetaTypeNameHash(normalizedTypeName.constData(), normalizedTypeName.size());
+    int idx = index->find(normalizedTypeName.constData(), normalizedTypeName.size(), hash);
 
     if (idx == UnknownType) {
         QWriteLocker locker(customTypesLock());
-        int posInVector = -1;
-        idx = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                               normalizedTypeName.size(),
-                                               &posInVector);
+        idx = index->find(normalizedTypeName.constData(), normalizedTypeName.size(), hash);
 
         if (idx == UnknownType) {
             QCustomTypeInfo inf;
             inf.typeName = normalizedTypeName;
             inf.alias = aliasId;
-            if (posInVector == -1)
-                ct->append(inf);
-            else
-                ct->data()[posInVector] = inf;
+            const int posInVector = ct->takeUnregisteredIndex();
+            if (posInVector == -1) {
+                if (Q_UNLIKELY(ct->append(inf) == -1))
+                    return -1;
+            } else {
+                (*ct)[posInVector] = inf;
+            }
+            index->insert(normalizedTypeName, aliasId, hash);
             return aliasId;
         }
     }
@@ -1262,7 +1461,7 @@ bool QMetaType::isRegistered(int type)
     }
 
     QReadLocker locker(customTypesLock());
-    const QVector<QCustomTypeInfo> * const ct = customTypes();
+    const QCustomTypeInfoList * const ct = customTypes();
     return ((type >= User) && (ct && ct->count() > type - User) && !ct->at(type - User).typeName.isEmpty());
 }
 
@@ -1271,22 +1470,14 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
 {
     if (!length)
         return QMetaType::UnknownType;
-    int type = qMetaTypeStaticType(typeName, length);
-    if (type == QMetaType::UnknownType) {
-        QReadLocker locker(customTypesLock());
-        type = qMetaTypeCustomType_unlocked(typeName, length);
+    int type = qMetaTypeFindType(typeName, length);
 #ifndef QT_NO_QOBJECT
-        if ((type == QMetaType::UnknownType) && tryNormalizedType) {
-            const NS(QByteArray) normalizedTypeName = QMetaObject::normalizedType(typeName);
-            type = qMetaTypeStaticType(normalizedTypeName.constData(),
-                                       normalizedTypeName.size());
-            if (type == QMetaType::UnknownType) {
-                type = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                                    normalizedTypeName.size());
-            }
-        }
-#endif
+    if ((type == QMetaType::UnknownType) && tryNormalizedType) {
+        const NS(QByteArray) normalizedTypeName = QMetaObject::normalizedType(typeName);
+        type = qMetaTypeFindType(normalizedTypeName.constData(),
+                                 normalizedTypeName.size());
     }
+#endif
     return type;
 }
 
@@ -1535,7 +1726,7 @@ bool QMetaType::save(QDataStream &stream, int type, const void *data)
         stream << *static_cast<const NS(QUuid)*>(data);
         break;
     default: {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
+        const QCustomTypeInfoList * const ct = customTypes();
         if (!ct)
             return false;
 
@@ -1767,7 +1958,7 @@ bool QMetaType::load(QDataStream &stream, int type, void *data)
         stream >> *static_cast< NS(QUuid)*>(data);
         break;
     default: {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
+        const QCustomTypeInfoList * const ct = customTypes();
         if (!ct)
             return false;
 
@@ -1849,13 +2040,11 @@ private:
     static void *customTypeConstructor(const int type, void *where, const void *copy)
     {
         QMetaType::Constructor ctor;
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        {
-            QReadLocker locker(customTypesLock());
-            if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
-                return 0;
-            ctor = ct->at(type - QMetaType::User).constructor;
-        }
+        const QCustomTypeInfoList * const ct = customTypes();
+        // the constructor of a registered type never changes, no need to lock
+        if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
+            return 0;
+        ctor = ct->at(type - QMetaType::User).constructor;
         Q_ASSERT_X(ctor, "void *QMetaType::construct(int type, void *where, const void *copy)", "The type was not properly registered");
         return ctor(where, copy);
     }
@@ -1942,13 +2131,10 @@ private:
     static void customTypeDestructor(const int type, void *where)
     {
         QMetaType::Destructor dtor;
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        {
-            QReadLocker locker(customTypesLock());
-            if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
-                return;
-            dtor = ct->at(type - QMetaType::User).destructor;
-        }
+        const QCustomTypeInfoList * const ct = customTypes();
+        if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
+            return;
+        dtor = ct->at(type - QMetaType::User).destructor;
         Q_ASSERT_X(dtor, "void QMetaType::destruct(int type, void *where)", "The type was not properly registered");
         dtor(where);
     }
@@ -2010,8 +2196,7 @@ public:
 private:
     static int customTypeSizeOf(const int type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        QReadLocker locker(customTypesLock());
+        const QCustomTypeInfoList * const ct = customTypes();
         if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
             return 0;
         return ct->at(type - QMetaType::User).size;
@@ -2078,7 +2263,7 @@ private:
     const int m_type;
     static quint32 customTypeFlags(const int type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
+        const QCustomTypeInfoList * const ct = customTypes();
         if (Q_UNLIKELY(!ct || type < QMetaType::User))
             return 0;
         QReadLocker locker(customTypesLock());
@@ -2138,7 +2323,7 @@ private:
     const int m_type;
     static const QMetaObject *customMetaObject(const int type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
+        const QCustomTypeInfoList * const ct = customTypes();
         if (Q_UNLIKELY(!ct || type < QMetaType::User))
             return 0;
         QReadLocker locker(customTypesLock());
@@ -2342,7 +2527,7 @@ public:
 private:
     void customTypeInfo(const uint type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
+        const QCustomTypeInfoList * const ct = customTypes();
         if (Q_UNLIKELY(!ct))
             return;
         QReadLocker locker(customTypesLock());
@@ -206,7 +206,8 @@ QMetaObject *QObjectData::dynamicMetaObject() const
 }
 
 QObjectPrivate::QObjectPrivate(int version)
-    : threadData(0), connectionLists(0), senders(0), currentSender(0), currentChildBeingDeleted(0)
+    : threadData(0), connectionLists(0), senders(0), currentSender(0), currentChildBeingDeleted(0),
+      metaCallBatch(nullptr), deferredDeleteIndex(-1), childIndex(nullptr), positionInParent(-1)
 {
 #ifdef QT_BUILD_INTERNAL
     // Don't check the version parameter in internal builds.
@@ -251,7 +252,12 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
-    if (postedEvents)
+    if (metaCallBatch)
+        QMetaCallBatch::deref(metaCallBatch);
+
+    delete childIndex;
+
+    if (postedEventCount.load() || deferredDeleteIndex >= 0)
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     threadData->deref();
@@ -291,29 +297,129 @@ static void computeOffsets(const QMetaObject *metaobject, int *signalOffset, int
     QObjectPrivate::signalIndex (not QMetaObject::indexOfSignal).
     Negative index means connections to all signals.
 
-    This vector is protected by the object mutex (signalSlotMutexes())
+    This vector is modified with the object mutex (signalSlotMutexes())
+    locked, but QMetaObject::activate() walks it without locking. The
+    list heads and links are therefore atomic, the signal lists are
+    replaced rather than resized, and neither a Connection nor the
+    replaced lists are deleted while an emission could still reach them:
+    they are kept as orphans until inUse drops to zero. A disconnected
+    Connection keeps its slot object for the same reason if an emission is
+    in progress; it is then destroyed when the Connection is taken off the
+    orphan list. Slot objects are never destroyed with the mutex locked, as
+    destroying a functor can run arbitrary code.
 
     Each Connection is also part of a 'senders' linked list. The mutex
     of the receiver must be locked when touching the pointers of this
     linked list.
 */
-class QObjectConnectionListVector : public QVector<QObjectPrivate::ConnectionList>
+class QObjectConnectionListVector
 {
 public:
-    bool orphaned; //the QObject owner of this vector has been destroyed while the vector was inUse
-    bool dirty; //some Connection have been disconnected (their receiver is 0) but not removed from the list yet
-    int inUse; //number of functions that are currently accessing this object or its connections
+    typedef QVector<QObjectPrivate::ConnectionList> SignalLists;
+
+    QAtomicInt orphaned; //the QObject owner of this vector has been destroyed while the vector was inUse
+    QAtomicInt dirty; //some Connection have been disconnected (their receiver is 0) but not removed from the list yet
+    QAtomicInt inUse; //number of functions that are currently accessing this object or its connections
     QObjectPrivate::ConnectionList allsignals;
+    QAtomicPointer<SignalLists> signalLists;
+
+    // unlinked, but possibly still referenced by an emission in another thread
+    QVector<QObjectPrivate::Connection *> orphanedConnections;
+    QVector<SignalLists *> orphanedSignalLists;
 
     QObjectConnectionListVector()
-        : QVector<QObjectPrivate::ConnectionList>(), orphaned(false), dirty(false), inUse(0)
+        : orphaned(false), dirty(false), inUse(0), signalLists(nullptr)
     { }
 
+    ~QObjectConnectionListVector()
+    {
+        Q_ASSERT(!inUse.load());
+        derefConnections(takeOrphans());
+        delete signalLists.load();
+    }
+
+    int count() const
+    {
+        const SignalLists *lists = signalLists.loadAcquire();
+        return lists ? lists->count() : 0;
+    }
+
+    const QObjectPrivate::ConnectionList &at(int at) const
+    {
+        if (at < 0)
+            return allsignals;
+        return signalLists.loadAcquire()->at(at);
+    }
+
     QObjectPrivate::ConnectionList &operator[](int at)
     {
         if (at < 0)
             return allsignals;
-        return QVector<QObjectPrivate::ConnectionList>::operator[](at);
+        return (*signalLists.loadAcquire())[at];
+    }
+
+    void resize(int size)
+    {
+        SignalLists *oldLists = signalLists.load();
+        SignalLists *lists = new SignalLists(size);
+        if (oldLists) {
+            std::copy(oldLists->cbegin(), oldLists->cend(), lists->begin());
+            orphanedSignalLists.append(oldLists);
+        }
+        signalLists.storeRelease(lists);
+    }
+
+    bool isInUse()
+    {
+        // a full barrier: either an emission that is about to start sees
+        // what was unlinked before this call, or it is counted here
+        return inUse.fetchAndAddOrdered(0) != 0;
+    }
+
+    // Frees the replaced lists and hands the orphaned connections to the
+    // caller, which releases them once it has unlocked the mutex
+    QVector<QObjectPrivate::Connection *> takeOrphans()
+    {
+        QVector<QObjectPrivate::Connection *> connections;
+        connections.swap(orphanedConnections);
+        qDeleteAll(orphanedSignalLists);
+        orphanedSignalLists.clear();
+        return connections;
+    }
+
+    // Takes the slot objects of the disconnected \a connections, unless an
+    // emission might still be calling them; the connections keep them
+    // until they are taken off the orphan list then
+    QVector<QtPrivate::QSlotObjectBase *> takeSlotObjects(const QVector<QObjectPrivate::Connection *> &connections)
+    {
+        QVector<QtPrivate::QSlotObjectBase *> slotObjects;
+        if (connections.isEmpty() || isInUse())
+            return slotObjects;
+        slotObjects.reserve(connections.size());
+        for (QObjectPrivate::Connection *c : connections) {
+            Q_ASSERT(!c->receiver.load() && c->isSlotObject);
+            c->isSlotObject = false;
+            slotObjects.append(c->slotObj);
+        }
+        return slotObjects;
+    }
+
+    static void destroySlotObjects(const QVector<QtPrivate::QSlotObjectBase *> &slotObjects)
+    {
+        for (QtPrivate::QSlotObjectBase *slotObj : slotObjects)
+            slotObj->destroyIfLastRef();
+    }
+
+    static void derefConnections(const QVector<QObjectPrivate::Connection *> &connections)
+    {
+        for (QObjectPrivate::Connection *c : connections) {
+            // a QMetaObject::Connection may keep c alive, but not its functor
+            if (c->isSlotObject) {
+                c->isSlotObject = false;
+                c->slotObj->destroyIfLastRef();
+            }
+            c->deref();
+        }
     }
 };
 
@@ -325,7 +431,7 @@ bool QObjectPrivate::isSender(const QObject *receiver, const char *signal) const
     if (signal_index < 0)
         return false;
     QMutexLocker locker(signalSlotLock(q));
-    if (connectionLists) {
+    if (const QObjectConnectionListVector *connectionLists = this->connectionLists.load()) {
         if (signal_index < connectionLists->count()) {
             const QObjectPrivate::Connection *c =
                 connectionLists->at(signal_index).first;
@@ -349,13 +455,13 @@ QObjectList QObjectPrivate::receiverList(const char *signal) const
     if (signal_index < 0)
         return returnValue;
     QMutexLocker locker(signalSlotLock(q));
-    if (connectionLists) {
+    if (const QObjectConnectionListVector *connectionLists = this->connectionLists.load()) {
         if (signal_index < connectionLists->count()) {
             const QObjectPrivate::Connection *c = connectionLists->at(signal_index).first;
 
             while (c) {
-                if (c->receiver)
-                    returnValue << c->receiver;
+                if (QObject *receiver = c->receiver.load())
+                    returnValue << receiver;
                 c = c->nextConnectionList;
             }
         }
@@ -382,26 +488,35 @@ QObjectList QObjectPrivate::senderList() const
   this function
 
   Will also add the connection in the sender's list of the receiver.
+
+  Returns the disconnected connections that are no longer in use; the
+  caller must release them with QObjectConnectionListVector::derefConnections()
+  once it has unlocked the mutexes.
  */
-void QObjectPrivate::addConnection(int signal, Connection *c)
+QVector<QObjectPrivate::Connection *> QObjectPrivate::addConnection(int signal, Connection *c)
 {
     Q_ASSERT(c->sender == q_ptr);
-    if (!connectionLists)
+    QObjectConnectionListVector *connectionLists = this->connectionLists.load();
+    if (!connectionLists) {
         connectionLists = new QObjectConnectionListVector();
+        this->connectionLists.storeRelease(connectionLists);
+    }
     if (signal >= connectionLists->count())
         connectionLists->resize(signal + 1);
 
+    c->receiverThreadData.store(QObjectPrivate::get(c->receiver.load())->threadData);
+
     ConnectionList &connectionList = (*connectionLists)[signal];
-    if (connectionList.last) {
-        connectionList.last->nextConnectionList = c;
+    if (Connection *last = connectionList.last.load()) {
+        last->nextConnectionList.storeRelease(c);
     } else {
-        connectionList.first = c;
+        connectionList.first.storeRelease(c);
     }
-    connectionList.last = c;
+    connectionList.last.storeRelease(c);
 
-    cleanConnectionLists();
+    const QVector<Connection *> orphans = cleanConnectionLists();
 
-    c->prev = &(QObjectPrivate::get(c->receiver)->senders);
+    c->prev = &(QObjectPrivate::get(c->receiver.load())->senders);
     c->next = *c->prev;
     *c->prev = c;
     if (c->next)
@@ -412,11 +527,13 @@ void QObjectPrivate::addConnection(int signal, Connection *c)
     } else if (signal < (int)sizeof(connectedSignals) * 8) {
         connectedSignals[signal >> 5] |= (1 << (signal & 0x1f));
     }
+    return orphans;
 }
 
-void QObjectPrivate::cleanConnectionLists()
+QVector<QObjectPrivate::Connection *> QObjectPrivate::cleanConnectionLists()
 {
-    if (connectionLists->dirty && !connectionLists->inUse) {
+    QObjectConnectionListVector *connectionLists = this->connectionLists.load();
+    if (connectionLists->dirty.load() && !connectionLists->inUse.load()) {
         // remove broken connections
         for (int signal = -1; signal < connectionLists->count(); ++signal) {
             QObjectPrivate::ConnectionList &connectionList =
@@ -427,29 +544,40 @@ void QObjectPrivate::cleanConnectionLists()
             // at the end of the cleanup.
             QObjectPrivate::Connection *last = 0;
 
-            QObjectPrivate::Connection **prev = &connectionList.first;
-            QObjectPrivate::Connection *c = *prev;
+            QAtomicPointer<QObjectPrivate::Connection> *prev = &connectionList.first;
+            QObjectPrivate::Connection *c = prev->load();
             while (c) {
-                if (c->receiver) {
+                QObjectPrivate::Connection *next = c->nextConnectionList.load();
+                if (c->receiver.load()) {
                     last = c;
                     prev = &c->nextConnectionList;
-                    c = *prev;
                 } else {
-                    QObjectPrivate::Connection *next = c->nextConnectionList;
-                    *prev = next;
-                    c->deref();
-                    c = next;
+                    // keep c->nextConnectionList, a concurrent emission might be on c
+                    prev->storeRelease(next);
+                    connectionLists->orphanedConnections.append(c);
                 }
+                c = next;
             }
 
             // Correct the connection list's last pointer.
             // As conectionList.last could equal last, this could be a noop
-            connectionList.last = last;
+            connectionList.last.storeRelease(last);
         }
-        connectionLists->dirty = false;
+        connectionLists->dirty.store(false);
     }
+
+    if ((!connectionLists->orphanedConnections.isEmpty()
+         || !connectionLists->orphanedSignalLists.isEmpty())
+        && !connectionLists->isInUse()) {
+        return connectionLists->takeOrphans();
+    }
+    return QVector<Connection *>();
 }
 
+Q_STATIC_ASSERT_X(sizeof(QMetaCallEvent) <= QEventPool::MaxEventSize
+                  && sizeof(QMetaCallBatchEvent) <= QEventPool::MaxEventSize,
+                  "Queued calls should be small enough to use the event pool");
+
 /*!
     \internal
  */
@@ -509,6 +637,220 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+/*!
+    \internal
+
+    Adds a call through the connection \a c to the batch, taking over the
+    \a nargs arguments in \a args. For a conflated connection that already
+    has a call in the batch, the arguments of that call are replaced instead,
+    and the old ones are appended to \a replacedArgs for the caller to
+    destroy. Must be called with the batch's mutex locked.
+*/
+void QMetaCallBatch::addCall(QObjectPrivate::Connection *c, const QObject *sender, int signalId,
+                             void **args, int nargs, QVarLengthArray<void *, 16> *replacedArgs)
+{
+    Q_ASSERT(!closed);
+    if (c->isConflated) {
+        for (Call &call : calls) {
+            if (call.connection != c)
+                continue;
+            call.sender = sender;
+            call.signalId = signalId;
+            for (int n = 1; n < nargs; ++n) {
+                replacedArgs->append(arguments[call.argumentOffset + n]);
+                arguments[call.argumentOffset + n] = args[n];
+            }
+            return;
+        }
+    }
+
+    c->ref();
+    QtPrivate::QSlotObjectBase *slotObj = nullptr;
+    if (c->isSlotObject) {
+        slotObj = c->slotObj;
+        slotObj->ref();
+    }
+    const Call call = { c, slotObj, sender, signalId, arguments.size() };
+    calls.append(call);
+    arguments.append(args, nargs);
+}
+
+/*!
+    \internal
+
+    Destroys the arguments of all calls in the batch and drops the references
+    to their connections and slot objects. The batch must be closed, or otherwise unreachable
+    by senders.
+*/
+void QMetaCallBatch::clearCalls()
+{
+    for (const Call &call : qAsConst(calls)) {
+        const int *types = call.connection->argumentTypes.load();
+        for (int n = 1; types[n - 1]; ++n)
+            QMetaType::destroy(types[n - 1], arguments[call.argumentOffset + n]);
+        if (call.slotObj)
+            call.slotObj->destroyIfLastRef();
+        call.connection->deref();
+    }
+    // keep the capacity, for the next time the batch is used
+    calls.clear();
+    arguments.clear();
+}
+
+/*!
+    \internal
+ */
+void QMetaCallBatch::deref(QMetaCallBatch *batch)
+{
+    if (!batch->ref_.deref()) {
+        batch->clearCalls();
+        batch->threadData->metaCallBatchPool.release(batch);
+    }
+}
+
+QMetaCallBatchPool::~QMetaCallBatchPool()
+{
+    qDeleteAll(cached);
+}
+
+/*!
+    \internal
+
+    Returns an empty batch with one reference, taken from the pool of
+    \a threadData, which is the pool owner.
+*/
+QMetaCallBatch *QMetaCallBatchPool::acquire(QThreadData *threadData)
+{
+    QMetaCallBatch *batch = nullptr;
+    {
+        QMutexLocker locker(&mutex);
+        if (!cached.isEmpty()) {
+            batch = cached.last();
+            cached.removeLast();
+        }
+    }
+    if (!batch)
+        batch = new QMetaCallBatch;
+    threadData->ref();
+    batch->threadData = threadData;
+    batch->closed = false;
+    batch->ref_.store(1);
+    return batch;
+}
+
+/*!
+    \internal
+
+    Returns the unreferenced and empty \a batch to the pool.
+*/
+void QMetaCallBatchPool::release(QMetaCallBatch *batch)
+{
+    QThreadData *threadData = batch->threadData;
+    batch->threadData = nullptr;
+    {
+        QMutexLocker locker(&mutex);
+        if (cached.size() < MaxCachedBatches) {
+            cached.append(batch);
+            batch = nullptr;
+        }
+    }
+    delete batch;
+    // may destroy this pool
+    threadData->deref();
+}
+
+/*!
+    \internal
+ */
+QMetaCallBatchEvent::QMetaCallBatchEvent(QMetaCallBatch *batch)
+    : QMetaCallEvent(nullptr, nullptr, -1), batch_(batch)
+{
+    batch_->ref();
+}
+
+/*!
+    \internal
+ */
+QMetaCallBatchEvent::~QMetaCallBatchEvent()
+{
+    {
+        QMutexLocker locker(&batch_->mutex);
+        batch_->closed = true;
+    }
+    // nobody else touches the calls of a closed batch
+    batch_->clearCalls();
+    QMetaCallBatch::deref(batch_);
+}
+
+/*!
+    \internal
+
+    Closes the batch, so that calls emitted from now on go into a new one,
+    and makes the calls in the order they were added.
+*/
+void QMetaCallBatchEvent::placeMetaCall(QObject *object)
+{
+    {
+        QMutexLocker locker(&batch_->mutex);
+        batch_->closed = true;
+    }
+
+    QPointer<QObject> guard(object);
+    QThreadData *threadData = QObjectPrivate::get(object)->threadData;
+    for (int i = 0; i < batch_->calls.size(); ++i) {
+        const QMetaCallBatch::Call &call = batch_->calls.at(i);
+        const QObjectPrivate::Connection *c = call.connection;
+        void **argv = batch_->arguments.data() + call.argumentOffset;
+        {
+            QConnectionSenderSwitcher sw(object, const_cast<QObject *>(call.sender), call.signalId);
+            if (call.slotObj) {
+                call.slotObj->call(object, argv);
+            } else if (c->callFunction && c->method_offset <= object->metaObject()->methodOffset()) {
+                c->callFunction(object, QMetaObject::InvokeMetaMethod, c->method_relative, argv);
+            } else {
+                QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod, c->method(), argv);
+            }
+        }
+        if (!guard) // the remaining calls are dropped with the event
+            break;
+        if (QObjectPrivate::get(object)->threadData != threadData) {
+            // the slot moved the receiver, make the remaining calls in its new thread
+            repostCalls(object, i + 1);
+            break;
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Moves the calls starting at \a from into a new batch, and posts it to
+    \a object.
+*/
+void QMetaCallBatchEvent::repostCalls(QObject *object, int from)
+{
+    if (from >= batch_->calls.size())
+        return;
+    QThreadData *threadData = QObjectPrivate::get(object)->threadData;
+    QMetaCallBatch *rest = threadData->metaCallBatchPool.acquire(threadData);
+    for (int i = from; i < batch_->calls.size(); ++i) {
+        QMetaCallBatch::Call call = batch_->calls.at(i);
+        const int *types = call.connection->argumentTypes.load();
+        int nargs = 1;
+        while (types[nargs - 1])
+            ++nargs;
+        const int argumentOffset = call.argumentOffset;
+        call.argumentOffset = rest->arguments.size();
+        rest->calls.append(call);
+        rest->arguments.append(batch_->arguments.data() + argumentOffset, nargs);
+    }
+    // the calls, their arguments and connection references belong to rest now
+    batch_->calls.resize(from);
+    rest->closed = true; // no pending batch refers to it, nobody adds calls
+    QCoreApplication::postEvent(object, new QMetaCallBatchEvent(rest));
+    QMetaCallBatch::deref(rest);
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals().
@@ -839,7 +1181,10 @@ QObject::QObject(QObjectPrivate &dd, QObject *parent)
             if (d->isWidget) {
                 if (parent) {
                     d->parent = parent;
-                    d->parent->d_func()->children.append(this);
+                    QObjectPrivate *parentD = parent->d_func();
+                    parentD->children.append(this);
+                    if (parentD->childIndex)
+                        parentD->childIndex->childAppended(parentD->children, this);
                 }
                 // no events sent here, this is done at the end of the QWidget constructor
             } else {
@@ -919,37 +1264,35 @@ QObject::~QObject()
         d->currentSender->ref = 0;
     d->currentSender = 0;
 
+    // deleted after unlocking, as its orphaned connections may own functors
+    QObjectConnectionListVector *unusedConnectionLists = nullptr;
     if (d->connectionLists || d->senders) {
         QMutex *signalSlotMutex = signalSlotLock(this);
         QMutexLocker locker(signalSlotMutex);
 
         // disconnect all receivers
-        if (d->connectionLists) {
-            ++d->connectionLists->inUse;
-            int connectionListsCount = d->connectionLists->count();
+        if (QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+            connectionLists->inUse.ref();
+            int connectionListsCount = connectionLists->count();
             for (int signal = -1; signal < connectionListsCount; ++signal) {
                 QObjectPrivate::ConnectionList &connectionList =
-                    (*d->connectionLists)[signal];
-
-                while (QObjectPrivate::Connection *c = connectionList.first) {
-                    if (!c->receiver) {
-                        connectionList.first = c->nextConnectionList;
-                        c->deref();
-                        continue;
-                    }
-
-                    QMutex *m = signalSlotLock(c->receiver);
-                    bool needToUnlock = QOrderedMutexLocker::relock(signalSlotMutex, m);
-
-                    if (c->receiver) {
-                        *c->prev = c->next;
-                        if (c->next) c->next->prev = c->prev;
+                    (*connectionLists)[signal];
+
+                while (QObjectPrivate::Connection *c = connectionList.first.load()) {
+                    if (QObject *receiver = c->receiver.load()) {
+                        QMutex *m = signalSlotLock(receiver);
+                        bool needToUnlock = QOrderedMutexLocker::relock(signalSlotMutex, m);
+
+                        if (c->receiver.load()) {
+                            *c->prev = c->next;
+                            if (c->next) c->next->prev = c->prev;
+                        }
+                        c->receiver.store(nullptr);
+                        if (needToUnlock)
+                            m->unlock();
                     }
-                    c->receiver = 0;
-                    if (needToUnlock)
-                        m->unlock();
 
-                    connectionList.first = c->nextConnectionList;
+                    connectionList.first.store(c->nextConnectionList.load());
 
                     // The destroy operation must happen outside the lock
                     if (c->isSlotObject) {
@@ -962,12 +1305,12 @@ QObject::~QObject()
                 }
             }
 
-            if (!--d->connectionLists->inUse) {
-                delete d->connectionLists;
-            } else {
-                d->connectionLists->orphaned = true;
-            }
-            d->connectionLists = 0;
+            // an emission in another thread deletes the lists if it
+            // finishes last, so they are marked before being released
+            connectionLists->orphaned.storeRelease(true);
+            if (!connectionLists->inUse.deref())
+                unusedConnectionLists = connectionLists;
+            d->connectionLists.store(nullptr);
         }
 
         /* Disconnect all senders:
@@ -996,10 +1339,10 @@ QObject::~QObject()
                 m->unlock();
                 continue;
             }
-            node->receiver = 0;
-            QObjectConnectionListVector *senderLists = sender->d_func()->connectionLists;
+            node->receiver.store(nullptr);
+            QObjectConnectionListVector *senderLists = sender->d_func()->connectionLists.load();
             if (senderLists)
-                senderLists->dirty = true;
+                senderLists->dirty.store(true);
 
             QtPrivate::QSlotObjectBase *slotObj = nullptr;
             if (node->isSlotObject) {
@@ -1020,6 +1363,7 @@ QObject::~QObject()
             }
         }
     }
+    delete unusedConnectionLists;
 
     if (!d->children.isEmpty())
         d->deleteChildren();
@@ -1497,6 +1841,11 @@ void QObject::moveToThread(QThread *targetThread)
     if (!targetData)
         targetData = new QThreadData(0);
 
+    // this takes the signalSlotLock(), which must not be done while the
+    // postEventList mutexes are locked. Once they are unlocked, the target
+    // thread may already have deleted the object, so do it beforehand.
+    d->setConnectionThreadData_helper(targetData);
+
     QOrderedMutexLocker locker(&currentData->postEventList.mutex,
                                &targetData->postEventList.mutex);
 
@@ -1506,6 +1855,25 @@ void QObject::moveToThread(QThread *targetThread)
     // move the object
     d_func()->setThreadData_helper(currentData, targetData);
 
+    // events posted without locking the mutex by threads that did not see
+    // the new thread data yet have to follow the object as well
+    currentData->postEventList.waitForLockFreePosters();
+    const int lockFreeEventsBegin = currentData->postEventList.size();
+    currentData->postEventList.takeLockFreeEvents();
+    int eventsMoved = 0;
+    for (int i = lockFreeEventsBegin; i < currentData->postEventList.size(); ++i) {
+        const QPostEvent &pe = currentData->postEventList.at(i);
+        if (pe.event && pe.receiver->d_func()->threadData == targetData) {
+            targetData->postEventList.addEvent(pe);
+            const_cast<QPostEvent &>(pe).event = 0;
+            ++eventsMoved;
+        }
+    }
+    if (eventsMoved > 0 && targetData->hasEventDispatcher()) {
+        targetData->canWait = false;
+        targetData->eventDispatcher.load()->wakeUp();
+    }
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -1540,6 +1908,14 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
             ++eventsMoved;
         }
     }
+    if (deferredDeleteIndex >= 0) {
+        // keep the level the deleteLater() call was made at, as a moved
+        // DeferredDelete event would
+        const int level = currentData->postEventList.deferredDeletes.at(deferredDeleteIndex).level;
+        currentData->postEventList.deferredDeletes.take(deferredDeleteIndex);
+        targetData->postEventList.addDeferredDelete(q, level);
+        ++eventsMoved;
+    }
     if (eventsMoved > 0 && targetData->hasEventDispatcher()) {
         targetData->canWait = false;
         targetData->eventDispatcher.load()->wakeUp();
@@ -1561,6 +1937,28 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
     }
 }
 
+/*!
+    \internal
+
+    Tells the connections to this object and its children which thread the
+    objects live in now, so that QMetaObject::activate() picks the right
+    connection type.
+*/
+void QObjectPrivate::setConnectionThreadData_helper(QThreadData *targetData)
+{
+    Q_Q(QObject);
+    {
+        QMutexLocker locker(signalSlotLock(q));
+        for (Connection *c = senders; c; c = c->next)
+            c->receiverThreadData.storeRelease(targetData);
+    }
+
+    for (int i = 0; i < children.size(); ++i) {
+        QObject *child = children.at(i);
+        child->d_func()->setConnectionThreadData_helper(targetData);
+    }
+}
+
 void QObjectPrivate::_q_reregisterTimers(void *pointer)
 {
     Q_Q(QObject);
@@ -1997,10 +2395,85 @@ void QObjectPrivate::deleteChildren()
         delete currentChildBeingDeleted;
     }
     children.clear();
+    delete childIndex;
+    childIndex = nullptr;
     currentChildBeingDeleted = 0;
     isDeletingChildren = false;
 }
 
+/*!
+    \internal
+
+    Returns the index of \a child in the children list, or -1.
+*/
+int QObjectPrivate::indexOfChild(const QObject *child)
+{
+    if (!childIndex) {
+        if (children.size() < QObjectChildIndex::MinimumChildren) {
+            // children are often removed in the reverse order they were
+            // added in, so look at the end of the list first
+            return !children.isEmpty() && children.constLast() == child
+                    ? children.size() - 1 : children.indexOf(const_cast<QObject *>(child));
+        }
+        childIndex = new QObjectChildIndex(children);
+    }
+    return childIndex->indexOf(children, child);
+}
+
+void QObjectChildIndex::rebuild(const QObjectList &children)
+{
+    const int capacity = qMax(2 * children.size(), int(MinimumChildren));
+    removed.fill(0, capacity + 1);
+    for (int i = 0; i < children.size(); ++i) {
+        // deleteChildren() leaves null entries behind
+        if (QObject *child = children.at(i))
+            QObjectPrivate::get(child)->positionInParent = i;
+    }
+    nextPosition = children.size();
+}
+
+int QObjectChildIndex::removedBefore(int position) const
+{
+    int count = 0;
+    for (int i = position; i > 0; i -= i & -i)
+        count += removed.at(i);
+    return count;
+}
+
+int QObjectChildIndex::indexOf(const QObjectList &children, const QObject *child)
+{
+    int position = QObjectPrivate::get(child)->positionInParent;
+    if (position >= 0 && position < nextPosition) {
+        const int index = position - removedBefore(position);
+        if (index >= 0 && index < children.size() && children.at(index) == child)
+            return index;
+    }
+
+    // the list was changed behind our back (QWidget::raise() moves
+    // children, for instance), or child isn't in it
+    rebuild(children);
+    position = QObjectPrivate::get(child)->positionInParent;
+    return position >= 0 && position < children.size() && children.at(position) == child
+            ? position : -1;
+}
+
+void QObjectChildIndex::childAppended(const QObjectList &children, QObject *child)
+{
+    Q_ASSERT(children.constLast() == child);
+    if (nextPosition == removed.size() - 1)
+        rebuild(children);
+    else
+        QObjectPrivate::get(child)->positionInParent = nextPosition++;
+}
+
+void QObjectChildIndex::childRemoved(const QObject *child)
+{
+    const int position = QObjectPrivate::get(child)->positionInParent;
+    Q_ASSERT(position >= 0 && position < nextPosition);
+    for (int i = position + 1; i < removed.size(); i += i & -i)
+        ++removed[i];
+}
+
 void QObjectPrivate::setParent_helper(QObject *o)
 {
     Q_Q(QObject);
@@ -2013,11 +2486,13 @@ void QObjectPrivate::setParent_helper(QObject *o)
             // don't do anything since QObjectPrivate::deleteChildren() already
             // cleared our entry in parentD->children.
         } else {
-            const int index = parentD->children.indexOf(q);
+            const int index = parentD->indexOfChild(q);
             if (parentD->isDeletingChildren) {
                 parentD->children[index] = 0;
             } else {
                 parentD->children.removeAt(index);
+                if (parentD->childIndex)
+                    parentD->childIndex->childRemoved(q);
                 if (sendChildEvents && parentD->receiveChildEvents) {
                     QChildEvent e(QEvent::ChildRemoved, q);
                     QCoreApplication::sendEvent(parent, &e);
@@ -2033,8 +2508,11 @@ void QObjectPrivate::setParent_helper(QObject *o)
             parent = 0;
             return;
         }
-        parent->d_func()->children.append(q);
-        if(sendChildEvents && parent->d_func()->receiveChildEvents) {
+        QObjectPrivate *parentD = parent->d_func();
+        parentD->children.append(q);
+        if (parentD->childIndex)
+            parentD->childIndex->childAppended(parentD->children, q);
+        if(sendChildEvents && parentD->receiveChildEvents) {
             if (!isWidget) {
                 QChildEvent e(QEvent::ChildAdded, q);
                 QCoreApplication::sendEvent(parent, &e);
@@ -2456,10 +2934,10 @@ int QObject::receivers(const char *signal) const
         }
 
         QMutexLocker locker(signalSlotLock(this));
-        if (d->connectionLists) {
-            if (signal_index < d->connectionLists->count()) {
+        if (const QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+            if (signal_index < connectionLists->count()) {
                 const QObjectPrivate::Connection *c =
-                    d->connectionLists->at(signal_index).first;
+                    connectionLists->at(signal_index).first;
                 while (c) {
                     receivers += c->receiver ? 1 : 0;
                     c = c->nextConnectionList;
@@ -2507,10 +2985,10 @@ bool QObject::isSignalConnected(const QMetaMethod &signal) const
         return d->isSignalConnected(signalIndex);
 
     QMutexLocker locker(signalSlotLock(this));
-    if (d->connectionLists) {
-        if (signalIndex < uint(d->connectionLists->count())) {
+    if (const QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+        if (signalIndex < uint(connectionLists->count())) {
             const QObjectPrivate::Connection *c =
-                d->connectionLists->at(signalIndex).first;
+                connectionLists->at(signalIndex).first;
             while (c) {
                 if (c->receiver)
                     return true;
@@ -3287,6 +3765,9 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     QOrderedMutexLocker locker(signalSlotLock(sender),
                                signalSlotLock(receiver));
 
+    const int batchFlags = type & (Qt::BatchedConnection | Qt::ConflatedConnection);
+    type &= ~batchFlags;
+
     if (type & Qt::UniqueConnection) {
         QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists;
         if (connectionLists && connectionLists->count() > signal_index) {
@@ -3312,13 +3793,17 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->method_offset = method_offset;
     c->connectionType = type;
     c->isSlotObject = false;
+    c->isBatched = batchFlags != 0;
+    c->isConflated = (batchFlags & Qt::ConflatedConnection) != 0;
     c->argumentTypes.store(types);
     c->nextConnectionList = 0;
     c->callFunction = callFunction;
 
-    QObjectPrivate::get(s)->addConnection(signal_index, c.data());
+    const QVector<QObjectPrivate::Connection *> orphans =
+            QObjectPrivate::get(s)->addConnection(signal_index, c.data());
 
     locker.unlock();
+    QObjectConnectionListVector::derefConnections(orphans);
     QMetaMethod smethod = QMetaObjectPrivate::signal(smeta, signal_index);
     if (smethod.isValid())
         s->connectNotify(smethod);
@@ -3358,10 +3843,15 @@ bool QMetaObject::disconnectOne(const QObject *sender, int signal_index,
 /*!
     \internal
     Helper function to remove the connection from the senders list and setting the receivers to 0
+
+    The connections to slot objects are appended to \a slotConnections, so
+    that the caller can release the slot objects once no emission uses them.
  */
 bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::Connection *c,
                                           const QObject *receiver, int method_index, void **slot,
-                                          QMutex *senderMutex, DisconnectType disconnectType)
+                                          QMutex *senderMutex,
+                                          QVector<QObjectPrivate::Connection *> *slotConnections,
+                                          DisconnectType disconnectType)
 {
     bool success = false;
     while (c) {
@@ -3386,13 +3876,8 @@ bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::Connection *c,
                 receiverMutex->unlock();
 
             c->receiver = 0;
-
-            if (c->isSlotObject) {
-                c->isSlotObject = false;
-                senderMutex->unlock();
-                c->slotObj->destroyIfLastRef();
-                senderMutex->lock();
-            }
+            if (c->isSlotObject)
+                slotConnections->append(c);
 
             success = true;
 
@@ -3428,13 +3913,15 @@ bool QMetaObjectPrivate::disconnect(const QObject *sender,
     // prevent incoming connections changing the connectionLists while unlocked
     ++connectionLists->inUse;
 
+    QVector<QObjectPrivate::Connection *> slotConnections;
     bool success = false;
     if (signal_index < 0) {
         // remove from all connection lists
         for (int sig_index = -1; sig_index < connectionLists->count(); ++sig_index) {
             QObjectPrivate::Connection *c =
                 (*connectionLists)[sig_index].first;
-            if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType)) {
+            if (disconnectHelper(c, receiver, method_index, slot, senderMutex, &slotConnections,
+                                 disconnectType)) {
                 success = true;
                 connectionLists->dirty = true;
             }
@@ -3442,18 +3929,24 @@ bool QMetaObjectPrivate::disconnect(const QObject *sender,
     } else if (signal_index < connectionLists->count()) {
         QObjectPrivate::Connection *c =
             (*connectionLists)[signal_index].first;
-        if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType)) {
+        if (disconnectHelper(c, receiver, method_index, slot, senderMutex, &slotConnections,
+                             disconnectType)) {
             success = true;
             connectionLists->dirty = true;
         }
     }
 
-    --connectionLists->inUse;
+    const bool stillInUse = connectionLists->inUse.deref();
     Q_ASSERT(connectionLists->inUse >= 0);
-    if (connectionLists->orphaned && !connectionLists->inUse)
-        delete connectionLists;
+    const bool orphaned = connectionLists->orphaned.loadAcquire();
+    QVector<QtPrivate::QSlotObjectBase *> slotObjects;
+    if (!orphaned)
+        slotObjects = connectionLists->takeSlotObjects(slotConnections);
 
     locker.unlock();
+    QObjectConnectionListVector::destroySlotObjects(slotObjects);
+    if (!stillInUse && orphaned)
+        delete connectionLists;
     if (success) {
         QMetaMethod smethod = QMetaObjectPrivate::signal(smeta, signal_index);
         if (smethod.isValid())
@@ -3570,6 +4063,9 @@ void QMetaObject::connectSlotsByName(QObject *o)
 
     \a signal must be in the signal index range (see QObjectPrivate::signalIndex()).
 */
+static void batched_activate(QObject *sender, int signal, QObjectPrivate::Connection *c,
+                             const int *argumentTypes, void **argv, QMutexLocker &locker);
+
 static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c, void **argv,
                             QMutexLocker &locker)
 {
@@ -3587,6 +4083,10 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     }
     if (argumentTypes == &DIRECT_CONNECTION_ONLY) // cannot activate
         return;
+    if (c->isBatched) {
+        batched_activate(sender, signal, c, argumentTypes, argv, locker);
+        return;
+    }
     int nargs = 1; // include return type
     while (argumentTypes[nargs-1])
         ++nargs;
@@ -3624,6 +4124,81 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     QCoreApplication::postEvent(c->receiver, ev);
 }
 
+/*!
+    \internal
+
+    Queues the call through the Qt::BatchedConnection or
+    Qt::ConflatedConnection \a c into the pending batch of the receiver, and
+    posts a QMetaCallBatchEvent for it if there is none.
+*/
+static void batched_activate(QObject *sender, int signal, QObjectPrivate::Connection *c,
+                             const int *argumentTypes, void **argv, QMutexLocker &locker)
+{
+    int nargs = 1; // include return type
+    while (argumentTypes[nargs-1])
+        ++nargs;
+    QVarLengthArray<void *, 16> args(nargs);
+    args[0] = 0; // return value
+
+    if (nargs > 1) {
+        locker.unlock();
+        for (int n = 1; n < nargs; ++n)
+            args[n] = QMetaType::create(argumentTypes[n-1], argv[n]);
+        locker.relock();
+    }
+
+    QObject *receiver = c->receiver;
+    QMetaCallBatch *closedBatch = nullptr;
+    QMetaCallBatchEvent *ev = nullptr;
+    if (receiver) {
+        QMutex *receiverMutex = signalSlotLock(receiver);
+        const bool needToUnlock = QOrderedMutexLocker::relock(locker.mutex(), receiverMutex);
+        if (c->receiver == receiver) {
+            // addCall() hands back the arguments it replaced in args
+            QVarLengthArray<void *, 16> replacedArgs;
+            QObjectPrivate *r = QObjectPrivate::get(receiver);
+            QMetaCallBatch *batch = r->metaCallBatch;
+            if (batch) {
+                QMutexLocker batchLocker(&batch->mutex);
+                if (!batch->closed) {
+                    batch->addCall(c, sender, signal, args.data(), nargs, &replacedArgs);
+                } else {
+                    // already being delivered, start a new one
+                    closedBatch = batch;
+                    batch = nullptr;
+                }
+            }
+            if (!batch) {
+                QThreadData *threadData = r->threadData;
+                batch = threadData->metaCallBatchPool.acquire(threadData);
+                batch->addCall(c, sender, signal, args.data(), nargs, &replacedArgs);
+                r->metaCallBatch = batch;
+                ev = new QMetaCallBatchEvent(batch);
+            }
+            args.resize(1);
+            args.append(replacedArgs.constData(), replacedArgs.size());
+        } else {
+            // we have been disconnected while the mutex was unlocked
+            receiver = nullptr;
+        }
+        if (needToUnlock)
+            receiverMutex->unlock();
+    }
+
+    if (ev)
+        QCoreApplication::postEvent(receiver, ev);
+
+    if (args.size() > 1 || closedBatch) {
+        locker.unlock();
+        // either the arguments we could not queue, or the ones a conflated call replaced
+        for (int n = 1; n < args.size(); ++n)
+            QMetaType::destroy(argumentTypes[n-1], args[n]);
+        if (closedBatch)
+            QMetaCallBatch::deref(closedBatch);
+        locker.relock();
+    }
+}
+
 /*!
     \internal
  */
@@ -3663,32 +4238,42 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
     }
 
     {
-    QMutexLocker locker(signalSlotLock(sender));
+    // Connections are only deleted once no emission uses the lists any
+    // more, so they can be walked without the signalSlotLock(). It is
+    // only taken when a call has to be queued.
     struct ConnectionListsRef {
+        QObject *sender;
         QObjectConnectionListVector *connectionLists;
-        ConnectionListsRef(QObjectConnectionListVector *connectionLists) : connectionLists(connectionLists)
+        ConnectionListsRef(QObject *sender, QObjectConnectionListVector *connectionLists)
+            : sender(sender), connectionLists(connectionLists)
         {
             if (connectionLists)
-                ++connectionLists->inUse;
+                connectionLists->inUse.ref();
         }
         ~ConnectionListsRef()
         {
             if (!connectionLists)
                 return;
 
-            --connectionLists->inUse;
-            Q_ASSERT(connectionLists->inUse >= 0);
-            if (connectionLists->orphaned) {
-                if (!connectionLists->inUse)
-                    delete connectionLists;
+            if (connectionLists->inUse.deref())
+                return;
+            if (connectionLists->orphaned.loadAcquire()) {
+                delete connectionLists;
+            } else if (connectionLists->dirty.load()) {
+                // release what was disconnected during the emission
+                QVector<QObjectPrivate::Connection *> orphans;
+                {
+                    QMutexLocker locker(signalSlotLock(sender));
+                    orphans = sender->d_func()->cleanConnectionLists();
+                }
+                QObjectConnectionListVector::derefConnections(orphans);
             }
         }
 
         QObjectConnectionListVector *operator->() const { return connectionLists; }
     };
-    ConnectionListsRef connectionLists = sender->d_func()->connectionLists;
+    ConnectionListsRef connectionLists(sender, sender->d_func()->connectionLists.loadAcquire());
     if (!connectionLists.connectionLists) {
-        locker.unlock();
         if (qt_signal_spy_callback_set.signal_end_callback != 0)
             qt_signal_spy_callback_set.signal_end_callback(sender, signal_index);
         return;
@@ -3700,27 +4285,30 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
     else
         list = &connectionLists->allsignals;
 
-    Qt::HANDLE currentThreadId = QThread::currentThreadId();
+    QThreadData * const currentThreadData = QThreadData::current(false);
 
     do {
-        QObjectPrivate::Connection *c = list->first;
+        QObjectPrivate::Connection *c = list->first.loadAcquire();
         if (!c) continue;
         // We need to check against last here to ensure that signals added
         // during the signal emission are not emitted in this emission.
-        QObjectPrivate::Connection *last = list->last;
+        QObjectPrivate::Connection *last = list->last.loadAcquire();
 
         do {
-            if (!c->receiver)
+            QObject * const receiver = c->receiver.loadAcquire();
+            if (!receiver)
                 continue;
 
-            QObject * const receiver = c->receiver;
-            const bool receiverInSameThread = currentThreadId == receiver->d_func()->threadData->threadId.load();
+            const bool receiverInSameThread = currentThreadData == c->receiverThreadData.loadAcquire();
 
             // determine if this connection should be sent immediately or
             // put into the event queue
             if ((c->connectionType == Qt::AutoConnection && !receiverInSameThread)
                 || (c->connectionType == Qt::QueuedConnection)) {
-                queued_activate(sender, signal_index, c, argv ? argv : empty_argv, locker);
+                QMutexLocker locker(signalSlotLock(sender));
+                // we might have been disconnected before the mutex was locked
+                if (c->receiver.load())
+                    queued_activate(sender, signal_index, c, argv ? argv : empty_argv, locker);
                 continue;
 #ifndef QT_NO_THREAD
             } else if (c->connectionType == Qt::BlockingQueuedConnection) {
@@ -3730,6 +4318,9 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                     sender->metaObject()->className(), sender,
                     receiver->metaObject()->className(), receiver);
                 }
+                QMutexLocker locker(signalSlotLock(sender));
+                if (!c->receiver.load())
+                    continue;
                 QSemaphore semaphore;
                 QMetaCallEvent *ev = c->isSlotObject ?
                     new QMetaCallEvent(c->slotObj, sender, signal_index, 0, 0, argv ? argv : empty_argv, &semaphore) :
@@ -3737,7 +4328,6 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                 QCoreApplication::postEvent(receiver, ev);
                 locker.unlock();
                 semaphore.acquire();
-                locker.relock();
                 continue;
 #endif
             }
@@ -3750,21 +4340,12 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
             if (c->isSlotObject) {
                 c->slotObj->ref();
                 QScopedPointer<QtPrivate::QSlotObjectBase, QSlotObjectBaseDeleter> obj(c->slotObj);
-                locker.unlock();
                 obj->call(receiver, argv ? argv : empty_argv);
-
-                // Make sure the slot object gets destroyed before the mutex is locked again, as the
-                // destructor of the slot object might also lock a mutex from the signalSlotLock() mutex pool,
-                // and that would deadlock if the pool happens to return the same mutex.
-                obj.reset();
-
-                locker.relock();
             } else if (c->callFunction && c->method_offset <= receiver->metaObject()->methodOffset()) {
                 //we compare the vtable to make sure we are not in the destructor of the object.
                 const int methodIndex = c->method();
                 const int method_relative = c->method_relative;
                 const auto callFunction = c->callFunction;
-                locker.unlock();
                 if (qt_signal_spy_callback_set.slot_begin_callback != 0)
                     qt_signal_spy_callback_set.slot_begin_callback(receiver, methodIndex, argv ? argv : empty_argv);
 
@@ -3772,10 +4353,8 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
 
                 if (qt_signal_spy_callback_set.slot_end_callback != 0)
                     qt_signal_spy_callback_set.slot_end_callback(receiver, methodIndex);
-                locker.relock();
             } else {
                 const int method = c->method_relative + c->method_offset;
-                locker.unlock();
 
                 if (qt_signal_spy_callback_set.slot_begin_callback != 0) {
                     qt_signal_spy_callback_set.slot_begin_callback(receiver,
@@ -3787,15 +4366,13 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
 
                 if (qt_signal_spy_callback_set.slot_end_callback != 0)
                     qt_signal_spy_callback_set.slot_end_callback(receiver, method);
-
-                locker.relock();
             }
 
-            if (connectionLists->orphaned)
+            if (connectionLists->orphaned.loadAcquire())
                 break;
-        } while (c != last && (c = c->nextConnectionList) != 0);
+        } while (c != last && (c = c->nextConnectionList.loadAcquire()) != 0);
 
-        if (connectionLists->orphaned)
+        if (connectionLists->orphaned.loadAcquire())
             break;
     } while (list != &connectionLists->allsignals &&
         //start over for all signals;
@@ -4067,16 +4644,17 @@ void QObject::dumpObjectInfo() const
     // first, look for connections where this object is the sender
     qDebug("  SIGNALS OUT");
 
-    if (d->connectionLists) {
-        for (int signal_index = 0; signal_index < d->connectionLists->count(); ++signal_index) {
+    if (const QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+        for (int signal_index = 0; signal_index < connectionLists->count(); ++signal_index) {
             const QMetaMethod signal = QMetaObjectPrivate::signal(metaObject(), signal_index);
             qDebug("        signal: %s", signal.methodSignature().constData());
 
             // receivers
             const QObjectPrivate::Connection *c =
-                d->connectionLists->at(signal_index).first;
+                connectionLists->at(signal_index).first;
             while (c) {
-                if (!c->receiver) {
+                QObject *receiver = c->receiver.load();
+                if (!receiver) {
                     qDebug("          <Disconnected receiver>");
                     c = c->nextConnectionList;
                     continue;
@@ -4086,11 +4664,11 @@ void QObject::dumpObjectInfo() const
                     c = c->nextConnectionList;
                     continue;
                 }
-                const QMetaObject *receiverMetaObject = c->receiver->metaObject();
+                const QMetaObject *receiverMetaObject = receiver->metaObject();
                 const QMetaMethod method = receiverMetaObject->method(c->method());
                 qDebug("          --> %s::%s %s",
                        receiverMetaObject->className(),
-                       c->receiver->objectName().isEmpty() ? "unnamed" : qPrintable(c->receiver->objectName()),
+                       receiver->objectName().isEmpty() ? "unnamed" : qPrintable(receiver->objectName()),
                        method.methodSignature().constData());
                 c = c->nextConnectionList;
             }
@@ -4816,6 +5394,9 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     QOrderedMutexLocker locker(signalSlotLock(sender),
                                signalSlotLock(receiver));
 
+    const int batchFlags = type & (Qt::BatchedConnection | Qt::ConflatedConnection);
+    type = static_cast<Qt::ConnectionType>(type & ~batchFlags);
+
     if (type & Qt::UniqueConnection && slot) {
         QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists;
         if (connectionLists && connectionLists->count() > signal_index) {
@@ -4840,14 +5421,18 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     c->slotObj = slotObj;
     c->connectionType = type;
     c->isSlotObject = true;
+    c->isBatched = batchFlags != 0;
+    c->isConflated = (batchFlags & Qt::ConflatedConnection) != 0;
     if (types) {
         c->argumentTypes.store(types);
         c->ownArgumentTypes = false;
     }
 
-    QObjectPrivate::get(s)->addConnection(signal_index, c.data());
+    const QVector<QObjectPrivate::Connection *> orphans =
+            QObjectPrivate::get(s)->addConnection(signal_index, c.data());
     QMetaObject::Connection ret(c.take());
     locker.unlock();
+    QObjectConnectionListVector::derefConnections(orphans);
 
     QMetaMethod method = QMetaObjectPrivate::signal(senderMetaObject, signal_index);
     Q_ASSERT(method.isValid());
@@ -4874,6 +5459,7 @@ bool QObject::disconnect(const QMetaObject::Connection &connection)
     QMutex *senderMutex = signalSlotLock(c->sender);
     QMutex *receiverMutex = signalSlotLock(c->receiver);
 
+    QVector<QtPrivate::QSlotObjectBase *> slotObjects;
     {
         QOrderedMutexLocker locker(senderMutex, receiverMutex);
 
@@ -4885,14 +5471,11 @@ bool QObject::disconnect(const QMetaObject::Connection &connection)
         if (c->next)
             c->next->prev = c->prev;
         c->receiver = 0;
-    }
 
-    // destroy the QSlotObject, if possible
-    if (c->isSlotObject) {
-        c->slotObj->destroyIfLastRef();
-        c->isSlotObject = false;
+        if (c->isSlotObject)
+            slotObjects = connectionLists->takeSlotObjects({ c });
     }
-
+    QObjectConnectionListVector::destroySlotObjects(slotObjects);
     c->sender->disconnectNotify(QMetaObjectPrivate::signal(c->sender->metaObject(),
                                                            c->signal_index));
 
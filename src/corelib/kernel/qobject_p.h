@@ -57,7 +57,10 @@
 #include "QtCore/qpointer.h"
 #include "QtCore/qsharedpointer.h"
 #include "QtCore/qcoreevent.h"
+#include "QtCore/private/qcoreevent_p.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qmutex.h"
+#include "QtCore/qvarlengtharray.h"
 #include "QtCore/qvector.h"
 #include "QtCore/qvariant.h"
 #include "QtCore/qreadwritelock.h"
@@ -67,6 +70,8 @@ QT_BEGIN_NAMESPACE
 class QVariant;
 class QThreadData;
 class QObjectConnectionListVector;
+struct QMetaCallBatch;
+class QObjectChildIndex;
 namespace QtSharedPointer { struct ExternalRefCountData; }
 
 /* for Qt Test */
@@ -127,13 +132,16 @@ public:
     struct Connection
     {
         QObject *sender;
-        QObject *receiver;
+        QAtomicPointer<QObject> receiver;
+        // The thread data of the receiver, so that emitting threads do not need
+        // to touch the receiver to find out whether the call must be queued
+        QAtomicPointer<QThreadData> receiverThreadData;
         union {
             StaticMetaCallFunction callFunction;
             QtPrivate::QSlotObjectBase *slotObj;
         };
         // The next pointer for the singly-linked ConnectionList
-        Connection *nextConnectionList;
+        QAtomicPointer<Connection> nextConnectionList;
         //senders linked list
         Connection *next;
         Connection **prev;
@@ -145,7 +153,10 @@ public:
         ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 4 == blocking
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
-        Connection() : nextConnectionList(nullptr), ref_(2), ownArgumentTypes(true) {
+        ushort isBatched : 1; // Qt::BatchedConnection or Qt::ConflatedConnection
+        ushort isConflated : 1;
+        Connection() : nextConnectionList(nullptr), ref_(2), ownArgumentTypes(true),
+            isBatched(false), isConflated(false) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
         ~Connection();
@@ -161,8 +172,8 @@ public:
     // ConnectionList is a singly-linked list
     struct ConnectionList {
         ConnectionList() : first(nullptr), last(nullptr) {}
-        Connection *first;
-        Connection *last;
+        QAtomicPointer<Connection> first;
+        QAtomicPointer<Connection> last;
     };
 
     struct Sender
@@ -176,18 +187,20 @@ public:
     QObjectPrivate(int version = QObjectPrivateVersion);
     virtual ~QObjectPrivate();
     void deleteChildren();
+    int indexOfChild(const QObject *child);
 
     void setParent_helper(QObject *);
     void moveToThread_helper();
     void setThreadData_helper(QThreadData *currentData, QThreadData *targetData);
+    void setConnectionThreadData_helper(QThreadData *targetData);
     void _q_reregisterTimers(void *pointer);
 
     bool isSender(const QObject *receiver, const char *signal) const;
     QObjectList receiverList(const char *signal) const;
     QObjectList senderList() const;
 
-    void addConnection(int signal, Connection *c);
-    void cleanConnectionLists();
+    QVector<Connection *> addConnection(int signal, Connection *c);
+    QVector<Connection *> cleanConnectionLists();
 
     static inline Sender *setCurrentSender(QObject *receiver,
                                     Sender *sender);
@@ -228,7 +241,8 @@ public:
     ExtraData *extraData;    // extra data set by the user
     QThreadData *threadData; // id of the thread that owns the object
 
-    QObjectConnectionListVector *connectionLists;
+    // read without locking by QMetaObject::activate()
+    QAtomicPointer<QObjectConnectionListVector> connectionLists;
 
     Connection *senders;     // linked list of connections connected to this object
     Sender *currentSender;   // object currently activating the object
@@ -242,6 +256,24 @@ public:
     // these objects are all used to indicate that a QObject was deleted
     // plus QPointer, which keeps a separate list
     QAtomicPointer<QtSharedPointer::ExternalRefCountData> sharedRefcount;
+
+    // calls through batched connections waiting to be delivered to this
+    // object, guarded by signalSlotLock(q_ptr)
+    QMetaCallBatch *metaCallBatch;
+
+    // position in threadData->postEventList.deferredDeletes, or -1,
+    // guarded by the postEventList mutex
+    int deferredDeleteIndex;
+
+    // events posted to this object and not delivered yet; counted here
+    // rather than in QObjectData::postedEvents, because postEvent() also
+    // counts them without holding the postEventList mutex
+    QAtomicInt postedEventCount;
+
+    // finds children without scanning the list, for objects with many children
+    QObjectChildIndex *childIndex;
+    // this object's position in parent->d_func()->childIndex
+    int positionInParent;
 };
 
 Q_DECLARE_TYPEINFO(QObjectPrivate::ConnectionList, Q_MOVABLE_TYPE);
@@ -392,6 +424,9 @@ public:
 
     virtual void placeMetaCall(QObject *object);
 
+    // posted for every queued call, so recycle the memory
+    Q_DECLARE_POOLED_EVENT
+
 private:
     QtPrivate::QSlotObjectBase *slotObj_;
     const QObject *sender_;
@@ -405,6 +440,96 @@ private:
     ushort method_relative_;
 };
 
+// The calls queued through Qt::BatchedConnection and Qt::ConflatedConnection
+// for one receiver. Senders keep adding calls until the QMetaCallBatchEvent
+// that delivers them closes the batch.
+struct QMetaCallBatch
+{
+    struct Call
+    {
+        QObjectPrivate::Connection *connection;
+        // referenced, so that it outlives a disconnect before the delivery
+        QtPrivate::QSlotObjectBase *slotObj;
+        const QObject *sender;
+        int signalId;
+        int argumentOffset; // the call's argv starts at arguments[argumentOffset]
+    };
+
+    QMetaCallBatch() : threadData(nullptr), closed(false) {}
+
+    void addCall(QObjectPrivate::Connection *c, const QObject *sender, int signalId,
+                 void **args, int nargs, QVarLengthArray<void *, 16> *replacedArgs);
+    void clearCalls();
+
+    void ref() { ref_.ref(); }
+    static void deref(QMetaCallBatch *batch);
+
+    QAtomicInt ref_;
+    QThreadData *threadData; // owns the pool the batch was taken from
+    QMutex mutex; // guards closed, and calls and arguments while not closed
+    bool closed;
+    QVarLengthArray<Call, 16> calls;
+    QVarLengthArray<void *, 64> arguments;
+};
+
+// Per-thread cache of batches, so that steady streams of batched calls
+// don't allocate.
+class QMetaCallBatchPool
+{
+public:
+    QMetaCallBatchPool() {}
+    ~QMetaCallBatchPool();
+
+    QMetaCallBatch *acquire(QThreadData *threadData);
+    void release(QMetaCallBatch *batch);
+
+private:
+    Q_DISABLE_COPY(QMetaCallBatchPool)
+    enum { MaxCachedBatches = 8 };
+
+    QMutex mutex;
+    QVarLengthArray<QMetaCallBatch *, MaxCachedBatches> cached;
+};
+
+// Locates children in the children list of an object with many children.
+// Each child remembers its position in the list as of the last rebuild(),
+// children appended later continue the numbering, and a Fenwick tree counts
+// the children removed in front of every position. Changes made to the list
+// without telling the index make the lookup miss, which rebuilds it.
+class QObjectChildIndex
+{
+public:
+    enum { MinimumChildren = 32 };
+
+    explicit QObjectChildIndex(const QObjectList &children) { rebuild(children); }
+
+    int indexOf(const QObjectList &children, const QObject *child);
+    void childAppended(const QObjectList &children, QObject *child);
+    void childRemoved(const QObject *child);
+
+private:
+    void rebuild(const QObjectList &children);
+    int removedBefore(int position) const;
+
+    // removed[1..capacity] is the Fenwick tree
+    QVector<int> removed;
+    int nextPosition;
+};
+
+class QMetaCallBatchEvent : public QMetaCallEvent
+{
+public:
+    explicit QMetaCallBatchEvent(QMetaCallBatch *batch);
+    ~QMetaCallBatchEvent();
+
+    void placeMetaCall(QObject *object) override;
+
+private:
+    void repostCalls(QObject *object, int from);
+
+    QMetaCallBatch *batch_;
+};
+
 class QBoolBlocker
 {
     Q_DISABLE_COPY(QBoolBlocker)
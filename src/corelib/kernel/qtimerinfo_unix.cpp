@@ -53,6 +53,8 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
@@ -83,7 +85,19 @@ QTimerInfoList::QTimerInfoList()
     }
 #endif
 
-    firstTimerInfo = 0;
+    memset(wheel, 0, sizeof(wheel));
+    memset(occupied, 0, sizeof(occupied));
+    overflow = 0;
+    origin = qt_gettime();
+    wheelTick = 0;
+    nextSequence = 0;
+    firstTimer = 0;
+    firstTimerValid = true;
+}
+
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(timers);
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -150,11 +164,17 @@ bool QTimerInfoList::timeChanged(timespec *delta)
 */
 void QTimerInfoList::timerRepair(const timespec &diff)
 {
-    // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    // repair all timers, and rebuild the wheel from the current time
+    for (QTimerInfo *t : qAsConst(timers)) {
+        if (t->pprev)
+            wheelRemove(t);
         t->timeout = t->timeout + diff;
     }
+
+    origin = currentTime;
+    wheelTick = 0;
+    for (QTimerInfo *t : qAsConst(timers))
+        wheelInsert(t);
 }
 
 void QTimerInfoList::repairTimersIfNeeded()
@@ -174,18 +194,227 @@ void QTimerInfoList::repairTimersIfNeeded()
 
 #endif
 
+static inline bool timerIsEarlier(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    if (t1->timeout == t2->timeout)
+        return t1->sequence < t2->sequence;
+    return t1->timeout < t2->timeout;
+}
+
+static QTimerInfo *earliestWaitingTimer(QTimerInfo *t)
+{
+    QTimerInfo *first = 0;
+    for ( ; t; t = t->next) {
+        if (!t->activateRef && (!first || timerIsEarlier(t, first)))
+            first = t;
+    }
+    return first;
+}
+
 /*
-  insert timer info into list
+  Returns the wheel tick (milliseconds since origin) at which a timer
+  expiring at \a timeout is due. Timeouts in the past are due now.
 */
-void QTimerInfoList::timerInsert(QTimerInfo *ti)
+qint64 QTimerInfoList::tickForTimeout(const timespec &timeout) const
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
+    const timespec delta = timeout - origin;
+    if (delta.tv_sec < 0)
+        return wheelTick;
+    return qMax(wheelTick, qint64(delta.tv_sec) * 1000 + delta.tv_nsec / (1000 * 1000));
+}
+
+/*
+  Links the timer into the slot of the lowest level whose range still
+  reaches its tick. Timers on a level above 0 share a slot with timers due
+  at a close but different tick; they are sorted out by cascade().
+*/
+void QTimerInfoList::wheelInsert(QTimerInfo *t)
+{
+    const qint64 tick = tickForTimeout(t->timeout);
+    QTimerInfo **head = &overflow;
+    for (int level = 0; level < WheelLevels; ++level) {
+        const int shift = level * WheelBits;
+        if ((tick >> shift) - (wheelTick >> shift) < WheelSize) {
+            const int slot = int(tick >> shift) & (WheelSize - 1);
+            head = &wheel[level][slot];
+            occupied[level] |= Q_UINT64_C(1) << slot;
             break;
+        }
+    }
+
+    t->next = *head;
+    if (t->next)
+        t->next->pprev = &t->next;
+    t->pprev = head;
+    *head = t;
+
+    if (firstTimerValid && !t->activateRef && (!firstTimer || timerIsEarlier(t, firstTimer)))
+        firstTimer = t;
+}
+
+void QTimerInfoList::wheelRemove(QTimerInfo *t)
+{
+    *t->pprev = t->next;
+    if (t->next) {
+        t->next->pprev = t->pprev;
+    } else {
+        QTimerInfo **first = &wheel[0][0];
+        if (!*t->pprev && t->pprev >= first && t->pprev < first + WheelLevels * WheelSize) {
+            // that was the last timer in the slot
+            const int index = int(t->pprev - first);
+            occupied[index / WheelSize] &= ~(Q_UINT64_C(1) << (index % WheelSize));
+        }
+    }
+    t->next = 0;
+    t->pprev = 0;
+
+    if (t == firstTimer)
+        firstTimerValid = false;
+}
+
+/*
+  Moves the timers of the slots that start at \a tick down to the lower
+  levels. The higher levels come first, as their timers may land in the
+  lower level slots that are cascaded next.
+*/
+void QTimerInfoList::cascade(qint64 tick)
+{
+    if ((tick & ((Q_INT64_C(1) << (WheelLevels * WheelBits)) - 1)) == 0) {
+        QTimerInfo *t = overflow;
+        overflow = 0;
+        while (t) {
+            QTimerInfo *next = t->next;
+            wheelInsert(t);
+            t = next;
+        }
+    }
+
+    for (int level = WheelLevels - 1; level > 0; --level) {
+        const int shift = level * WheelBits;
+        if (tick & ((Q_INT64_C(1) << shift) - 1))
+            continue;
+
+        const int slot = int(tick >> shift) & (WheelSize - 1);
+        if (!(occupied[level] & (Q_UINT64_C(1) << slot)))
+            continue;
+
+        QTimerInfo *t = wheel[level][slot];
+        wheel[level][slot] = 0;
+        occupied[level] &= ~(Q_UINT64_C(1) << slot);
+        while (t) {
+            QTimerInfo *next = t->next;
+            wheelInsert(t);
+            t = next;
+        }
+    }
+}
+
+/*
+  Advances the wheel to the current time, unlinking the timers that have
+  expired and appending them to \a expired.
+*/
+void QTimerInfoList::advanceWheel(QVarLengthArray<QTimerInfo *, 32> &expired)
+{
+    const qint64 nowTick = tickForTimeout(currentTime);
+
+    bool empty = !overflow;
+    for (int level = 0; empty && level < WheelLevels; ++level)
+        empty = !occupied[level];
+    if (empty) {
+        wheelTick = nowTick;
+        return;
+    }
+
+    while (wheelTick < nowTick) {
+        // all timers in the level 0 slots before nowTick have expired; go
+        // to the end of the current rotation at most, then cascade
+        const qint64 stop = qMin((wheelTick | (WheelSize - 1)) + 1, nowTick);
+        const int firstSlot = int(wheelTick) & (WheelSize - 1);
+        const int lastSlot = int(stop - 1) & (WheelSize - 1);
+        quint64 bits = occupied[0] & (~Q_UINT64_C(0) >> (WheelSize - 1 - lastSlot))
+                                   & (~Q_UINT64_C(0) << firstSlot);
+        occupied[0] &= ~bits;
+        while (bits) {
+            const int slot = qCountTrailingZeroBits(bits);
+            bits &= bits - 1;
+            for (QTimerInfo *t = wheel[0][slot]; t; t = t->next) {
+                t->pprev = 0;
+                expired.append(t);
+            }
+            wheel[0][slot] = 0;
+        }
+
+        wheelTick = stop;
+        if ((wheelTick & (WheelSize - 1)) == 0)
+            cascade(wheelTick);
     }
-    insert(index+1, ti);
+
+    // the slot of the current millisecond may also hold timers due later in it
+    QTimerInfo *t = wheel[0][wheelTick & (WheelSize - 1)];
+    while (t) {
+        QTimerInfo *next = t->next;
+        if (!(currentTime < t->timeout)) {
+            wheelRemove(t);
+            expired.append(t);
+        }
+        t = next;
+    }
+}
+
+/*
+  Returns the earliest timer that is not being activated, or null if there
+  is none. Only the first non-empty slot of the lowest non-empty level needs
+  to be searched, as every timer on a level is due before those above it.
+*/
+QTimerInfo *QTimerInfoList::firstWaitingTimer() const
+{
+    for (int level = 0; level < WheelLevels; ++level) {
+        if (!occupied[level])
+            continue;
+
+        // visit the slots in the order in which the wheel reaches them
+        const int start = int(wheelTick >> (level * WheelBits)) & (WheelSize - 1);
+        quint64 bits = occupied[level];
+        if (start)
+            bits = (bits >> start) | (bits << (WheelSize - start));
+        for ( ; bits; bits &= bits - 1) {
+            const int slot = (start + qCountTrailingZeroBits(bits)) & (WheelSize - 1);
+            if (QTimerInfo *t = earliestWaitingTimer(wheel[level][slot]))
+                return t;
+        }
+    }
+    return earliestWaitingTimer(overflow);
+}
+
+void QTimerInfoList::objectTimersInsert(QTimerInfo *t)
+{
+    QTimerInfo *&first = objectTimers[t->obj];
+    t->previousForObject = 0;
+    t->nextForObject = first;
+    if (first)
+        first->previousForObject = t;
+    first = t;
+}
+
+void QTimerInfoList::objectTimersRemove(QTimerInfo *t)
+{
+    if (t->nextForObject)
+        t->nextForObject->previousForObject = t->previousForObject;
+    if (t->previousForObject)
+        t->previousForObject->nextForObject = t->nextForObject;
+    else if (t->nextForObject)
+        objectTimers[t->obj] = t->nextForObject;
+    else
+        objectTimers.remove(t->obj);
+}
+
+/*
+  insert timer info into the wheel
+*/
+void QTimerInfoList::timerInsert(QTimerInfo *ti)
+{
+    ti->sequence = nextSequence++;
+    wheelInsert(ti);
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -389,14 +618,12 @@ bool QTimerInfoList::timerWait(timespec &tm)
     repairTimersIfNeeded();
 
     // Find first waiting timer not already active
-    QTimerInfo *t = 0;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
-        }
+    if (!firstTimerValid) {
+        firstTimer = firstWaitingTimer();
+        firstTimerValid = true;
     }
 
+    const QTimerInfo *t = firstTimer;
     if (!t)
       return false;
 
@@ -423,16 +650,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timers.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -451,6 +675,8 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     t->timerType = timerType;
     t->obj = object;
     t->activateRef = 0;
+    t->next = 0;
+    t->pprev = 0;
 
     timespec expected = updateCurrentTime() + interval;
 
@@ -494,6 +720,8 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     }
 
     timerInsert(t);
+    timers.insert(timerId, t);
+    objectTimersInsert(t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -507,57 +735,52 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
-    // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    QTimerInfo *t = timers.take(timerId);
+    if (!t)
+        return false; // id not found
+
+    objectTimersRemove(t);
+    if (t->pprev)
+        wheelRemove(t);
+    if (t->activateRef)
+        *(t->activateRef) = 0;
+    delete t;
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->obj == object) {
-            // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
-        }
+    QTimerInfo *t = objectTimers.take(object);
+    while (t) {
+        QTimerInfo *next = t->nextForObject;
+        timers.remove(t->id);
+        if (t->pprev)
+            wheelRemove(t);
+        if (t->activateRef)
+            *(t->activateRef) = 0;
+        delete t;
+        t = next;
     }
     return true;
 }
 
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
+    // report the timers in the order in which they are due
+    QVarLengthArray<const QTimerInfo *, 8> objectTimerInfos;
+    for (const QTimerInfo *t = objectTimers.value(object); t; t = t->nextForObject)
+        objectTimerInfos.append(t);
+    std::sort(objectTimerInfos.begin(), objectTimerInfos.end(), timerIsEarlier);
+
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
-        if (t->obj == object) {
-            list << QAbstractEventDispatcher::TimerInfo(t->id,
-                                                        (t->timerType == Qt::VeryCoarseTimer
-                                                         ? t->interval * 1000
-                                                         : t->interval),
-                                                        t->timerType);
-        }
+    for (const QTimerInfo *t : qAsConst(objectTimerInfos)) {
+        list << QAbstractEventDispatcher::TimerInfo(t->id,
+                                                    (t->timerType == Qt::VeryCoarseTimer
+                                                     ? t->interval * 1000
+                                                     : t->interval),
+                                                    t->timerType);
     }
     return list;
 }
@@ -570,43 +793,25 @@ int QTimerInfoList::activateTimers()
     if (qt_disable_lowpriority_timers || isEmpty())
         return 0; // nothing to do
 
-    int n_act = 0, maxCount = 0;
-    firstTimerInfo = 0;
-
     timespec currentTime = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << currentTime;
     repairTimersIfNeeded();
 
-
-    // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
-
-    //fire the timers.
-    while (maxCount--) {
-        if (isEmpty())
-            break;
-
-        QTimerInfo *currentTimerInfo = constFirst();
-        if (currentTime < currentTimerInfo->timeout)
-            break; // no timer has expired
-
-        if (!firstTimerInfo) {
-            firstTimerInfo = currentTimerInfo;
-        } else if (firstTimerInfo == currentTimerInfo) {
-            // avoid sending the same timer multiple times
-            break;
-        } else if (currentTimerInfo->interval <  firstTimerInfo->interval
-                   || currentTimerInfo->interval == firstTimerInfo->interval) {
-            firstTimerInfo = currentTimerInfo;
-        }
-
-        // remove from list
-        removeFirst();
-
+    // Find out which timers have expired
+    QVarLengthArray<QTimerInfo *, 32> expired;
+    advanceWheel(expired);
+    firstTimerValid = false;
+    if (expired.isEmpty())
+        return 0;
+    std::sort(expired.begin(), expired.end(), timerIsEarlier);
+
+    // Determine the next timeouts before sending any event, so that every
+    // timer is in the wheel while the event handlers run. A handler may
+    // unregister or restart any of them, so each timer is looked up again
+    // before its event is sent.
+    QVarLengthArray<QPair<int, quint64>, 32> activations;
+    int n_act = 0;
+    for (QTimerInfo *currentTimerInfo : qAsConst(expired)) {
 #ifdef QTIMERINFO_DEBUG
         float diff;
         if (currentTime < currentTimerInfo->expected) {
@@ -635,19 +840,29 @@ int QTimerInfoList::activateTimers()
         if (currentTimerInfo->interval > 0)
             n_act++;
 
+        activations.append(qMakePair(currentTimerInfo->id, currentTimerInfo->sequence));
+    }
+
+    //fire the timers.
+    for (const auto &activation : qAsConst(activations)) {
+        QTimerInfo *currentTimerInfo = timers.value(activation.first);
+        if (!currentTimerInfo || currentTimerInfo->sequence != activation.second)
+            continue; // unregistered, restarted or already activated again
+
         if (!currentTimerInfo->activateRef) {
             // send event, but don't allow it to recurse
             currentTimerInfo->activateRef = &currentTimerInfo;
+            firstTimerValid = false;
 
             QTimerEvent e(currentTimerInfo->id);
             QCoreApplication::sendEvent(currentTimerInfo->obj, &e);
 
             if (currentTimerInfo)
                 currentTimerInfo->activateRef = 0;
+            firstTimerValid = false;
         }
     }
 
-    firstTimerInfo = 0;
     // qDebug() << "Thread" << QThread::currentThreadId() << "activated" << n_act << "timers";
     return n_act;
 }
@@ -56,6 +56,8 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
+#include "qvarlengtharray.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -70,6 +72,12 @@ struct QTimerInfo {
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
 
+    QTimerInfo *next;    // - next timer in the same wheel slot
+    QTimerInfo **pprev;  // - link pointing to this timer, null if not in the wheel
+    quint64 sequence;    // - insertion order, breaks ties between equal timeouts
+    QTimerInfo *nextForObject; // - timers of the same object
+    QTimerInfo *previousForObject;
+
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
     float cumulativeError;
@@ -77,7 +85,12 @@ struct QTimerInfo {
 #endif
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+// Timers are kept in a hierarchical timing wheel: level 0 has one slot per
+// millisecond, and every further level has slots WheelSize times as long.
+// Registering or unregistering a timer only links or unlinks it from a
+// slot; the timers of a higher level slot are cascaded down when the wheel
+// reaches it.
+class Q_CORE_EXPORT QTimerInfoList
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
     timespec previousTime;
@@ -89,11 +102,9 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     void timerRepair(const timespec &);
 #endif
 
-    // state variables used by activateTimers()
-    QTimerInfo *firstTimerInfo;
-
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
 
     timespec currentTime;
     timespec updateCurrentTime();
@@ -112,6 +123,41 @@ public:
     QList<QAbstractEventDispatcher::TimerInfo> registeredTimers(QObject *object) const;
 
     int activateTimers();
+
+    bool isEmpty() const { return timers.isEmpty(); }
+    int size() const { return timers.size(); }
+
+private:
+    Q_DISABLE_COPY(QTimerInfoList)
+
+    enum {
+        WheelBits = 6,
+        WheelSize = 1 << WheelBits,
+        WheelLevels = 6
+    };
+
+    qint64 tickForTimeout(const timespec &timeout) const;
+    void wheelInsert(QTimerInfo *t);
+    void wheelRemove(QTimerInfo *t);
+    void cascade(qint64 tick);
+    void advanceWheel(QVarLengthArray<QTimerInfo *, 32> &expired);
+    QTimerInfo *firstWaitingTimer() const;
+    void objectTimersInsert(QTimerInfo *t);
+    void objectTimersRemove(QTimerInfo *t);
+
+    QHash<int, QTimerInfo *> timers;
+    QHash<QObject *, QTimerInfo *> objectTimers; // first timer of each object
+
+    QTimerInfo *wheel[WheelLevels][WheelSize];
+    quint64 occupied[WheelLevels];  // bit n set if wheel[level][n] is not empty
+    QTimerInfo *overflow;           // timers beyond the last level
+    timespec origin;                // time of tick 0
+    qint64 wheelTick;               // ticks before this one have been expired
+    quint64 nextSequence;
+
+    // cached result of firstWaitingTimer()
+    QTimerInfo *firstTimer;
+    bool firstTimerValid;
 };
 
 QT_END_NAMESPACE
@@ -44,6 +44,7 @@
 
 #include <QtCore/qfutureinterface.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qfuture_impl.h>
 
 QT_REQUIRE_CONFIG(future);
 
@@ -148,9 +149,95 @@ public:
     const_iterator end() const { return const_iterator(this, -1); }
     const_iterator constEnd() const { return const_iterator(this, -1); }
 
+#ifdef Q_CLANG_QDOC
+    template <typename Function>
+    QFuture<ResultType<Function>> then(Function &&function);
+    template <typename Function>
+    QFuture<ResultType<Function>> then(QtFuture::Launch policy, Function &&function);
+    template <typename Function>
+    QFuture<ResultType<Function>> then(QThreadPool *pool, Function &&function);
+    template <typename Function>
+    QFuture<ResultType<Function>> then(QObject *context, Function &&function);
+    template <typename Function>
+    QFuture<T> onFailed(Function &&handler);
+    template <typename Function>
+    QFuture<T> onFailed(QObject *context, Function &&handler);
+#else
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, T>::Future
+    then(Function &&function)
+    {
+        return continueWith(QtPrivate::ContinuationExecutor(QtFuture::Launch::Sync),
+                            std::forward<Function>(function));
+    }
+
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, T>::Future
+    then(QtFuture::Launch policy, Function &&function)
+    {
+        return continueWith(QtPrivate::ContinuationExecutor(policy),
+                            std::forward<Function>(function));
+    }
+
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, T>::Future
+    then(QThreadPool *pool, Function &&function)
+    {
+        return continueWith(QtPrivate::ContinuationExecutor(pool),
+                            std::forward<Function>(function));
+    }
+
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, T>::Future
+    then(QObject *context, Function &&function)
+    {
+        return continueWith(QtPrivate::ContinuationExecutor(context),
+                            std::forward<Function>(function));
+    }
+
+    template <typename Function>
+    QFuture<T> onFailed(Function &&handler)
+    {
+        return handleFailureWith(QtPrivate::ContinuationExecutor(QtFuture::Launch::Sync),
+                                 std::forward<Function>(handler));
+    }
+
+    template <typename Function>
+    QFuture<T> onFailed(QObject *context, Function &&handler)
+    {
+        return handleFailureWith(QtPrivate::ContinuationExecutor(context),
+                                 std::forward<Function>(handler));
+    }
+#endif
+
 private:
     friend class QFutureWatcher<T>;
 
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, T>::Future
+    continueWith(const QtPrivate::ContinuationExecutor &executor, Function &&function)
+    {
+        typedef typename std::decay<Function>::type F;
+        typedef typename QtPrivate::ContinuationTraits<F, T>::ResultType ResultType;
+        QFutureInterface<ResultType> promise;
+        promise.reportStarted();
+        QtPrivate::Continuation<F, ResultType, T>::create(F(std::forward<Function>(function)),
+                                                          d, promise, executor);
+        return promise.future();
+    }
+
+    template <typename Function>
+    QFuture<T> handleFailureWith(const QtPrivate::ContinuationExecutor &executor,
+                                 Function &&handler)
+    {
+        typedef typename std::decay<Function>::type F;
+        QFutureInterface<T> promise;
+        promise.reportStarted();
+        QtPrivate::FailureHandler<F, T>::create(F(std::forward<Function>(handler)),
+                                                d, promise, executor);
+        return promise.future();
+    }
+
 public: // Warning: the d pointer is not documented and is considered private.
     mutable QFutureInterface<T> d;
 };
@@ -225,9 +312,80 @@ public:
     QString progressText() const { return d.progressText(); }
     void waitForFinished() { d.waitForFinished(); }
 
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, void>::Future
+    then(Function &&function)
+    {
+        return continueWith(QtPrivate::ContinuationExecutor(QtFuture::Launch::Sync),
+                            std::forward<Function>(function));
+    }
+
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, void>::Future
+    then(QtFuture::Launch policy, Function &&function)
+    {
+        return continueWith(QtPrivate::ContinuationExecutor(policy),
+                            std::forward<Function>(function));
+    }
+
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, void>::Future
+    then(QThreadPool *pool, Function &&function)
+    {
+        return continueWith(QtPrivate::ContinuationExecutor(pool),
+                            std::forward<Function>(function));
+    }
+
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, void>::Future
+    then(QObject *context, Function &&function)
+    {
+        return continueWith(QtPrivate::ContinuationExecutor(context),
+                            std::forward<Function>(function));
+    }
+
+    template <typename Function>
+    QFuture<void> onFailed(Function &&handler)
+    {
+        return handleFailureWith(QtPrivate::ContinuationExecutor(QtFuture::Launch::Sync),
+                                 std::forward<Function>(handler));
+    }
+
+    template <typename Function>
+    QFuture<void> onFailed(QObject *context, Function &&handler)
+    {
+        return handleFailureWith(QtPrivate::ContinuationExecutor(context),
+                                 std::forward<Function>(handler));
+    }
+
 private:
     friend class QFutureWatcher<void>;
 
+    template <typename Function>
+    typename QtPrivate::ContinuationTraits<typename std::decay<Function>::type, void>::Future
+    continueWith(const QtPrivate::ContinuationExecutor &executor, Function &&function)
+    {
+        typedef typename std::decay<Function>::type F;
+        typedef typename QtPrivate::ContinuationTraits<F, void>::ResultType ResultType;
+        QFutureInterface<ResultType> promise;
+        promise.reportStarted();
+        QtPrivate::Continuation<F, ResultType, void>::create(F(std::forward<Function>(function)),
+                                                             d, promise, executor);
+        return promise.future();
+    }
+
+    template <typename Function>
+    QFuture<void> handleFailureWith(const QtPrivate::ContinuationExecutor &executor,
+                                    Function &&handler)
+    {
+        typedef typename std::decay<Function>::type F;
+        QFutureInterface<void> promise;
+        promise.reportStarted();
+        QtPrivate::FailureHandler<F, void>::create(F(std::forward<Function>(handler)),
+                                                   d, promise, executor);
+        return promise.future();
+    }
+
 #ifdef QFUTURE_TEST
 public:
 #endif
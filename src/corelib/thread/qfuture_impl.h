@@ -0,0 +1,388 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QFUTURE_H
+#error Do not include qfuture_impl.h directly
+#endif
+
+#if 0
+#pragma qt_sync_skip_header_check
+#pragma qt_sync_stop_processing
+#endif
+
+#include <QtCore/qpointer.h>
+
+#include <memory>
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+class QThreadPool;
+
+namespace QtFuture {
+
+enum class Launch {
+    Sync,
+    Async
+};
+
+} // namespace QtFuture
+
+namespace QtPrivate {
+
+template <typename F, typename Arg, typename = void>
+struct IsCallableWithArgument : std::false_type {};
+
+template <typename F, typename Arg>
+struct IsCallableWithArgument<F, Arg, decltype(void(std::declval<F &>()(std::declval<Arg>())))>
+    : std::true_type {};
+
+template <typename F, typename = void>
+struct IsCallableWithoutArguments : std::false_type {};
+
+template <typename F>
+struct IsCallableWithoutArguments<F, decltype(void(std::declval<F &>()()))> : std::true_type {};
+
+// the type of the argument of a unary function pointer or lambda
+template <typename F>
+struct ArgumentType : ArgumentType<decltype(&F::operator())> {};
+
+template <typename R, typename Arg>
+struct ArgumentType<R (*)(Arg)> { typedef Arg Type; };
+
+template <typename Class, typename R, typename Arg>
+struct ArgumentType<R (Class::*)(Arg)> { typedef Arg Type; };
+
+template <typename Class, typename R, typename Arg>
+struct ArgumentType<R (Class::*)(Arg) const> { typedef Arg Type; };
+
+// Returns the first result of a finished future, moving it out of the
+// result store if nothing else refers to it.
+template <typename T>
+T takeOrCopyResult(QFutureInterface<T> &parent, bool takeResults)
+{
+    QMutexLocker locker(parent.mutex());
+    const ResultIteratorBase it = parent.resultStoreBase().resultAt(0);
+    // results reported together share their vector with the reporter
+    if (takeResults && !it.isVector())
+        return std::move(*const_cast<T *>(it.pointer<T>()));
+    return it.value<T>();
+}
+
+template <typename T>
+void forwardResults(QFutureInterface<T> &parent, QFutureInterface<T> &promise, bool takeResults)
+{
+    const int count = parent.resultCount();
+    if (count == 1)
+        promise.reportAndMoveResult(takeOrCopyResult(parent, takeResults));
+    else if (count > 1)
+        promise.reportResults(parent.results().toVector());
+}
+
+inline void forwardResults(QFutureInterface<void> &, QFutureInterface<void> &, bool)
+{
+}
+
+// A continuation of a QFuture<T> is called either with the future, or with
+// its result; continuations of a QFuture<void> may also take no argument.
+// As QFuture<T> converts to T, a continuation callable with both takes T.
+template <typename F, typename T>
+struct ContinuationTakesFuture
+    : std::integral_constant<bool, IsCallableWithArgument<F, QFuture<T> >::value
+                                   && !IsCallableWithArgument<F, T>::value> {};
+
+template <typename F>
+struct ContinuationTakesFuture<F, void>
+    : std::integral_constant<bool, IsCallableWithArgument<F, QFuture<void> >::value
+                                   && !IsCallableWithoutArguments<F>::value> {};
+
+template <typename F, typename T, bool = ContinuationTakesFuture<F, T>::value>
+struct ContinuationTraits
+{
+    enum { TakesFuture = false };
+    typedef decltype(std::declval<F &>()(std::declval<T>())) InvokeResult;
+    typedef typename std::decay<InvokeResult>::type ResultType;
+    typedef QFuture<ResultType> Future;
+
+    static InvokeResult invoke(F &function, QFutureInterface<T> &parent, bool takeResults)
+    { return function(takeOrCopyResult(parent, takeResults)); }
+};
+
+template <typename F, typename T>
+struct ContinuationTraits<F, T, true>
+{
+    enum { TakesFuture = true };
+    typedef decltype(std::declval<F &>()(std::declval<QFuture<T> >())) InvokeResult;
+    typedef typename std::decay<InvokeResult>::type ResultType;
+    typedef QFuture<ResultType> Future;
+
+    static InvokeResult invoke(F &function, QFutureInterface<T> &parent, bool)
+    { return function(QFuture<T>(&parent)); }
+};
+
+template <typename F>
+struct ContinuationTraits<F, void, false>
+{
+    enum { TakesFuture = false };
+    typedef decltype(std::declval<F &>()()) InvokeResult;
+    typedef typename std::decay<InvokeResult>::type ResultType;
+    typedef QFuture<ResultType> Future;
+
+    static InvokeResult invoke(F &function, QFutureInterface<void> &, bool)
+    { return function(); }
+};
+
+template <typename ResultType>
+struct ResultReporter
+{
+    template <typename Invoke>
+    static void report(QFutureInterface<ResultType> &promise, Invoke invoke)
+    { promise.reportAndMoveResult(ResultType(invoke())); }
+};
+
+template <>
+struct ResultReporter<void>
+{
+    template <typename Invoke>
+    static void report(QFutureInterface<void> &, Invoke invoke)
+    { invoke(); }
+};
+
+// Decides where a continuation runs: in the thread finishing the future, in
+// a thread pool, or in the thread of a context object.
+class Q_CORE_EXPORT ContinuationExecutor
+{
+public:
+    explicit ContinuationExecutor(QtFuture::Launch policy);
+    explicit ContinuationExecutor(QThreadPool *pool);
+    explicit ContinuationExecutor(QObject *context);
+
+    void execute(std::function<void()> &&job) const;
+
+private:
+    enum Kind {
+        Inline,
+        ThreadPool,
+        EventLoop
+    };
+
+    Kind kind;
+    QThreadPool *pool;
+    QPointer<QObject> context;
+};
+
+class ContinuationBase
+{
+protected:
+    // Makes the job run when the parent future finishes. The job must have
+    // a run(QFutureInterface<ParentResultType> &, bool takeResults) function.
+    template <typename ParentResultType, typename Job>
+    static void attach(const std::shared_ptr<Job> &job, QFutureInterfaceBase &parent,
+                       const ContinuationExecutor &executor)
+    {
+        // The future the job is attached to refers to the results too,
+        // so a job that runs right away must not take them.
+        parent.refT();
+        parent.setContinuation([job, executor](const QFutureInterfaceBase &parentData) {
+            const bool takeResults = !parentData.hasSharedResults();
+            QFutureInterface<ParentResultType> parentInterface(parentData);
+            executor.execute([job, parentInterface, takeResults]() mutable {
+                job->run(parentInterface, takeResults);
+            });
+        });
+        parent.derefT();
+    }
+
+    // Finishes a promise whose job is destroyed without having run; the
+    // parent future was destroyed before finishing, or the executor
+    // dropped the job.
+    template <typename ResultType>
+    static void cancelUnlessFinished(QFutureInterface<ResultType> &promise)
+    {
+        if (!promise.isFinished()) {
+            promise.reportCanceled();
+            promise.reportFinished();
+        }
+    }
+
+    // Reports a canceled or failed parent to the promise. Returns false if
+    // the parent has a result to continue with.
+    template <typename ParentResultType, typename ResultType>
+    static bool reportParentFailure(QFutureInterface<ParentResultType> &parent,
+                                    QFutureInterface<ResultType> &promise)
+    {
+        if (!parent.isCanceled()
+                && (std::is_void<ParentResultType>::value || parent.isResultReadyAt(0))) {
+            return false;
+        }
+#ifndef QT_NO_EXCEPTIONS
+        if (parent.exceptionStore().hasException()) {
+            promise.reportException(*parent.exceptionStore().exception().exception());
+            return true;
+        }
+#endif
+        promise.reportCanceled();
+        return true;
+    }
+
+    template <typename ResultType, typename Invoke>
+    static void reportResult(QFutureInterface<ResultType> &promise, Invoke invoke)
+    {
+#ifndef QT_NO_EXCEPTIONS
+        try {
+#endif
+            ResultReporter<ResultType>::report(promise, invoke);
+#ifndef QT_NO_EXCEPTIONS
+        } catch (QException &e) {
+            promise.reportException(e);
+        } catch (...) {
+            promise.reportException(QUnhandledException());
+        }
+#endif
+    }
+};
+
+template <typename Function, typename ResultType, typename ParentResultType>
+class Continuation : public ContinuationBase
+{
+    typedef ContinuationTraits<Function, ParentResultType> Traits;
+
+public:
+    Continuation(Function &&function, const QFutureInterface<ResultType> &promise)
+        : function(std::move(function)), promise(promise)
+    { }
+    ~Continuation() { cancelUnlessFinished(promise); }
+
+    static void create(Function &&function, QFutureInterfaceBase &parent,
+                       const QFutureInterface<ResultType> &promise,
+                       const ContinuationExecutor &executor)
+    {
+        attach<ParentResultType>(std::make_shared<Continuation>(std::move(function), promise),
+                                 parent, executor);
+    }
+
+    void run(QFutureInterface<ParentResultType> &parent, bool takeResults)
+    {
+        if (!promise.isCanceled()
+                && (Traits::TakesFuture || !reportParentFailure(parent, promise))) {
+            reportResult(promise, [&]() { return Traits::invoke(function, parent, takeResults); });
+        }
+        promise.reportFinished();
+    }
+
+private:
+    Function function;
+    QFutureInterface<ResultType> promise;
+};
+
+template <typename Function, typename ResultType>
+class FailureHandler : public ContinuationBase
+{
+public:
+    FailureHandler(Function &&handler, const QFutureInterface<ResultType> &promise)
+        : handler(std::move(handler)), promise(promise)
+    { }
+    ~FailureHandler() { cancelUnlessFinished(promise); }
+
+    static void create(Function &&handler, QFutureInterfaceBase &parent,
+                       const QFutureInterface<ResultType> &promise,
+                       const ContinuationExecutor &executor)
+    {
+        attach<ResultType>(std::make_shared<FailureHandler>(std::move(handler), promise),
+                           parent, executor);
+    }
+
+    void run(QFutureInterface<ResultType> &parent, bool takeResults)
+    {
+        if (!promise.isCanceled()) {
+            if (!parent.isCanceled())
+                forwardResults(parent, promise, takeResults);
+            else if (!handleException(parent))
+                promise.reportCanceled();
+        }
+        promise.reportFinished();
+    }
+
+private:
+#ifndef QT_NO_EXCEPTIONS
+    bool handleException(QFutureInterface<ResultType> &parent)
+    {
+        if (!parent.exceptionStore().hasException())
+            return false;
+        typedef std::integral_constant<bool, IsCallableWithoutArguments<Function>::value>
+                TakesNoArguments;
+        handleException(parent.exceptionStore().exception().exception(), TakesNoArguments());
+        return true;
+    }
+
+    // the handler handles every exception
+    void handleException(const QException *, std::true_type)
+    {
+        reportResult(promise, [&]() { return handler(); });
+    }
+
+    // the handler handles exceptions of the type of its argument
+    void handleException(const QException *exception, std::false_type)
+    {
+        typedef typename std::decay<typename ArgumentType<Function>::Type>::type Exception;
+        try {
+            exception->raise();
+        } catch (Exception &e) {
+            reportResult(promise, [&]() { return handler(e); });
+            return;
+        } catch (...) {
+        }
+        // leave the exception to the next handler
+        promise.reportException(*exception);
+    }
+#else
+    bool handleException(QFutureInterface<ResultType> &)
+    {
+        return false;
+    }
+#endif
+
+    Function handler;
+    QFutureInterface<ResultType> promise;
+};
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
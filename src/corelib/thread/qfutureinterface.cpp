@@ -290,9 +290,42 @@ void QFutureInterfaceBase::reportFinished()
         switch_from_to(d->state, Running, Finished);
         d->waitCondition.wakeAll();
         d->sendCallOut(QFutureCallOutEvent(QFutureCallOutEvent::Finished));
+
+        // the continuation may report to other futures, don't hold the lock
+        std::function<void(const QFutureInterfaceBase &)> continuation;
+        continuation.swap(d->continuation);
+        locker.unlock();
+        if (continuation)
+            continuation(*this);
     }
 }
 
+/*
+    Sets the function to call with this interface when the future finishes,
+    replacing any previously set one. If the future has already finished,
+    the function is called right away.
+*/
+void QFutureInterfaceBase::setContinuation(std::function<void(const QFutureInterfaceBase &)> func)
+{
+    QMutexLocker locker(&d->m_mutex);
+    if (!isFinished()) {
+        d->continuation = std::move(func);
+        return;
+    }
+    locker.unlock();
+    func(*this);
+}
+
+/*
+    Returns true if a QFutureInterface<T> other than this one refers to the
+    results. Otherwise, a continuation called with this interface from
+    reportFinished() may move the results instead of copying them.
+*/
+bool QFutureInterfaceBase::hasSharedResults() const
+{
+    return d->refCount.loadT() > 1;
+}
+
 void QFutureInterfaceBase::setExpectedResultCount(int resultCount)
 {
     if (d->manualProgress == false)
@@ -604,4 +637,60 @@ void QFutureInterfaceBasePrivate::setState(QFutureInterfaceBase::State newState)
     state.store(newState);
 }
 
+namespace QtPrivate {
+
+namespace {
+class ContinuationRunnable : public QRunnable
+{
+public:
+    explicit ContinuationRunnable(std::function<void()> &&job)
+        : job(std::move(job))
+    { }
+
+    void run() override { job(); }
+
+private:
+    std::function<void()> job;
+};
+} // unnamed namespace
+
+ContinuationExecutor::ContinuationExecutor(QtFuture::Launch policy)
+    : kind(policy == QtFuture::Launch::Async ? ThreadPool : Inline),
+      pool(policy == QtFuture::Launch::Async ? QThreadPool::globalInstance() : nullptr)
+{
+}
+
+ContinuationExecutor::ContinuationExecutor(QThreadPool *pool)
+    : kind(ThreadPool), pool(pool)
+{
+}
+
+ContinuationExecutor::ContinuationExecutor(QObject *context)
+    : kind(EventLoop), pool(nullptr), context(context)
+{
+}
+
+/*
+    Runs the job, or schedules it to run. If the context object of an
+    executor running jobs in an event loop has been destroyed, the job is
+    destroyed without being run.
+*/
+void ContinuationExecutor::execute(std::function<void()> &&job) const
+{
+    switch (kind) {
+    case Inline:
+        job();
+        break;
+    case ThreadPool:
+        pool->start(new ContinuationRunnable(std::move(job)));
+        break;
+    case EventLoop:
+        if (QObject *object = context.data())
+            QMetaObject::invokeMethod(object, std::move(job), Qt::QueuedConnection);
+        break;
+    }
+}
+
+} // namespace QtPrivate
+
 QT_END_NAMESPACE
@@ -45,6 +45,8 @@
 #include <QtCore/qexception.h>
 #include <QtCore/qresultstore.h>
 
+#include <functional>
+
 QT_REQUIRE_CONFIG(future);
 
 QT_BEGIN_NAMESPACE
@@ -56,6 +58,10 @@ class QFutureInterfaceBasePrivate;
 class QFutureWatcherBase;
 class QFutureWatcherBasePrivate;
 
+namespace QtPrivate {
+class ContinuationBase;
+}
+
 class Q_CORE_EXPORT QFutureInterfaceBase
 {
 public:
@@ -139,6 +145,10 @@ private:
 private:
     friend class QFutureWatcherBase;
     friend class QFutureWatcherBasePrivate;
+    friend class QtPrivate::ContinuationBase;
+
+    void setContinuation(std::function<void(const QFutureInterfaceBase &)> func);
+    bool hasSharedResults() const;
 };
 
 template <typename T>
@@ -155,6 +165,11 @@ public:
     {
         refT();
     }
+    explicit QFutureInterface(const QFutureInterfaceBase &other)
+        : QFutureInterfaceBase(other)
+    {
+        refT();
+    }
     ~QFutureInterface()
     {
         if (!derefT())
@@ -177,7 +192,10 @@ public:
 
     inline void reportResult(const T *result, int index = -1);
     inline void reportResult(const T &result, int index = -1);
+    inline void reportAndMoveResult(T &&result, int index = -1);
     inline void reportResults(const QVector<T> &results, int beginIndex = -1, int count = -1);
+    inline T *reserveContiguousResults(int count);
+    inline void reportContiguousResults(int beginIndex, int count);
     inline void reportFinished(const T *result = 0);
 
     inline const T &resultReference(int index) const;
@@ -211,6 +229,26 @@ inline void QFutureInterface<T>::reportResult(const T &result, int index)
     reportResult(&result, index);
 }
 
+template <typename T>
+inline void QFutureInterface<T>::reportAndMoveResult(T &&result, int index)
+{
+    QMutexLocker locker(mutex());
+    if (this->queryState(Canceled) || this->queryState(Finished)) {
+        return;
+    }
+
+    QtPrivate::ResultStoreBase &store = resultStoreBase();
+
+    if (store.filterMode()) {
+        const int resultCountBefore = store.count();
+        store.moveResult<T>(index, std::move(result));
+        this->reportResultsReady(resultCountBefore, resultCountBefore + store.count());
+    } else {
+        const int insertIndex = store.moveResult<T>(index, std::move(result));
+        this->reportResultsReady(insertIndex, insertIndex + 1);
+    }
+}
+
 template <typename T>
 inline void QFutureInterface<T>::reportResults(const QVector<T> &_results, int beginIndex, int count)
 {
@@ -231,6 +269,25 @@ inline void QFutureInterface<T>::reportResults(const QVector<T> &_results, int b
     }
 }
 
+template <typename T>
+inline T *QFutureInterface<T>::reserveContiguousResults(int count)
+{
+    QMutexLocker locker(mutex());
+    return resultStoreBase().template reserveContiguousResults<T>(count);
+}
+
+template <typename T>
+inline void QFutureInterface<T>::reportContiguousResults(int beginIndex, int count)
+{
+    QMutexLocker locker(mutex());
+    if (this->queryState(Canceled) || this->queryState(Finished)) {
+        return;
+    }
+
+    const int insertIndex = resultStoreBase().template addContiguousResults<T>(beginIndex, count);
+    this->reportResultsReady(insertIndex, insertIndex + count);
+}
+
 template <typename T>
 inline void QFutureInterface<T>::reportFinished(const T *result)
 {
@@ -281,6 +338,9 @@ public:
     explicit QFutureInterface<void>(State initialState = NoState)
         : QFutureInterfaceBase(initialState)
     { }
+    explicit QFutureInterface<void>(const QFutureInterfaceBase &other)
+        : QFutureInterfaceBase(other)
+    { }
 
     static QFutureInterface<void> canceledResult()
     { return QFutureInterface(State(Started | Finished | Canceled)); }
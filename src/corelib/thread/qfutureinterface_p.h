@@ -174,6 +174,8 @@ public:
     QString m_progressText;
     QRunnable *runnable;
     QThreadPool *m_pool;
+    // called once when the future finishes, see setContinuation()
+    std::function<void(const QFutureInterfaceBase &)> continuation;
 
     inline QThreadPool *pool() const
     { return m_pool ? m_pool : QThreadPool::globalInstance(); }
@@ -461,6 +461,59 @@ bool QBasicMutex::isRecursive() const Q_DECL_NOTHROW
 
 */
 
+/*!
+    \internal
+    Returns whether a thread that found a lock held should spin for a while
+    before sleeping, which only pays off if the owner can run meanwhile.
+ */
+bool QLockBackoff::isSpinningUseful() Q_DECL_NOTHROW
+{
+    static const bool useful = QThread::idealThreadCount() > 1;
+    return useful;
+}
+
+#ifdef Q_COMPILER_THREAD_LOCAL
+// the number of pauses that got this thread the locks it spun for lately
+static thread_local int lockBackoffEstimate = QLockBackoff::MaxSpinLimit / 4;
+#endif
+
+/*!
+    \internal
+    Sets up the spinning budget of a thread that found a lock held. If \a
+    timeout is not negative, spinning stops after that many milliseconds.
+ */
+QLockBackoff::QLockBackoff(int timeout) Q_DECL_NOTHROW
+    : timeout(timeout), spinLimit(0), pauseCount(1), spinCount(0), exhausted(false)
+{
+    if (timeout > 0)
+        timer.start();
+    if (!isSpinningUseful())
+        return;
+#ifdef Q_COMPILER_THREAD_LOCAL
+    spinLimit = qMin(2 * lockBackoffEstimate + int(MinSpinLimit), int(MaxSpinLimit));
+#else
+    spinLimit = MaxSpinLimit / 2;
+#endif
+}
+
+/*!
+    \internal
+    Feeds the outcome of the spinning into the estimate for the next lock:
+    moves it towards the spinning that was needed if the lock was acquired,
+    halves it if the whole budget was spent in vain.
+ */
+QLockBackoff::~QLockBackoff()
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    if (!spinLimit)
+        return;
+    if (exhausted)
+        lockBackoffEstimate /= 2;
+    else if (spinCount)
+        lockBackoffEstimate += (spinCount - lockBackoffEstimate) / 8;
+#endif
+}
+
 #ifndef QT_LINUX_FUTEX //linux implementation is in qmutex_linux.cpp
 
 /*
@@ -498,6 +551,8 @@ bool QBasicMutex::lockInternal(int timeout) QT_MUTEX_LOCK_NOEXCEPT
 {
     Q_ASSERT(!isRecursive());
 
+    // spin a little before sleeping, but only for part of the timeout
+    QLockBackoff backoff(timeout);
     while (!fastTryLock()) {
         QMutexData *copy = d_ptr.loadAcquire();
         if (!copy) // if d is 0, the mutex is unlocked
@@ -506,6 +561,13 @@ bool QBasicMutex::lockInternal(int timeout) QT_MUTEX_LOCK_NOEXCEPT
         if (copy == dummyLocked()) {
             if (timeout == 0)
                 return false;
+            // The mutex is locked, but maybe only briefly: spin a little
+            // before allocating the QMutexPrivate to sleep on.
+            while (copy == dummyLocked() && backoff.spin())
+                copy = d_ptr.loadAcquire();
+            if (copy != dummyLocked())
+                continue;
+
             // The mutex is locked but does not have a QMutexPrivate yet.
             // we need to allocate a QMutexPrivate
             QMutexPrivate *newD = QMutexPrivate::allocate();
@@ -572,7 +634,7 @@ bool QBasicMutex::lockInternal(int timeout) QT_MUTEX_LOCK_NOEXCEPT
             continue;
         }
 
-        if (d->wait(timeout)) {
+        if (d->wait(backoff.remainingTime())) {
             // reset the possiblyUnlocked flag if needed (and deref its corresponding reference)
             if (d->possiblyUnlocked.load() && d->possiblyUnlocked.testAndSetRelaxed(true, false))
                 d->deref();
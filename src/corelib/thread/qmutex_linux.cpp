@@ -78,7 +78,12 @@ using namespace QtFutex;
  *
  * If that testAndSetAcquire fails, QBasicMutex::lockInternal is called.
  *
- * lockInternal will examine the value of the pointer. Otherwise, it will use
+ * lockInternal will first spin for a short while (see QLockBackoff), trying
+ * again to go from 0x0 to 0x1, as long as no other thread is sleeping on the
+ * mutex already. Critical sections are usually short, so this saves the
+ * syscalls to sleep and to wake up.
+ *
+ * lockInternal will then examine the value of the pointer. Otherwise, it will use
  * futexes to sleep and wait for another thread to unlock. To do that, it needs
  * to set a pointer value of 0x3, which indicates that thread is waiting. It
  * does that by a simple fetchAndStoreAcquire operation.
@@ -103,6 +108,12 @@ using namespace QtFutex;
  * waiting in the past. We then set the mutex to 0x0 and perform a FUTEX_WAKE.
  */
 
+static inline QMutexData *dummyLockedValue()
+{
+    // same as QBasicMutex::dummyLocked()
+    return reinterpret_cast<QMutexData *>(quintptr(1));
+}
+
 static inline QMutexData *dummyFutexValue()
 {
     return reinterpret_cast<QMutexData *>(quintptr(3));
@@ -118,12 +129,29 @@ bool lockInternal_helper(QBasicAtomicPointer<QMutexData> &d_ptr, int timeout = -
     if (timeout == 0)
         return false;
 
+    // the mutex is probably held only briefly, so spin for a while as long as
+    // nobody is sleeping on it yet, but never for longer than the timeout
+    QLockBackoff backoff(timeout);
+    while (backoff.spin()) {
+        QMutexData *d = d_ptr.load();
+        if (d == nullptr && d_ptr.testAndSetAcquire(nullptr, dummyLockedValue()))
+            return true;
+        if (d == dummyFutexValue())
+            break;
+    }
+
     // the mutex is locked already, set a bit indicating we're waiting
     if (d_ptr.fetchAndStoreAcquire(dummyFutexValue()) == nullptr)
         return true;
 
     qint64 nstimeout = timeout * Q_INT64_C(1000) * 1000;
     qint64 remainingTime = nstimeout;
+    if (IsTimed && nstimeout > 0) {
+        // don't sleep for the part of the timeout already spent spinning
+        remainingTime = nstimeout - elapsedTimer->nsecsElapsed();
+        if (remainingTime <= 0)
+            return false;
+    }
     forever {
         // successfully set the waiting bit, now sleep
         if (IsTimed && nstimeout >= 0) {
@@ -58,6 +58,11 @@
 #include <QtCore/qnamespace.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qatomic.h>
+#include <QtCore/qelapsedtimer.h>
+
+#if defined(Q_CC_MSVC) && defined(Q_PROCESSOR_X86)
+# include <intrin.h>
+#endif
 
 #if defined(Q_OS_MAC)
 # include <mach/semaphore.h>
@@ -83,6 +88,73 @@ public:
         : recursive(mode == QMutex::Recursive) {}
 };
 
+// Bounded exponential backoff for a thread that found a lock held, used
+// before it goes to sleep in the kernel: short critical sections are usually
+// over within a few hundred cycles, much less than the cost of a syscall. The
+// kernel does not tell us whether the owner is running, but on a single
+// processor it cannot be while we spin, so there we don't spin at all.
+//
+// The spinning budget adapts to how long the locks a thread meets are held:
+// each thread keeps an estimate of the spinning that last got it a lock, and
+// decays it whenever spinning was in vain, so that long critical sections
+// quickly stop costing CPU time. A timed attempt never spins longer than its
+// timeout; remainingTime() then tells how much of it is left for sleeping.
+class QLockBackoff
+{
+public:
+    enum { MaxPauseCount = 64, MinSpinLimit = 64, MaxSpinLimit = 4096 };
+
+    explicit QLockBackoff(int timeout = -1) Q_DECL_NOTHROW;
+    ~QLockBackoff();
+
+    // Pauses the CPU for a while; returns false when the spinning budget or
+    // the timeout is exhausted and the caller should sleep instead.
+    bool spin() Q_DECL_NOTHROW
+    {
+        if (spinCount >= spinLimit) {
+            exhausted = true;
+            return false;
+        }
+        if (timeout > 0 && timer.hasExpired(timeout))
+            return false;
+        for (int i = 0; i < pauseCount; ++i)
+            cpuRelax();
+        spinCount += pauseCount;
+        pauseCount = qMin(2 * pauseCount, int(MaxPauseCount));
+        return true;
+    }
+
+    // Returns the part of the timeout given to the constructor that has not
+    // been spent spinning, in milliseconds, or -1 if there is no timeout.
+    int remainingTime() const Q_DECL_NOTHROW
+    {
+        if (timeout <= 0)
+            return timeout;
+        return int(qMax(qint64(0), timeout - timer.elapsed()));
+    }
+
+    static bool isSpinningUseful() Q_DECL_NOTHROW;
+
+private:
+    static inline void cpuRelax() Q_DECL_NOTHROW
+    {
+#if defined(Q_PROCESSOR_X86) && defined(Q_CC_GNU)
+        __builtin_ia32_pause();
+#elif defined(Q_PROCESSOR_X86) && defined(Q_CC_MSVC)
+        _mm_pause();
+#elif (defined(Q_PROCESSOR_ARM_64) || (defined(Q_PROCESSOR_ARM) && Q_PROCESSOR_ARM >= 7)) && defined(Q_CC_GNU)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
+    QElapsedTimer timer;
+    int timeout;
+    int spinLimit;
+    int pauseCount;
+    int spinCount;
+    bool exhausted;
+};
+
 #if !defined(QT_LINUX_FUTEX)
 class QMutexPrivate : public QMutexData
 {
@@ -47,11 +47,15 @@
 #include "qthread.h"
 #include "qwaitcondition.h"
 #include "qreadwritelock_p.h"
+#include "qmutex_p.h"
 #include "qelapsedtimer.h"
 #include "private/qfreelist_p.h"
+#include "private/qfutex_p.h"
 
 QT_BEGIN_NAMESPACE
 
+using namespace QtFutex;
+
 /*
  * Implementation details of QReadWriteLock:
  *
@@ -61,7 +65,18 @@ QT_BEGIN_NAMESPACE
  *    In that case, d_ptr>>4 represents the number of reading threads minus 1. No writers
  *    are waiting, and the lock is not recursive.
  *  - when d_ptr == 0x2: We are locked for write and nobody is waiting. (no contention)
+ *  - when d_ptr == 0x3: We are locked for write and only readers are waiting, sleeping
+ *    on a futex on d_ptr itself. Only used where futexes are available.
  *  - In any other case, d_ptr points to an actual QReadWriteLockPrivate.
+ *
+ * A thread that finds the lock held in one of the uncontended states spins for a short,
+ * bounded time (see QLockBackoff) before it blocks: most critical sections are short
+ * enough that the lock is released meanwhile. A reader that still finds a writer then
+ * sets 0x3 and waits on the futex, so the common case of readers waiting for a single
+ * writer needs neither a QReadWriteLockPrivate nor its mutex. Whoever changes d_ptr
+ * away from 0x3 (the writer unlocking, or a second writer allocating the
+ * QReadWriteLockPrivate to wait on) wakes them all up, and they retry from scratch.
+ * Any other contention goes through a QReadWriteLockPrivate as before.
  */
 
 namespace {
@@ -69,9 +84,12 @@ enum {
     StateMask = 0x3,
     StateLockedForRead = 0x1,
     StateLockedForWrite = 0x2,
+    StateLockedForWriteReadersWaiting = 0x3,
 };
 const auto dummyLockedForRead = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForRead));
 const auto dummyLockedForWrite = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForWrite));
+const auto dummyLockedForWriteReadersWaiting =
+        reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForWriteReadersWaiting));
 inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
 { return quintptr(d) & StateMask; }
 }
@@ -226,6 +244,7 @@ bool QReadWriteLock::tryLockForRead(int timeout)
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
         return true;
 
+    QLockBackoff backoff(timeout);
     while (true) {
         if (d == 0) {
             if (!d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
@@ -243,10 +262,33 @@ bool QReadWriteLock::tryLockForRead(int timeout)
             return true;
         }
 
-        if (d == dummyLockedForWrite) {
+        if (d == dummyLockedForWrite || d == dummyLockedForWriteReadersWaiting) {
             if (!timeout)
                 return false;
 
+            // the writer might be about to unlock, spin a bit before blocking
+            if (backoff.spin()) {
+                d = d_ptr.loadAcquire();
+                continue;
+            }
+
+            if (futexAvailable()) {
+                // tell the writer that readers are waiting and sleep until it unlocks
+                if (d == dummyLockedForWrite
+                        && !d_ptr.testAndSetRelaxed(d, dummyLockedForWriteReadersWaiting, d)) {
+                    continue;
+                }
+                const int remainingTime = backoff.remainingTime();
+                if (remainingTime < 0)
+                    futexWait(d_ptr, dummyLockedForWriteReadersWaiting);
+                else if (!remainingTime
+                         || !futexWait(d_ptr, dummyLockedForWriteReadersWaiting,
+                                       remainingTime * Q_INT64_C(1000) * 1000))
+                    return false;
+                d = d_ptr.loadAcquire();
+                continue;
+            }
+
             // locked for write, assign a d_ptr and wait.
             auto val = QReadWriteLockPrivate::allocate();
             val->writerCount = 1;
@@ -261,7 +303,7 @@ bool QReadWriteLock::tryLockForRead(int timeout)
         // d is an actual pointer;
 
         if (d->recursive)
-            return d->recursiveLockForRead(timeout);
+            return d->recursiveLockForRead(backoff.remainingTime());
 
         QMutexLocker lock(&d->mutex);
         if (d != d_ptr.load()) {
@@ -274,7 +316,7 @@ bool QReadWriteLock::tryLockForRead(int timeout)
             d = d_ptr.loadAcquire();
             continue;
         }
-        return d->lockForRead(timeout);
+        return d->lockForRead(backoff.remainingTime());
     }
 }
 
@@ -340,6 +382,7 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite, d))
         return true;
 
+    QLockBackoff backoff(timeout);
     while (true) {
         if (d == 0) {
             if (!d_ptr.testAndSetAcquire(d, dummyLockedForWrite, d))
@@ -351,9 +394,15 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
             if (!timeout)
                 return false;
 
+            // the readers or the writer might be about to unlock, spin a bit before blocking
+            if (backoff.spin()) {
+                d = d_ptr.loadAcquire();
+                continue;
+            }
+
             // locked for either read or write, assign a d_ptr and wait.
             auto val = QReadWriteLockPrivate::allocate();
-            if (d == dummyLockedForWrite)
+            if (d == dummyLockedForWrite || d == dummyLockedForWriteReadersWaiting)
                 val->writerCount = 1;
             else
                 val->readerCount = (quintptr(d) >> 4) + 1;
@@ -362,13 +411,16 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
                 val->release();
                 continue;
             }
+            // the readers sleeping on the futex must now wait on val instead
+            if (d == dummyLockedForWriteReadersWaiting)
+                futexWakeAll(d_ptr);
             d = val;
         }
         Q_ASSERT(!isUncontendedLocked(d));
         // d is an actual pointer;
 
         if (d->recursive)
-            return d->recursiveLockForWrite(timeout);
+            return d->recursiveLockForWrite(backoff.remainingTime());
 
         QMutexLocker lock(&d->mutex);
         if (d != d_ptr.load()) {
@@ -378,7 +430,7 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
             d = d_ptr.loadAcquire();
             continue;
         }
-        return d->lockForWrite(timeout);
+        return d->lockForWrite(backoff.remainingTime());
     }
 }
 
@@ -403,6 +455,14 @@ void QReadWriteLock::unlock()
             return;
         }
 
+        if (d == dummyLockedForWriteReadersWaiting) {
+            // readers are sleeping on the futex, wake them all up
+            if (!d_ptr.testAndSetOrdered(d, nullptr, d))
+                continue;
+            futexWakeAll(d_ptr);
+            return;
+        }
+
         if ((quintptr(d) & StateMask) == StateLockedForRead) {
             Q_ASSERT(quintptr(d) > (1U<<4)); //otherwise that would be the fast case
             // Just decrease the reader's count.
@@ -449,6 +509,7 @@ QReadWriteLock::StateForWaitCondition QReadWriteLock::stateForWaitCondition() co
     switch (quintptr(d) & StateMask) {
     case StateLockedForRead: return LockedForRead;
     case StateLockedForWrite: return LockedForWrite;
+    case StateLockedForWriteReadersWaiting: return LockedForWrite;
     }
 
     if (!d)
@@ -94,12 +94,14 @@ bool ResultIteratorBase::canIncrementVectorIndex() const
 }
 
 ResultStoreBase::ResultStoreBase()
-    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0) { }
+    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0),
+      m_contiguousResults(nullptr) { }
 
 ResultStoreBase::~ResultStoreBase()
 {
     // QFutureInterface's dtor must delete the contents of m_results.
     Q_ASSERT(m_results.isEmpty());
+    Q_ASSERT(!m_contiguousResults);
 }
 
 void ResultStoreBase::setFilterMode(bool enable)
@@ -182,6 +184,15 @@ int ResultStoreBase::addResults(int index, const void *results, int vectorSize,
     }
 }
 
+// results points into the storage returned by reserveContiguousResults(),
+// where the producer has already constructed the results in place.
+int ResultStoreBase::addContiguousResults(int index, const void *results, int count)
+{
+    Q_ASSERT(!m_filterMode);
+    ResultItem resultItem(results, count, true);
+    return insertResultItem(index, resultItem);
+}
+
 ResultIteratorBase ResultStoreBase::begin() const
 {
     return ResultIteratorBase(m_results.begin());
@@ -63,14 +63,17 @@ namespace QtPrivate {
 class ResultItem
 {
 public:
-    ResultItem(const void *_result, int _count) : m_count(_count), result(_result) { } // contruct with vector of results
-    ResultItem(const void *_result) : m_count(0), result(_result) { } // construct with result
-    ResultItem() : m_count(0), result(nullptr) { }
+    ResultItem(const void *_result, int _count) : m_count(_count), result(_result), m_contiguous(false) { } // contruct with vector of results
+    ResultItem(const void *_result, int _count, bool _contiguous) : m_count(_count), result(_result), m_contiguous(_contiguous) { } // construct with a span of the contiguous results
+    ResultItem(const void *_result) : m_count(0), result(_result), m_contiguous(false) { } // construct with result
+    ResultItem() : m_count(0), result(nullptr), m_contiguous(false) { }
     bool isValid() const { return result != nullptr; }
     bool isVector() const { return m_count != 0; }
+    bool isContiguous() const { return m_contiguous; }
     int count() const { return (m_count == 0) ?  1 : m_count; }
     int m_count;          // result is either a pointer to a result or to a vector of results,
     const void *result; // if count is 0 it's a result, otherwise it's a vector.
+    bool m_contiguous;  // if set, result points to the first of m_count results in an array
 };
 
 class Q_CORE_EXPORT ResultIteratorBase
@@ -101,7 +104,9 @@ public:
     template <typename T>
     const T *pointer() const
     {
-        if (mapIterator.value().isVector())
+        if (mapIterator.value().isContiguous())
+            return reinterpret_cast<const T *>(mapIterator.value().result) + m_vectorIndex;
+        else if (mapIterator.value().isVector())
             return &(reinterpret_cast<const QVector<T> *>(mapIterator.value().result)->at(m_vectorIndex));
         else
             return reinterpret_cast<const T *>(mapIterator.value().result);
@@ -116,6 +121,7 @@ public:
     bool filterMode() const;
     int addResult(int index, const void *result);
     int addResults(int index, const void *results, int vectorSize, int logicalCount);
+    int addContiguousResults(int index, const void *results, int count);
     ResultIteratorBase begin() const;
     ResultIteratorBase end() const;
     bool hasNextResult() const;
@@ -139,6 +145,8 @@ protected:
     QMap<int, ResultItem> pendingResults;
     int filteredResults;
 
+    void *m_contiguousResults; // preallocated storage for all results, if reserved
+
 public:
     template <typename T>
     int addResult(int index, const T *result)
@@ -149,6 +157,12 @@ public:
             return addResult(index, static_cast<void *>(new T(*result)));
     }
 
+    template <typename T>
+    int moveResult(int index, T &&result)
+    {
+        return addResult(index, static_cast<void *>(new T(std::move(result))));
+    }
+
     template <typename T>
     int addResults(int index, const QVector<T> *results)
     {
@@ -164,6 +178,24 @@ public:
             return addResults(index, new QVector<T>(*results), results->count(), totalCount);
     }
 
+    // Preallocates storage for the results 0 to count - 1, which the producer
+    // then constructs in place and publishes with addContiguousResults().
+    template <typename T>
+    T *reserveContiguousResults(int count)
+    {
+        Q_ASSERT(!m_contiguousResults && m_results.isEmpty() && !m_filterMode);
+        T *results = new T[count];
+        m_contiguousResults = results;
+        return results;
+    }
+
+    template <typename T>
+    int addContiguousResults(int index, int count)
+    {
+        Q_ASSERT(m_contiguousResults);
+        return addContiguousResults(index, static_cast<T *>(m_contiguousResults) + index, count);
+    }
+
     int addCanceledResult(int index)
     {
         return addResult(index, static_cast<void *>(nullptr));
@@ -181,12 +213,17 @@ public:
     {
         QMap<int, ResultItem>::const_iterator mapIterator = m_results.constBegin();
         while (mapIterator != m_results.constEnd()) {
-            if (mapIterator.value().isVector())
-                delete reinterpret_cast<const QVector<T> *>(mapIterator.value().result);
-            else
-                delete reinterpret_cast<const T *>(mapIterator.value().result);
+            // spans of the contiguous results are deleted below, all at once
+            if (mapIterator.value().isContiguous() == false) {
+                if (mapIterator.value().isVector())
+                    delete reinterpret_cast<const QVector<T> *>(mapIterator.value().result);
+                else
+                    delete reinterpret_cast<const T *>(mapIterator.value().result);
+            }
             ++mapIterator;
         }
+        delete [] static_cast<T *>(m_contiguousResults);
+        m_contiguousResults = nullptr;
         resultCount = 0;
         m_results.clear();
     }
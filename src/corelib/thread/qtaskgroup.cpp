@@ -0,0 +1,398 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qtaskgroup.h"
+
+#ifndef QT_NO_THREAD
+
+#include "qdeadlinetimer.h"
+#include "qmutex.h"
+#include "qthreadpool.h"
+#include "qvector.h"
+#include "qwaitcondition.h"
+#include "qthreadpool_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class QTaskGroupRunnable;
+
+class QTaskGroupPrivate
+{
+public:
+    explicit QTaskGroupPrivate(QThreadPool *threadPool)
+        : pool(threadPool)
+    { }
+
+    void start(QRunnable *runnable, int priority);
+    void cancel();
+    bool wait(int msecs);
+    void taskFinished();
+
+    static void releaseRunnable(QRunnable *runnable);
+
+    QThreadPool *pool;
+    mutable QMutex mutex;
+    QWaitCondition changed;
+    // tasks handed to the pool that no thread has picked up yet
+    QVector<QTaskGroupRunnable *> queued;
+    int pendingTasks = 0;
+    int waitingThreads = 0;
+    QAtomicInt canceled;
+};
+
+/*
+    Wraps every runnable started in a group, so that the group knows when a
+    thread picks it up and when it is finished.
+*/
+class QTaskGroupRunnable : public QRunnable
+{
+public:
+    QTaskGroupRunnable(QTaskGroupPrivate *g, QRunnable *r)
+        : group(g), task(r)
+    { }
+
+    void run() override;
+    void execute(bool runTask);
+
+    QTaskGroupPrivate *group;
+    QRunnable *task;
+};
+
+void QTaskGroupRunnable::run()
+{
+    {
+        QMutexLocker locker(&group->mutex);
+        group->queued.removeOne(this);
+    }
+    execute(!group->canceled.loadAcquire());
+}
+
+/*
+    Runs the wrapped task unless \a runTask is false, then releases it and
+    reports it finished to the group, also if the task throws.
+*/
+void QTaskGroupRunnable::execute(bool runTask)
+{
+    struct Finisher
+    {
+        QTaskGroupRunnable *self;
+        ~Finisher()
+        {
+            QTaskGroupPrivate::releaseRunnable(self->task);
+            self->group->taskFinished();
+        }
+    } finisher = { this };
+
+    if (runTask)
+        task->run();
+}
+
+// same ownership rules as QThreadPool::start()
+void QTaskGroupPrivate::releaseRunnable(QRunnable *runnable)
+{
+    if (runnable->autoDelete() && !runnable->ref.deref())
+        delete runnable;
+}
+
+void QTaskGroupPrivate::start(QRunnable *runnable, int priority)
+{
+    if (runnable->autoDelete())
+        runnable->ref.ref();
+
+    if (canceled.loadAcquire()) {
+        releaseRunnable(runnable);
+        return;
+    }
+
+    QTaskGroupRunnable *task = new QTaskGroupRunnable(this, runnable);
+    // Keep the mutex locked until the pool has the task, so that a task in
+    // the queued list can always be taken back with tryTake().
+    QMutexLocker locker(&mutex);
+    ++pendingTasks;
+    queued.append(task);
+    pool->start(task, priority);
+    if (waitingThreads)
+        changed.wakeAll();
+}
+
+void QTaskGroupPrivate::taskFinished()
+{
+    QMutexLocker locker(&mutex);
+    if (--pendingTasks == 0)
+        changed.wakeAll();
+}
+
+void QTaskGroupPrivate::cancel()
+{
+    canceled.storeRelease(1);
+
+    // Take the tasks that no thread picked up yet back from the pool; those
+    // that have been picked up in the meantime skip the task themselves.
+    QVector<QTaskGroupRunnable *> taken;
+    {
+        QMutexLocker locker(&mutex);
+        for (QTaskGroupRunnable *task : qAsConst(queued)) {
+            if (pool->tryTake(task))
+                taken.append(task);
+        }
+        queued.clear();
+    }
+    for (QTaskGroupRunnable *task : qAsConst(taken)) {
+        task->execute(false);
+        delete task;
+    }
+}
+
+bool QTaskGroupPrivate::wait(int msecs)
+{
+    QDeadlineTimer deadline(msecs);
+    bool releasedThread = false;
+
+    QMutexLocker locker(&mutex);
+    while (pendingTasks > 0) {
+        if (!queued.isEmpty()) {
+            // Run a task of this group here instead of blocking. The most
+            // recently started one is the most likely to be needed next,
+            // e.g. when tasks themselves start and wait for sub-tasks.
+            QTaskGroupRunnable *task = queued.takeLast();
+            if (pool->tryTake(task)) {
+                locker.unlock();
+                task->execute(!canceled.loadAcquire());
+                delete task;
+                locker.relock();
+            }
+            continue;
+        }
+
+        if (deadline.hasExpired())
+            break;
+
+        // All remaining tasks run in other threads. If we are one of the
+        // pool's threads, let the pool start another one while we block.
+        if (!releasedThread && pool->d_func()->isPoolThread()) {
+            pool->releaseThread();
+            releasedThread = true;
+        }
+
+        const qint64 remaining = deadline.remainingTime();
+        ++waitingThreads;
+        changed.wait(&mutex, remaining < 0 ? ULONG_MAX : static_cast<unsigned long>(remaining));
+        --waitingThreads;
+    }
+    const bool finished = pendingTasks == 0;
+    locker.unlock();
+
+    if (releasedThread)
+        pool->reserveThread();
+    return finished;
+}
+
+/*!
+    \class QCancellationToken
+    \inmodule QtCore
+    \since 5.12
+    \brief The QCancellationToken class lets a task check whether it has been canceled.
+
+    \threadsafe
+
+    \ingroup thread
+
+    A QCancellationToken is obtained from a QTaskGroup and passed to the
+    functions started in the group. Long running tasks should call
+    isCanceled() from time to time and return early once it returns \c true.
+
+    A token is only valid as long as the QTaskGroup it was obtained from
+    exists. A default-constructed token is never canceled.
+
+    \sa QTaskGroup::cancel()
+*/
+
+/*!
+    \fn QCancellationToken::QCancellationToken()
+
+    Constructs a token that is never canceled.
+*/
+
+/*!
+    \fn bool QCancellationToken::isCanceled() const
+
+    Returns \c true if the task group this token belongs to has been
+    canceled; otherwise returns \c false.
+*/
+
+/*!
+    \class QTaskGroup
+    \inmodule QtCore
+    \since 5.12
+    \brief The QTaskGroup class runs a group of related tasks in a QThreadPool.
+
+    \threadsafe
+
+    \ingroup thread
+
+    QThreadPool::waitForDone() waits for every runnable in the pool. A
+    QTaskGroup instead tracks only the tasks started through it, so that
+    independent parts of a program can share a pool and still wait for, or
+    cancel, just their own work:
+
+    \snippet code/src_corelib_thread_qtaskgroup.cpp 0
+
+    Tasks are either QRunnable objects or functions. A function started with
+    start() may take a QCancellationToken argument; it should check it
+    regularly and return early after cancel() has been called. Tasks that
+    have not started running when the group is canceled are not run at all.
+
+    wait() does not just block: while tasks of the group are still queued in
+    the pool, the waiting thread takes them out of the queue and runs them
+    itself. This makes it safe for a task to start sub-tasks in the same
+    pool and wait for them (nested fork/join) without tying up more threads
+    than the pool allows, and without deadlocking when all of the pool's
+    threads are waiting. When a pool thread has to block because the
+    remaining tasks are running elsewhere, the pool may start another thread
+    in the meantime, as if releaseThread() had been called.
+
+    The destructor waits for all tasks of the group to finish.
+
+    \sa QThreadPool, QCancellationToken
+*/
+
+/*!
+    Constructs a task group that starts its tasks in \a pool. If \a pool is
+    \c nullptr, QThreadPool::globalInstance() is used.
+*/
+QTaskGroup::QTaskGroup(QThreadPool *pool)
+    : d(new QTaskGroupPrivate(pool ? pool : QThreadPool::globalInstance()))
+{
+}
+
+/*!
+    Waits for all tasks of the group to finish, then destroys the group.
+    Call cancel() first to skip the tasks that have not started yet.
+*/
+QTaskGroup::~QTaskGroup()
+{
+    d->wait(-1);
+    delete d;
+}
+
+/*!
+    Returns the thread pool the group starts its tasks in.
+*/
+QThreadPool *QTaskGroup::threadPool() const
+{
+    return d->pool;
+}
+
+/*!
+    Starts \a runnable in the group's thread pool with the given \a priority.
+
+    As with QThreadPool::start(), the runnable is deleted after it has run
+    if \l{QRunnable::autoDelete()}{runnable->autoDelete()} returns \c true.
+    If the group has been canceled, the runnable is not run.
+*/
+void QTaskGroup::start(QRunnable *runnable, int priority)
+{
+    if (runnable)
+        d->start(runnable, priority);
+}
+
+/*!
+    \fn template <typename Function> void QTaskGroup::start(Function function, int priority)
+    \overload
+
+    Starts \a function in the group's thread pool with the given \a priority.
+    The function is called either with a QCancellationToken for this group
+    or without arguments, depending on which it accepts.
+*/
+
+/*!
+    Cancels the group. Tasks that have not started yet are removed from the
+    thread pool without being run, and the cancellation tokens of the group
+    report that it was canceled, so that running tasks can return early.
+    Tasks started after this call are not run either.
+
+    This function does not wait for the running tasks; call wait() for that.
+*/
+void QTaskGroup::cancel()
+{
+    d->cancel();
+}
+
+/*!
+    Returns \c true if cancel() has been called; otherwise returns \c false.
+*/
+bool QTaskGroup::isCanceled() const
+{
+    return d->canceled.loadAcquire() != 0;
+}
+
+/*!
+    Returns a token that tasks can use to find out whether the group has
+    been canceled. The token must not be used after the group is destroyed.
+*/
+QCancellationToken QTaskGroup::cancellationToken() const
+{
+    return QCancellationToken(&d->canceled);
+}
+
+/*!
+    Returns the number of tasks of the group that have been started and have
+    not finished yet.
+*/
+int QTaskGroup::pendingTaskCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->pendingTasks;
+}
+
+/*!
+    Waits up to \a msecs milliseconds for all tasks of the group to finish,
+    running queued tasks of the group in the calling thread in the meantime.
+    Returns \c true if all tasks finished; otherwise returns \c false. If
+    \a msecs is -1 (the default), the timeout is ignored.
+*/
+bool QTaskGroup::wait(int msecs)
+{
+    return d->wait(msecs);
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_THREAD
@@ -0,0 +1,142 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTASKGROUP_H
+#define QTASKGROUP_H
+
+#include <QtCore/qglobal.h>
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qrunnable.h>
+
+#include <type_traits>
+#include <utility>
+
+#ifndef QT_NO_THREAD
+
+QT_BEGIN_NAMESPACE
+
+
+class QThreadPool;
+class QTaskGroupPrivate;
+
+class QCancellationToken
+{
+public:
+    Q_DECL_CONSTEXPR QCancellationToken() Q_DECL_NOTHROW : flag(nullptr) { }
+
+    bool isCanceled() const Q_DECL_NOTHROW
+    { return flag && flag->loadAcquire() != 0; }
+
+private:
+    friend class QTaskGroup;
+    explicit Q_DECL_CONSTEXPR QCancellationToken(const QAtomicInt *f) Q_DECL_NOTHROW : flag(f) { }
+
+    const QAtomicInt *flag;
+};
+Q_DECLARE_TYPEINFO(QCancellationToken, Q_PRIMITIVE_TYPE);
+
+namespace QtPrivate {
+
+template <typename Function>
+class TaskGroupFunctionRunnable : public QRunnable
+{
+public:
+    TaskGroupFunctionRunnable(Function &&f, QCancellationToken t)
+        : function(std::move(f)), token(t)
+    { }
+
+    void run() override
+    { invoke(function, token, 0); }
+
+private:
+    // prefer calling the function with the token if it accepts one
+    template <typename F>
+    static auto invoke(F &f, const QCancellationToken &t, int) -> decltype(f(t), void())
+    { f(t); }
+    template <typename F>
+    static void invoke(F &f, const QCancellationToken &, long)
+    { f(); }
+
+    Function function;
+    QCancellationToken token;
+};
+
+} // namespace QtPrivate
+
+class Q_CORE_EXPORT QTaskGroup
+{
+public:
+    explicit QTaskGroup(QThreadPool *pool = nullptr);
+    ~QTaskGroup();
+
+    QThreadPool *threadPool() const;
+
+    void start(QRunnable *runnable, int priority = 0);
+#ifdef Q_QDOC
+    template <typename Function>
+    void start(Function function, int priority = 0);
+#else
+    template <typename Function>
+    typename std::enable_if<!std::is_convertible<Function, QRunnable *>::value>::type
+    start(Function function, int priority = 0)
+    {
+        start(new QtPrivate::TaskGroupFunctionRunnable<Function>(std::move(function), cancellationToken()),
+              priority);
+    }
+#endif
+
+    void cancel();
+    bool isCanceled() const;
+    QCancellationToken cancellationToken() const;
+
+    int pendingTaskCount() const;
+    bool wait(int msecs = -1);
+
+private:
+    Q_DISABLE_COPY(QTaskGroup)
+    QTaskGroupPrivate *d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_THREAD
+
+#endif // QTASKGROUP_H
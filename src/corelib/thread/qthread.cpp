@@ -51,6 +51,219 @@
 
 QT_BEGIN_NAMESPACE
 
+/*
+  QPostEventQueue
+*/
+
+QPostEventQueue::QPostEventQueue()
+    : enqueuePos(0), dequeuePos(0)
+{
+    for (uint i = 0; i < Size; ++i)
+        cells[i].sequence.store(i);
+}
+
+/*
+    Claims the next free cell and writes the event into it. Returns \c false
+    if the queue is full.
+*/
+bool QPostEventQueue::push(QObject *receiver, QEvent *event)
+{
+    uint pos = enqueuePos.load();
+    Cell *cell;
+    for (;;) {
+        cell = &cells[pos % Size];
+        const int diff = int(cell->sequence.loadAcquire() - pos);
+        if (diff == 0) {
+            if (enqueuePos.testAndSetRelaxed(pos, pos + 1, pos))
+                break;
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueuePos.load();
+        }
+    }
+    cell->receiver = receiver;
+    cell->event = event;
+    cell->sequence.storeRelease(pos + 1);
+    return true;
+}
+
+/*
+    Takes the oldest event out of the queue. If its cell was claimed but not
+    written yet, waits for the pushing thread to finish, so that events are
+    never reordered. Must be called with QPostEventList::mutex held.
+*/
+bool QPostEventQueue::pop(QPostEvent *pe)
+{
+    const uint pos = dequeuePos.load();
+    if (pos == enqueuePos.loadAcquire())
+        return false;
+    Cell *cell = &cells[pos % Size];
+    while (int(cell->sequence.loadAcquire() - (pos + 1)) < 0) {
+#ifndef QT_NO_THREAD
+        QThread::yieldCurrentThread();
+#endif
+    }
+    *pe = QPostEvent(cell->receiver, cell->event, Qt::NormalEventPriority);
+    cell->sequence.storeRelease(pos + Size);
+    dequeuePos.store(pos + 1);
+    return true;
+}
+
+/*
+  QDeferredDeleteList
+*/
+
+void QDeferredDeleteList::add(QObject *object, int level)
+{
+    QObjectPrivate *d = QObjectPrivate::get(object);
+    Q_ASSERT(d->deferredDeleteIndex < 0);
+    d->deferredDeleteIndex = entries.size();
+    const Entry entry = { object, level, postedMarkers };
+    entries.append(entry);
+    ++objects;
+}
+
+/*
+    Clears the entry at \a i and returns the object it held, or \c nullptr if
+    the entry was removed already.
+*/
+QObject *QDeferredDeleteList::take(int i)
+{
+    QObject *object = entries.at(i).object;
+    if (object) {
+        QObjectPrivate::get(object)->deferredDeleteIndex = -1;
+        entries[i].object = nullptr;
+        --objects;
+        while (head < entries.size() && !entries.at(head).object)
+            ++head;
+    }
+    return object;
+}
+
+void QDeferredDeleteList::remove(QObject *object)
+{
+    const int i = QObjectPrivate::get(object)->deferredDeleteIndex;
+    if (i >= 0) {
+        Q_ASSERT(entries.at(i).object == object);
+        take(i);
+    }
+}
+
+void QDeferredDeleteList::clear()
+{
+    for (int i = 0; i < entries.size(); ++i)
+        take(i);
+    entries.clear();
+    head = 0;
+    // the posted events, and with them the markers, are cleared as well
+    postedMarkers = deliveredMarkers = 0;
+}
+
+/*
+    Drops the entries that were taken. Must not be called while a pass over
+    the list is running.
+*/
+void QDeferredDeleteList::squeeze()
+{
+    head = 0;
+    if (!objects) {
+        entries.clear();
+        return;
+    }
+    int j = 0;
+    for (int i = 0; i < entries.size(); ++i) {
+        const Entry &entry = entries.at(i);
+        if (!entry.object)
+            continue;
+        QObjectPrivate::get(entry.object)->deferredDeleteIndex = j;
+        entries[j++] = entry;
+    }
+    entries.resize(j);
+}
+
+/*
+  QPostEventList
+*/
+
+QPostEventList::~QPostEventList()
+{
+    delete lockFreeQueue.load();
+}
+
+/*
+    Pushes \a event to the lock-free queue, without locking the mutex.
+    Returns \c false if the queue is full, in which case the event has to be
+    added with addEvent().
+*/
+bool QPostEventList::addEventLockFree(QObject *receiver, QEvent *event)
+{
+    QPostEventQueue *queue = lockFreeQueue.loadAcquire();
+    if (!queue) {
+        QPostEventQueue *newQueue = new QPostEventQueue;
+        if (lockFreeQueue.testAndSetOrdered(nullptr, newQueue, queue)) {
+            queue = newQueue;
+        } else {
+            delete newQueue;
+        }
+    }
+    return queue->push(receiver, event);
+}
+
+/*
+    Moves the events posted with addEventLockFree() into the list, in the
+    order they were posted. Must be called with the mutex held, before
+    looking at the list.
+*/
+void QPostEventList::takeLockFreeEvents()
+{
+    QPostEventQueue *queue = lockFreeQueue.loadAcquire();
+    if (!queue)
+        return;
+    // don't chase events that keep being posted while we are at it
+    QPostEvent pe;
+    for (int n = queue->count(); n > 0 && queue->pop(&pe); --n)
+        addEvent(pe);
+}
+
+/*
+    Adds \a object to the deferred deletions, and a marker for it to the
+    posted events unless the last marker is still the last posted event and
+    no pass over the list has reached it yet. Markers all have the normal
+    priority, so that they stay in the order they were posted in. Must be
+    called with the mutex held.
+*/
+void QPostEventList::addDeferredDelete(QObject *object, int level)
+{
+    // the marker goes after the events that were posted before
+    takeLockFreeEvents();
+    if (isEmpty() || size() <= qMax(startOffset, insertionOffset)
+        || !isDeferredDeleteMarker(constLast())) {
+        addDeferredDeleteMarker();
+    }
+    deferredDeletes.add(object, level);
+}
+
+void QPostEventList::addDeferredDeleteMarker()
+{
+    addEvent(QPostEvent(nullptr, nullptr, Qt::NormalEventPriority));
+    deferredDeletes.addMarker();
+}
+
+/*
+    Waits until no thread is inside addEventLockFree() for a receiver whose
+    thread data it read before the calling thread changed it.
+*/
+void QPostEventList::waitForLockFreePosters()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (lockFreePosters.loadAcquire()) {
+#ifndef QT_NO_THREAD
+        QThread::yieldCurrentThread();
+#endif
+    }
+}
+
 /*
   QThreadData
 */
@@ -89,14 +302,16 @@ QThreadData::~QThreadData()
     thread = 0;
     delete t;
 
+    postEventList.takeLockFreeEvents();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
-            --pe.receiver->d_func()->postedEvents;
+            pe.receiver->d_func()->postedEventCount.deref();
             pe.event->posted = false;
             delete pe.event;
         }
     }
+    postEventList.deferredDeletes.clear();
 
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
@@ -100,6 +100,87 @@ inline bool operator<(const QPostEvent &first, const QPostEvent &second)
     return first.priority > second.priority;
 }
 
+// Bounded lock-free queue of normal priority events. Any thread may push;
+// only the holder of QPostEventList::mutex pops, moving the events into the
+// list. Each cell carries a sequence number telling whether it is free, or
+// holds an event that was completely written.
+class QPostEventQueue
+{
+public:
+    enum { Size = 256 };
+
+    QPostEventQueue();
+
+    bool push(QObject *receiver, QEvent *event);
+    bool pop(QPostEvent *pe);
+    bool isEmpty() const { return enqueuePos.load() == dequeuePos.load(); }
+    int count() const { return int(enqueuePos.load() - dequeuePos.load()); }
+
+private:
+    struct Cell {
+        QAtomicInteger<uint> sequence;
+        QObject *receiver;
+        QEvent *event;
+    };
+
+    Cell cells[Size];
+    QAtomicInteger<uint> enqueuePos;
+    QAtomicInteger<uint> dequeuePos;
+};
+
+struct QDeferredDeleteEntry
+{
+    QObject *object;
+    int level;
+    // the marker in the list of posted events that delivers this entry
+    uint marker;
+};
+Q_DECLARE_TYPEINFO(QDeferredDeleteEntry, Q_PRIMITIVE_TYPE);
+
+// Objects for which deleteLater() was called in their own thread. An entry
+// takes the place of a posted QDeferredDeleteEvent and remembers the loop
+// level the event would have carried. Where the event would have been, the
+// list of posted events holds a marker instead, which consecutive calls
+// share; sendPostedEvents() delivers the entries of a marker when it gets
+// to it, so that they keep their order relative to the posted events.
+// Markers are numbered in the order they are posted and always delivered in
+// that order. Entries are only ever nulled out while a pass may be running,
+// squeeze() drops them afterwards. Guarded by QPostEventList::mutex.
+class QDeferredDeleteList
+{
+public:
+    typedef QDeferredDeleteEntry Entry;
+
+    inline QDeferredDeleteList() : objects(0), head(0), postedMarkers(0), deliveredMarkers(0) { }
+
+    bool isEmpty() const { return objects == 0; }
+    int count() const { return objects; }
+    int size() const { return entries.size(); }
+    const Entry &at(int i) const { return entries.at(i); }
+    // the first entry that may still hold an object
+    int first() const { return head; }
+
+    uint addMarker() { return ++postedMarkers; }
+    uint deliverMarker() { return ++deliveredMarkers; }
+    uint lastPostedMarker() const { return postedMarkers; }
+    uint lastDeliveredMarker() const { return deliveredMarkers; }
+    int pendingMarkers() const { return int(postedMarkers - deliveredMarkers); }
+
+    void add(QObject *object, int level);
+    QObject *take(int i);
+    void remove(QObject *object);
+    void clear();
+    void squeeze();
+
+private:
+    QVector<Entry> entries;
+    // number of entries that still hold an object
+    int objects;
+    int head;
+    uint postedMarkers;
+    uint deliveredMarkers;
+};
+
 // This class holds the list of posted events.
 //  The list has to be kept sorted by priority
 class QPostEventList : public QVector<QPostEvent>
@@ -115,9 +196,37 @@ public:
 
     QMutex mutex;
 
+    // events posted without locking the mutex, allocated on first use
+    QAtomicPointer<QPostEventQueue> lockFreeQueue;
+    // number of threads currently inside addEventLockFree()
+    QAtomicInt lockFreePosters;
+
+    // deleteLater() calls coalesced instead of posting a DeferredDelete event each
+    QDeferredDeleteList deferredDeletes;
+
     inline QPostEventList()
         : QVector<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0)
     { }
+    ~QPostEventList();
+
+    static bool canAddEventLockFree(const QEvent *event, int priority)
+    {
+        // postEvent() treats some other built-in types, such as
+        // DeferredDelete, specially under the mutex
+        return priority == Qt::NormalEventPriority
+                && (event->type() == QEvent::MetaCall || event->type() >= QEvent::User);
+    }
+    bool addEventLockFree(QObject *receiver, QEvent *event);
+    void takeLockFreeEvents();
+    void addDeferredDelete(QObject *object, int level);
+    void addDeferredDeleteMarker();
+    static bool isDeferredDeleteMarker(const QPostEvent &pe) { return !pe.receiver; }
+    void waitForLockFreePosters();
+    int lockFreeEventCount() const
+    {
+        const QPostEventQueue *queue = lockFreeQueue.loadAcquire();
+        return queue ? queue->count() : 0;
+    }
 
     void addEvent(const QPostEvent &ev) {
         int priority = ev.priority;
@@ -252,7 +361,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.lockFreeEventCount();
     }
 
     // This class provides per-thread (by way of being a QThreadData
@@ -289,6 +398,7 @@ public:
     QAtomicPointer<QAbstractEventDispatcher> eventDispatcher;
     QVector<void *> tls;
     FlaggedDebugSignatures flaggedSignatures;
+    QMetaCallBatchPool metaCallBatchPool;
 
     bool quitNow;
     bool canWait;
@@ -40,8 +40,10 @@
 #include "qthreadpool.h"
 #include "qthreadpool_p.h"
 #include "qelapsedtimer.h"
+#include "qrandom.h"
 
 #include <algorithm>
+#include <limits>
 
 #ifndef QT_NO_THREAD
 
@@ -49,6 +51,131 @@ QT_BEGIN_NAMESPACE
 
 Q_GLOBAL_STATIC(QThreadPool, theInstance)
 
+static const int EmptyQueuePriority = std::numeric_limits<int>::min();
+
+/*
+    Per-thread run queue used in work-stealing mode. Only the owning thread
+    pushes; it pops from the back (newest first), while other threads steal
+    from the front (oldest first). Entries are kept sorted by ascending
+    priority, so both ends hand out the highest priority runnable available.
+*/
+class QThreadPoolLocalQueue
+{
+public:
+    void push(QRunnable *runnable, int priority);
+    QRunnable *pop(int minimumPriority);
+    QRunnable *steal();
+    bool tryTake(QRunnable *runnable);
+    QVector<QRunnable *> takeAll();
+
+    // may be read without holding the mutex, as a hint
+    bool isEmpty() const { return count.load() == 0; }
+
+    QMutex mutex;
+
+    struct Entry {
+        QRunnable *runnable;
+        int priority;
+    };
+
+private:
+    void removeAt(int i);
+
+    QVector<Entry> entries;
+    int head = 0;
+    QAtomicInt count;
+};
+
+Q_DECLARE_TYPEINFO(QThreadPoolLocalQueue::Entry, Q_PRIMITIVE_TYPE);
+
+void QThreadPoolLocalQueue::push(QRunnable *runnable, int priority)
+{
+    QMutexLocker locker(&mutex);
+    const Entry entry = { runnable, priority };
+    if (entries.size() == head || entries.last().priority <= priority) {
+        entries.append(entry);
+    } else {
+        int i = entries.size() - 1;
+        while (i > head && entries.at(i - 1).priority > priority)
+            --i;
+        entries.insert(i, entry);
+    }
+    count.ref();
+}
+
+QRunnable *QThreadPoolLocalQueue::pop(int minimumPriority)
+{
+    if (isEmpty())
+        return nullptr;
+    QMutexLocker locker(&mutex);
+    if (entries.size() == head || entries.last().priority < minimumPriority)
+        return nullptr;
+    QRunnable *runnable = entries.last().runnable;
+    removeAt(entries.size() - 1);
+    return runnable;
+}
+
+QRunnable *QThreadPoolLocalQueue::steal()
+{
+    if (isEmpty())
+        return nullptr;
+    QMutexLocker locker(&mutex);
+    if (entries.size() == head)
+        return nullptr;
+    // take the oldest entry of the highest priority
+    const int priority = entries.last().priority;
+    int i = entries.size() - 1;
+    while (i > head && entries.at(i - 1).priority == priority)
+        --i;
+    QRunnable *runnable = entries.at(i).runnable;
+    removeAt(i);
+    return runnable;
+}
+
+bool QThreadPoolLocalQueue::tryTake(QRunnable *runnable)
+{
+    if (isEmpty())
+        return false;
+    QMutexLocker locker(&mutex);
+    for (int i = head; i < entries.size(); ++i) {
+        if (entries.at(i).runnable == runnable) {
+            removeAt(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+QVector<QRunnable *> QThreadPoolLocalQueue::takeAll()
+{
+    QMutexLocker locker(&mutex);
+    QVector<QRunnable *> runnables;
+    runnables.reserve(entries.size() - head);
+    for (int i = head; i < entries.size(); ++i)
+        runnables.append(entries.at(i).runnable);
+    entries.resize(0);
+    head = 0;
+    count.store(0);
+    return runnables;
+}
+
+void QThreadPoolLocalQueue::removeAt(int i)
+{
+    if (i == head)
+        ++head;
+    else
+        entries.remove(i);
+    if (head == entries.size()) {
+        // keeps the capacity for the next round of pushes
+        entries.resize(0);
+        head = 0;
+    } else if (head > 64 && head > entries.size() / 2) {
+        entries.remove(0, head);
+        head = 0;
+    }
+    count.deref();
+}
+
 /*
     QThread wrapper, provides synchronization against a ThreadPool
 */
@@ -58,12 +185,19 @@ public:
     QThreadPoolThread(QThreadPoolPrivate *manager);
     void run() override;
     void registerThreadInactive();
+    int randomIndex(int count);
 
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    QThreadPoolLocalQueue localQueue;
+    quint32 victimSeed;
 };
 
+#ifdef Q_COMPILER_THREAD_LOCAL
+static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+#endif
+
 /*
     QThreadPool private class.
 */
@@ -73,7 +207,7 @@ public:
     \internal
 */
 QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
-    :manager(manager), runnable(nullptr)
+    :manager(manager), runnable(nullptr), victimSeed(QRandomGenerator::global()->generate() | 1)
 {
     setStackSize(manager->stackSize);
 }
@@ -83,6 +217,9 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+#ifdef Q_COMPILER_THREAD_LOCAL
+    currentPoolThread = this;
+#endif
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -90,37 +227,42 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                const bool autoDelete = r->autoDelete();
-
-
-                // run the task
                 locker.unlock();
+                // run the task, then keep running tasks from the local queue
+                // (or stolen from other threads) without taking the pool lock
+                do {
+                    const bool autoDelete = r->autoDelete();
+
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
-                locker.relock();
 
-                if (autoDelete && !--r->ref)
-                    delete r;
+                    if (autoDelete && !r->ref.deref())
+                        delete r;
+                } while ((r = manager->takeLocalOrStolenTask(this)));
+                locker.relock();
             }
 
             // if too many threads are active, expire this thread
-            if (manager->tooManyThreadsActive())
+            // (but never leave tasks behind in the local queue)
+            if (manager->tooManyThreadsActive() && localQueue.isEmpty())
                 break;
 
             if (manager->queue.isEmpty()) {
-                r = nullptr;
-                break;
+                r = manager->takeLocalOrStolenTask(this);
+                if (!r)
+                    break;
+                continue;
             }
 
             QueuePage *page = manager->queue.first();
@@ -130,6 +272,7 @@ void QThreadPoolThread::run()
                 manager->queue.removeFirst();
                 delete page;
             }
+            manager->updateQueuePriority();
         } while (true);
 
         if (manager->isExiting) {
@@ -142,15 +285,26 @@ void QThreadPoolThread::run()
         if (!expired) {
             manager->waitingThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateSpareThreads();
+            // a task may have been pushed to a local queue after we last
+            // looked, by a thread that did not see us waiting yet
+            if (manager->workStealing.load() && manager->hasLocalTasks()) {
+                manager->waitingThreads.removeOne(this);
+                ++manager->activeThreads;
+                manager->updateSpareThreads();
+                continue;
+            }
             // wait for work, exiting after the expiry timeout is reached
             runnableReady.wait(locker.mutex(), manager->expiryTimeout);
             ++manager->activeThreads;
             if (manager->waitingThreads.removeOne(this))
                 expired = true;
+            manager->updateSpareThreads();
         }
         if (expired) {
             manager->expiredThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateSpareThreads();
             break;
         }
     }
@@ -162,11 +316,25 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+/*
+    \internal
+    Returns a random index below \a count, used to pick the first thread to
+    steal from. A xorshift generator is good enough for that.
+*/
+int QThreadPoolThread::randomIndex(int count)
+{
+    victimSeed ^= victimSeed << 13;
+    victimSeed ^= victimSeed >> 17;
+    victimSeed ^= victimSeed << 5;
+    return int(victimSeed % uint(count));
+}
+
 
 /*
     \internal
 */
 QThreadPoolPrivate:: QThreadPoolPrivate()
+    : spareThreads(maxThreadCount), queuePriority(EmptyQueuePriority)
 { }
 
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
@@ -197,7 +365,7 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         ++activeThreads;
 
         if (task->autoDelete())
-            ++task->ref;
+            task->ref.ref();
         thread->runnable = task;
         thread->start();
         return true;
@@ -217,7 +385,7 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
     if (runnable->autoDelete())
-        ++runnable->ref;
+        runnable->ref.ref();
 
     for (QueuePage *page : qAsConst(queue)) {
         if (page->priority() == priority && !page->isFull()) {
@@ -227,6 +395,43 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    updateQueuePriority();
+}
+
+/*!
+    \internal
+    Appends all non-null \a tasks to the queue with the given \a priority,
+    filling pages in order. Returns the number of tasks queued.
+*/
+int QThreadPoolPrivate::enqueueTasks(const QVector<QRunnable *> &tasks, int priority)
+{
+    QueuePage *page = nullptr;
+    for (QueuePage *p : qAsConst(queue)) {
+        if (p->priority() == priority && !p->isFull()) {
+            page = p;
+            break;
+        }
+    }
+
+    int count = 0;
+    for (QRunnable *runnable : tasks) {
+        if (!runnable)
+            continue;
+        if (runnable->autoDelete())
+            runnable->ref.ref();
+        ++count;
+
+        if (page && !page->isFull()) {
+            page->push(runnable);
+        } else {
+            // goes after all pages with the same priority, which are full
+            auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
+            page = new QueuePage(runnable, priority);
+            queue.insert(std::distance(queue.constBegin(), it), page);
+        }
+    }
+    updateQueuePriority();
+    return count;
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -251,6 +456,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             queue.removeFirst();
             delete page;
         }
+        updateQueuePriority();
     }
 }
 
@@ -260,6 +466,158 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
     return activeThreadCount > maxThreadCount && (activeThreadCount - reservedThreads) > 1;
 }
 
+/*!
+    \internal
+
+    Returns \c true if the calling thread is one of this pool's threads.
+*/
+bool QThreadPoolPrivate::isPoolThread() const
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    return currentPoolThread && currentPoolThread->manager == this;
+#else
+    return false;
+#endif
+}
+
+/*!
+    \internal
+    Pushes \a runnable to the local queue of the calling thread, if work
+    stealing is enabled and the caller is one of this pool's threads. Only
+    takes the pool mutex when there is an idle thread to wake or room for a
+    new one. Returns \c false if the runnable was not queued.
+*/
+bool QThreadPoolPrivate::tryEnqueueLocalTask(QRunnable *runnable, int priority)
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    QThreadPoolThread *thread = currentPoolThread;
+    if (!thread || thread->manager != this || !workStealing.load())
+        return false;
+
+    if (runnable->autoDelete())
+        runnable->ref.ref();
+    thread->localQueue.push(runnable, priority);
+
+    if (spareThreads.loadAcquire() > 0) {
+        QMutexLocker locker(&mutex);
+        startIdleThread();
+    }
+    return true;
+#else
+    Q_UNUSED(runnable);
+    Q_UNUSED(priority);
+    return false;
+#endif
+}
+
+/*!
+    \internal
+    Returns the next runnable for \a thread from its local queue, unless the
+    global queue holds a runnable with a higher priority. If both are empty
+    and work stealing is enabled, tries to steal a runnable from the local
+    queue of another thread. Does not need the pool mutex.
+*/
+QRunnable *QThreadPoolPrivate::takeLocalOrStolenTask(QThreadPoolThread *thread)
+{
+    const int globalPriority = queuePriority.loadAcquire();
+    if (QRunnable *r = thread->localQueue.pop(globalPriority))
+        return r;
+    if (globalPriority != EmptyQueuePriority || !workStealing.load())
+        return nullptr;
+
+    const QVector<QThreadPoolThread *> *threads = stealableThreads.loadAcquire();
+    if (!threads || threads->size() < 2)
+        return nullptr;
+    const int start = thread->randomIndex(threads->size());
+    for (int i = 0; i < threads->size(); ++i) {
+        QThreadPoolThread *victim = threads->at((start + i) % threads->size());
+        if (victim == thread)
+            continue;
+        if (QRunnable *r = victim->localQueue.steal())
+            return r;
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+    Returns \c true if any thread has runnables in its local queue. Locks each
+    local queue, so that a runnable pushed concurrently by a thread that saw
+    no spare threads is either found here, or its pusher sees the updated
+    spareThreads count. Must be called with the pool mutex held.
+*/
+bool QThreadPoolPrivate::hasLocalTasks() const
+{
+    for (QThreadPoolThread *thread : allThreads) {
+        QMutexLocker locker(&thread->localQueue.mutex);
+        if (!thread->localQueue.isEmpty())
+            return true;
+    }
+    return false;
+}
+
+/*!
+    \internal
+    Wakes a waiting thread, or starts a new one if the thread limit allows,
+    without handing it a runnable; the thread will look for work in the
+    local queues of the other threads. Must be called with the pool mutex held.
+*/
+void QThreadPoolPrivate::startIdleThread()
+{
+    if (!waitingThreads.isEmpty()) {
+        waitingThreads.takeFirst()->runnableReady.wakeOne();
+    } else if (activeThreadCount() < maxThreadCount && !isExiting) {
+        QThreadPoolThread *thread;
+        if (!expiredThreads.isEmpty()) {
+            thread = expiredThreads.dequeue();
+        } else {
+            thread = new QThreadPoolThread(this);
+            thread->setObjectName(QLatin1String("Thread (pooled)"));
+            allThreads.append(thread);
+            publishStealableThreads();
+        }
+        ++activeThreads;
+        thread->start();
+    }
+    updateSpareThreads();
+}
+
+/*!
+    \internal
+    Caches the priority of the first runnable in the global queue, so that
+    threads popping from their local queue can check it without the mutex.
+    Must be called with the pool mutex held, whenever the queue changes.
+*/
+void QThreadPoolPrivate::updateQueuePriority()
+{
+    queuePriority.storeRelease(queue.isEmpty() ? EmptyQueuePriority : queue.first()->priority());
+}
+
+/*!
+    \internal
+    Caches the number of threads that could start working on a runnable
+    right away, so that tryEnqueueLocalTask() only takes the mutex when it
+    can wake or start one. Must be called with the pool mutex held, whenever
+    activeThreadCount() or maxThreadCount changes.
+*/
+void QThreadPoolPrivate::updateSpareThreads()
+{
+    spareThreads.storeRelease(maxThreadCount - activeThreadCount());
+}
+
+/*!
+    \internal
+    Publishes a copy of allThreads for threads looking for a victim to steal
+    from. Earlier copies may still be in use and are deleted in reset().
+    Must be called with the pool mutex held.
+*/
+void QThreadPoolPrivate::publishStealableThreads()
+{
+    const QVector<QThreadPoolThread *> *threads = new QVector<QThreadPoolThread *>(allThreads.toVector());
+    if (const QVector<QThreadPoolThread *> *previous = stealableThreads.fetchAndStoreRelease(threads))
+        retiredStealableThreads.append(previous);
+}
+
 /*!
     \internal
 */
@@ -270,10 +628,11 @@ void QThreadPoolPrivate::startThread(QRunnable *runnable)
     thread->setObjectName(QLatin1String("Thread (pooled)"));
     Q_ASSERT(!allThreads.contains(thread.data())); // if this assert hits, we have an ABA problem (deleted threads don't get removed here)
     allThreads.append(thread.data());
+    publishStealableThreads();
     ++activeThreads;
 
     if (runnable->autoDelete())
-        ++runnable->ref;
+        runnable->ref.ref();
     thread->runnable = runnable;
     thread.take()->start();
 }
@@ -296,8 +655,10 @@ void QThreadPoolPrivate::reset()
         for (QThreadPoolThread *thread : qAsConst(allThreadsCopy)) {
             thread->runnableReady.wakeAll();
             thread->wait();
-            delete thread;
         }
+        // only delete the threads once none of them can be stealing from
+        // the local queue of another
+        qDeleteAll(allThreadsCopy);
 
         locker.relock();
         // repeat until all newly arrived threads have also completed
@@ -305,6 +666,10 @@ void QThreadPoolPrivate::reset()
 
     waitingThreads.clear();
     expiredThreads.clear();
+    delete stealableThreads.fetchAndStoreRelaxed(nullptr);
+    qDeleteAll(retiredStealableThreads);
+    retiredStealableThreads.clear();
+    updateSpareThreads();
 
     isExiting = false;
 }
@@ -332,12 +697,21 @@ void QThreadPoolPrivate::clear()
     for (QueuePage *page : qAsConst(queue)) {
         while (!page->isFinished()) {
             QRunnable *r = page->pop();
-            if (r && r->autoDelete() && !--r->ref)
+            if (r && r->autoDelete() && !r->ref.deref())
                 delete r;
         }
     }
     qDeleteAll(queue);
     queue.clear();
+    updateQueuePriority();
+
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        const QVector<QRunnable *> runnables = thread->localQueue.takeAll();
+        for (QRunnable *r : runnables) {
+            if (r->autoDelete() && !r->ref.deref())
+                delete r;
+        }
+    }
 }
 
 /*!
@@ -372,8 +746,17 @@ bool QThreadPool::tryTake(QRunnable *runnable)
                     d->queue.removeOne(page);
                     delete page;
                 }
+                d->updateQueuePriority();
+                if (runnable->autoDelete())
+                    runnable->ref.deref(); // undo ref() in start()
+                return true;
+            }
+        }
+
+        for (QThreadPoolThread *thread : qAsConst(d->allThreads)) {
+            if (thread->localQueue.tryTake(runnable)) {
                 if (runnable->autoDelete())
-                    --runnable->ref; // undo ++ref in start()
+                    runnable->ref.deref(); // undo ref() in start()
                 return true;
             }
         }
@@ -393,7 +776,7 @@ void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
     Q_Q(QThreadPool);
     if (!q->tryTake(runnable))
         return;
-    const bool del = runnable->autoDelete() && !runnable->ref; // tryTake already deref'ed
+    const bool del = runnable->autoDelete() && !runnable->ref.load(); // tryTake already deref'ed
 
     runnable->run();
 
@@ -500,6 +883,9 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (d->tryEnqueueLocalTask(runnable, priority))
+        return;
+
     QMutexLocker locker(&d->mutex);
     if (!d->tryStart(runnable)) {
         d->enqueueTask(runnable, priority);
@@ -507,6 +893,80 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         if (!d->waitingThreads.isEmpty())
             d->waitingThreads.takeFirst()->runnableReady.wakeOne();
     }
+    d->updateSpareThreads();
+}
+
+/*!
+    \since 5.12
+
+    Adds all \a runnables to the run queue with the given \a priority, and
+    wakes or starts as many threads as there are runnables, within the limit
+    of maxThreadCount().
+
+    This is equivalent to calling start() for each of the runnables, but
+    takes the pool's lock only once, which makes a difference when starting
+    many small tasks at once. Null entries are ignored. The ownership rules
+    are the same as for start().
+*/
+void QThreadPool::startBatch(const QVector<QRunnable *> &runnables, int priority)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    const int count = d->enqueueTasks(runnables, priority);
+    if (count == 0)
+        return;
+
+    // make sure there is at least one thread, like tryStart()
+    if (d->allThreads.isEmpty() && d->activeThreadCount() >= d->maxThreadCount) {
+        QThreadPoolThread *thread = new QThreadPoolThread(d);
+        thread->setObjectName(QLatin1String("Thread (pooled)"));
+        d->allThreads.append(thread);
+        d->publishStealableThreads();
+        ++d->activeThreads;
+        thread->start();
+    }
+
+    // the threads take the runnables from the queue
+    for (int i = 0; i < count; ++i) {
+        if (d->waitingThreads.isEmpty()
+                && (d->activeThreadCount() >= d->maxThreadCount || d->isExiting)) {
+            break;
+        }
+        d->startIdleThread();
+    }
+    d->updateSpareThreads();
+}
+
+namespace {
+class FunctionRunnable : public QRunnable
+{
+public:
+    explicit FunctionRunnable(const std::function<void()> &f)
+        : function(f)
+    { }
+
+    void run() override
+    { function(); }
+
+private:
+    std::function<void()> function;
+};
+}
+
+/*!
+    \since 5.12
+    \overload
+
+    Wraps each of the \a functions in a QRunnable and starts them all with
+    the given \a priority, taking the pool's lock only once.
+*/
+void QThreadPool::startBatch(const QVector<std::function<void()> > &functions, int priority)
+{
+    QVector<QRunnable *> runnables;
+    runnables.reserve(functions.size());
+    for (const std::function<void()> &function : functions)
+        runnables.append(new FunctionRunnable(function));
+    startBatch(runnables, priority);
 }
 
 /*!
@@ -537,7 +997,9 @@ bool QThreadPool::tryStart(QRunnable *runnable)
     if (d->allThreads.isEmpty() == false && d->activeThreadCount() >= d->maxThreadCount)
         return false;
 
-    return d->tryStart(runnable);
+    const bool started = d->tryStart(runnable);
+    d->updateSpareThreads();
+    return started;
 }
 
 /*! \property QThreadPool::expiryTimeout
@@ -595,6 +1057,7 @@ void QThreadPool::setMaxThreadCount(int maxThreadCount)
 
     d->maxThreadCount = maxThreadCount;
     d->tryToStartMoreThreads();
+    d->updateSpareThreads();
 }
 
 /*! \property QThreadPool::activeThreadCount
@@ -631,6 +1094,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateSpareThreads();
 }
 
 /*! \property QThreadPool::stackSize
@@ -659,6 +1123,49 @@ uint QThreadPool::stackSize() const
     return d->stackSize;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+
+    This property holds whether the thread pool uses work stealing to
+    schedule runnables started from its own threads.
+
+    By default, all runnables are kept in a single queue, ordered by
+    priority and protected by the thread pool's mutex. This is fair, but
+    the mutex becomes a point of contention when many small runnables are
+    started concurrently.
+
+    When work stealing is enabled, each thread of the pool has its own
+    queue. A runnable passed to start() from within one of the pool's
+    threads is added to that thread's queue without locking the pool, and
+    the thread runs the most recently added runnable first when it becomes
+    free. Threads that run out of work take the oldest runnable from the
+    queue of another, randomly chosen, thread. Runnables started from other
+    threads still go through the shared queue.
+
+    Priorities are still honored: a thread only takes a runnable from its
+    own queue if the shared queue does not hold one with a higher priority,
+    and runnables are taken from each queue in order of priority. tryTake()
+    and clear() also apply to the per-thread queues.
+
+    The default value is \c false.
+
+    \note Enabling work stealing changes the order in which runnables of the
+    same priority are run, if they are started from the pool's threads.
+
+    \since 5.12
+    \sa start()
+*/
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.store(enabled);
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.load();
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -677,6 +1184,7 @@ void QThreadPool::releaseThread()
     QMutexLocker locker(&d->mutex);
     --d->reservedThreads;
     d->tryToStartMoreThreads();
+    d->updateSpareThreads();
 }
 
 /*!
@@ -722,7 +1230,7 @@ void QThreadPool::clear()
 */
 void QThreadPool::cancel(QRunnable *runnable)
 {
-    if (tryTake(runnable) && runnable->autoDelete() && !runnable->ref) // tryTake already deref'ed
+    if (tryTake(runnable) && runnable->autoDelete() && !runnable->ref.load()) // tryTake already deref'ed
         delete runnable;
 }
 #endif
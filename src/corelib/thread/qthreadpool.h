@@ -44,6 +44,9 @@
 
 #include <QtCore/qthread.h>
 #include <QtCore/qrunnable.h>
+#include <QtCore/qvector.h>
+
+#include <functional>
 
 #ifndef QT_NO_THREAD
 
@@ -59,7 +62,9 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount)
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
     Q_PROPERTY(uint stackSize READ stackSize WRITE setStackSize)
+    Q_PROPERTY(bool workStealingEnabled READ isWorkStealingEnabled WRITE setWorkStealingEnabled)
     friend class QFutureInterfaceBase;
+    friend class QTaskGroupPrivate;
 
 public:
     QThreadPool(QObject *parent = nullptr);
@@ -69,6 +74,8 @@ public:
 
     void start(QRunnable *runnable, int priority = 0);
     bool tryStart(QRunnable *runnable);
+    void startBatch(const QVector<QRunnable *> &runnables, int priority = 0);
+    void startBatch(const QVector<std::function<void()> > &functions, int priority = 0);
 
     int expiryTimeout() const;
     void setExpiryTimeout(int expiryTimeout);
@@ -81,6 +88,9 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setWorkStealingEnabled(bool enabled);
+    bool isWorkStealingEnabled() const;
+
     void reserveThread();
     void releaseThread();
 
@@ -57,6 +57,7 @@
 #include "QtCore/qwaitcondition.h"
 #include "QtCore/qset.h"
 #include "QtCore/qqueue.h"
+#include "QtCore/qvector.h"
 #include "private/qobject_p.h"
 
 #ifndef QT_NO_THREAD
@@ -155,6 +156,7 @@ public:
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
+    int enqueueTasks(const QVector<QRunnable *> &tasks, int priority);
     int activeThreadCount() const;
 
     void tryToStartMoreThreads();
@@ -167,6 +169,15 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    bool tryEnqueueLocalTask(QRunnable *runnable, int priority);
+    QRunnable *takeLocalOrStolenTask(QThreadPoolThread *thread);
+    bool hasLocalTasks() const;
+    bool isPoolThread() const;
+    void startIdleThread();
+    void updateQueuePriority();
+    void updateSpareThreads();
+    void publishStealableThreads();
+
     mutable QMutex mutex;
     QList<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
@@ -180,6 +191,13 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     bool isExiting = false;
+
+    // work-stealing mode; the atomics below are read without holding the mutex
+    QAtomicInt workStealing;
+    QAtomicInt spareThreads;
+    QAtomicInt queuePriority;
+    QAtomicPointer<const QVector<QThreadPoolThread *> > stealableThreads;
+    QVector<const QVector<QThreadPoolThread *> *> retiredStealableThreads;
 };
 
 QT_END_NAMESPACE
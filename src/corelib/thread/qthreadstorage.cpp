@@ -73,6 +73,39 @@ static QBasicMutex destructorsMutex;
 typedef QVector<void (*)(void *)> DestructorMap;
 Q_GLOBAL_STATIC(DestructorMap, destructors)
 
+#if defined(Q_COMPILER_THREAD_LOCAL)
+#  define QT_THREADSTORAGE_FAST_SLOTS
+/*
+  The first FastSlotCount storage ids keep their per-thread value in a native
+  thread-local array, so get() does not have to look up the QThreadData of the
+  current thread and index its tls vector. The remaining ids use the tls vector
+  as before (their first FastSlotCount entries stay unused). Values in the fast
+  slots are destroyed by finish() when it is called for the current thread's
+  own data, which is what happens when a QThread exits. finish() can also run
+  on another thread (adopted threads on Windows are finished by a watcher
+  thread), so whatever is still left in the fast slots is destroyed by a
+  thread_local object when the owning thread exits.
+*/
+enum { FastSlotCount = 32 };
+static thread_local void *fastSlots[FastSlotCount];
+
+static inline bool isFastSlot(int id)
+{
+    return uint(id) < uint(FastSlotCount);
+}
+
+static void destroyFastSlots();
+
+// Kept apart from fastSlots, so that get() doesn't pay for the check that
+// registers the destructor. set() registers it when it fills a fast slot.
+struct QThreadStorageFastSlotsCleanup
+{
+    bool registered;
+    ~QThreadStorageFastSlotsCleanup() { destroyFastSlots(); }
+};
+static thread_local QThreadStorageFastSlotsCleanup fastSlotsCleanup;
+#endif
+
 QThreadStorageData::QThreadStorageData(void (*func)(void *))
 {
     QMutexLocker locker(&destructorsMutex);
@@ -89,6 +122,9 @@ QThreadStorageData::QThreadStorageData(void (*func)(void *))
          */
         QThreadData *data = QThreadData::current();
         id = data->tls.count();
+#ifdef QT_THREADSTORAGE_FAST_SLOTS
+        id = qMax(id, int(FastSlotCount));
+#endif
         DEBUG_MSG("QThreadStorageData: Allocated id %d, destructor %p cannot be stored", id, func);
         return;
     }
@@ -114,6 +150,15 @@ QThreadStorageData::~QThreadStorageData()
 
 void **QThreadStorageData::get() const
 {
+#ifdef QT_THREADSTORAGE_FAST_SLOTS
+    if (isFastSlot(id)) {
+        // a value can only have been set through set(), which made sure the
+        // thread has a QThreadData that will call finish() when it exits
+        void **v = &fastSlots[id];
+        return *v ? v : 0;
+    }
+#endif
+
     QThreadData *data = QThreadData::current();
     if (!data) {
         qWarning("QThreadStorage::get: QThreadStorage can only be used with threads started with QThread");
@@ -139,11 +184,22 @@ void **QThreadStorageData::set(void *p)
         qWarning("QThreadStorage::set: QThreadStorage can only be used with threads started with QThread");
         return 0;
     }
-    QVector<void *> &tls = data->tls;
-    if (tls.size() <= id)
-        tls.resize(id + 1);
 
-    void *&value = tls[id];
+    void **v;
+#ifdef QT_THREADSTORAGE_FAST_SLOTS
+    if (isFastSlot(id)) {
+        fastSlotsCleanup.registered = true;
+        v = &fastSlots[id];
+    } else
+#endif
+    {
+        QVector<void *> &tls = data->tls;
+        if (tls.size() <= id)
+            tls.resize(id + 1);
+        v = &tls[id];
+    }
+
+    void *&value = *v;
     // delete any previous data
     if (value != 0) {
         DEBUG_MSG("QThreadStorageData: Deleting previous storage %d, data %p, for thread %p",
@@ -169,37 +225,101 @@ void **QThreadStorageData::set(void *p)
     return &value;
 }
 
+// Calls the destructor of storage \a id on \a value. Returns \c false if the
+// QThreadStorage has been destroyed already.
+static bool destroyValue(int id, void *value)
+{
+    QMutexLocker locker(&destructorsMutex);
+    void (*destructor)(void *) = destructors()->value(id);
+    locker.unlock();
+
+    if (!destructor) {
+        if (QThread::currentThread())
+            qWarning("QThreadStorage: Thread %p exited after QThreadStorage %d destroyed",
+                     QThread::currentThread(), id);
+        return false;
+    }
+    destructor(value); //crash here might mean the thread exited after qthreadstorage was destroyed
+    return true;
+}
+
+#ifdef QT_THREADSTORAGE_FAST_SLOTS
+// Takes the value of the highest used fast slot of the current thread and
+// returns its id in \a id. Returns \c false if all fast slots are empty.
+static bool takeLastFastSlot(int *id, void **value)
+{
+    for (int i = FastSlotCount - 1; i >= 0; --i) {
+        if (fastSlots[i]) {
+            *id = i;
+            *value = fastSlots[i];
+            fastSlots[i] = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Same as takeLastFastSlot(), but only if \a tls is the data of the current
+// thread: the fast slots can only be reached from their owner.
+static bool takeLastFastSlot(const QVector<void *> *tls, int *id, void **value)
+{
+    QThreadData *data = QThreadData::current(false);
+    if (!data || &data->tls != tls)
+        return false;
+    return takeLastFastSlot(id, value);
+}
+
+static void destroyFastSlots()
+{
+    if (!destructors())
+        return;
+
+    int i;
+    void *q;
+    while (takeLastFastSlot(&i, &q))
+        destroyValue(i, q);
+}
+#else
+static inline bool takeLastFastSlot(const QVector<void *> *, int *, void **)
+{
+    return false;
+}
+#endif
+
 void QThreadStorageData::finish(void **p)
 {
     QVector<void *> *tls = reinterpret_cast<QVector<void *> *>(p);
-    if (!tls || tls->isEmpty() || !destructors())
+    if (!tls || !destructors())
         return; // nothing to do
 
     DEBUG_MSG("QThreadStorageData: Destroying storage for thread %p", QThread::currentThread());
-    while (!tls->isEmpty()) {
-        void *&value = tls->last();
-        void *q = value;
-        value = 0;
-        int i = tls->size() - 1;
-        tls->resize(i);
+    while (true) {
+        int i;
+        void *q;
+        if (!tls->isEmpty()) {
+            void *&value = tls->last();
+            q = value;
+            value = 0;
+            i = tls->size() - 1;
+            tls->resize(i);
+        } else if (!takeLastFastSlot(tls, &i, &q)) {
+            break;
+        }
 
         if (!q) {
             // data already deleted
             continue;
         }
 
-        QMutexLocker locker(&destructorsMutex);
-        void (*destructor)(void *) = destructors()->value(i);
-        locker.unlock();
+        if (!destroyValue(i, q))
+            continue;
 
-        if (!destructor) {
-            if (QThread::currentThread())
-                qWarning("QThreadStorage: Thread %p exited after QThreadStorage %d destroyed",
-                         QThread::currentThread(), i);
+#ifdef QT_THREADSTORAGE_FAST_SLOTS
+        if (isFastSlot(i)) {
+            fastSlots[i] = 0;
             continue;
         }
-        destructor(q); //crash here might mean the thread exited after qthreadstorage was destroyed
-
+#endif
         if (tls->size() > i) {
             //re reset the tls in case it has been recreated by its own destructor.
             (*tls)[i] = 0;
@@ -5,6 +5,7 @@ HEADERS += thread/qmutex.h \
            thread/qrunnable.h \
            thread/qreadwritelock.h \
            thread/qsemaphore.h \
+           thread/qtaskgroup.h \
            thread/qthread.h \
            thread/qthreadpool.h \
            thread/qthreadstorage.h \
@@ -30,6 +31,7 @@ SOURCES += thread/qatomic.cpp \
            thread/qrunnable.cpp \
            thread/qmutexpool.cpp \
            thread/qsemaphore.cpp \
+           thread/qtaskgroup.cpp \
            thread/qthread.cpp \
            thread/qthreadpool.cpp \
            thread/qthreadstorage.cpp
@@ -38,6 +40,7 @@ qtConfig(future) {
     HEADERS += \
         thread/qexception.h \
         thread/qfuture.h \
+        thread/qfuture_impl.h \
         thread/qfutureinterface.h \
         thread/qfutureinterface_p.h \
         thread/qfuturesynchronizer.h \
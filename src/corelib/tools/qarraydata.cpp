@@ -39,6 +39,7 @@
 ****************************************************************************/
 
 #include <QtCore/qarraydata.h>
+#include <QtCore/private/qcontainerarena_p.h>
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/private/qtools_p.h>
 
@@ -86,6 +87,29 @@ static QArrayData *reallocateData(QArrayData *header, size_t allocSize, uint opt
     return header;
 }
 
+#if !defined(QT_NO_UNSHARABLE_CONTAINERS)
+// Arena data keeps a pointer to its arena just before the elements. They
+// start further from the header than they can in heap data of the same
+// alignment, which tells the two apart without looking anything up.
+Q_STATIC_ASSERT(Q_ALIGNOF(QArrayData) >= sizeof(void *));
+
+static inline size_t arenaDataOffset(size_t alignment)
+{
+    return ((sizeof(QArrayData) + alignment - 1) & ~(alignment - 1)) + alignment;
+}
+
+static inline QContainerArenaPrivate *&arenaOf(QArrayData *header)
+{
+    return reinterpret_cast<QContainerArenaPrivate **>(header->data())[-1];
+}
+
+static inline bool isArenaData(const QArrayData *data, size_t alignment)
+{
+    // raw data has no capacity, and its elements can be anywhere
+    return data->alloc && size_t(data->offset) == arenaDataOffset(alignment);
+}
+#endif
+
 QArrayData *QArrayData::allocate(size_t objectSize, size_t alignment,
         size_t capacity, AllocationOptions options) Q_DECL_NOTHROW
 {
@@ -114,6 +138,27 @@ QArrayData *QArrayData::allocate(size_t objectSize, size_t alignment,
     if (headerSize > size_t(MaxAllocSize))
         return 0;
 
+#if !defined(QT_NO_UNSHARABLE_CONTAINERS)
+    // only containers whose inline copy code deep-copies unsharable data opt in
+    QContainerArenaPrivate *arena = (options & AllowArena) && !(options & RawData)
+            ? QContainerArenaPrivate::current() : nullptr;
+    if (arena) {
+        headerSize = arenaDataOffset(alignment);
+        size_t allocSize = calculateBlockSize(capacity, objectSize, headerSize, options);
+        QArrayData *header = static_cast<QArrayData *>(arena->allocate(allocSize, alignment));
+        if (header) {
+            // Arena data is never shared, so that copies of it can outlive the arena
+            header->ref.atomic.store(0);
+            header->size = 0;
+            header->alloc = capacity;
+            header->capacityReserved = bool(options & CapacityReserved);
+            header->offset = headerSize;
+            arenaOf(header) = arena;
+        }
+        return header;
+    }
+#endif
+
     size_t allocSize = calculateBlockSize(capacity, objectSize, headerSize, options);
     QArrayData *header = static_cast<QArrayData *>(::malloc(allocSize));
     if (header) {
@@ -164,6 +209,12 @@ void QArrayData::deallocate(QArrayData *data, size_t objectSize,
 
     Q_ASSERT_X(data == 0 || !data->ref.isStatic(), "QArrayData::deallocate",
                "Static data can not be deleted");
+#if !defined(QT_NO_UNSHARABLE_CONTAINERS)
+    if (data && isArenaData(data, alignment)) {
+        arenaOf(data)->deallocate(data);
+        return;
+    }
+#endif
     ::free(data);
 }
 
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qbytearraymatcher.h"
+#include "qstringsearch_p.h"
 
 #include <limits.h>
 
@@ -286,6 +287,15 @@ int qFindByteArray(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle[0], from);
 
+    /*
+      Short needles are searched for with SIMD kernels that check a
+      block of positions at a time.
+    */
+    if (sl < QtPrivate::ShortNeedleSearchLimit) {
+        return int(QtPrivate::findShortNeedle(reinterpret_cast<const uchar *>(haystack0), l, qMax(from, 0),
+                                              reinterpret_cast<const uchar *>(needle), sl));
+    }
+
     /*
       We use the Boyer-Moore algorithm in cases where the overhead
       for the skip table should pay off, otherwise we use a simple
@@ -0,0 +1,368 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qcontainerarena.h"
+#include "qcontainerarena_p.h"
+#include <QtCore/private/qtools_p.h>
+
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QContainerArena
+    \inmodule QtCore
+    \since 5.12
+    \reentrant
+
+    \brief The QContainerArena class hands out memory for QVector and frees
+    all of it at once.
+
+    An arena takes memory from a list of growing blocks by bumping a
+    pointer. Freeing memory in it does nothing, except for the latest
+    allocation, which is reused. release() and the destructor free all
+    blocks at once. This makes building and throwing away large graphs of
+    vectors, for instance while handling a request, much cheaper than going
+    through \c malloc() and \c free() for each of them.
+
+    Vectors allocate from an arena while a QContainerArenaScope for it is
+    active in the current thread:
+
+    \snippet code/src_corelib_tools_qcontainerarena.cpp 0
+
+    Vectors whose data is already on the heap keep it there when they grow.
+
+    Data allocated from an arena is never shared: copying a QVector that
+    uses it makes a deep copy, which comes from the arena of the active
+    scope, if any, or from the heap otherwise. So a copy made after leaving
+    the scope can outlive the arena. The vectors that use the arena must
+    be destroyed before the arena is released.
+
+    QString, QByteArray and QVarLengthArray always allocate from the heap,
+    because code compiled against earlier versions of Qt 5 shares and frees
+    their data without asking Qt.
+
+    An arena belongs to the thread that created it, and only that thread
+    allocates from it and releases it. Arena memory may be freed in another
+    thread, which leaves it in use until the arena is released. Arenas are
+    not available if the compiler does not support \c thread_local;
+    containers then allocate from the heap.
+
+    \sa QContainerArenaScope
+*/
+
+/*!
+    \class QContainerArenaScope
+    \inmodule QtCore
+    \since 5.12
+    \reentrant
+
+    \brief The QContainerArenaScope class makes vectors allocate from a
+    QContainerArena while it exists.
+
+    Scopes nest; the innermost one decides. A scope for a null arena makes
+    vectors allocate from the heap again, for instance to copy results into
+    objects that outlive the arena.
+
+    \sa QContainerArena
+*/
+
+struct QContainerArenaPrivate::Block
+{
+    Block *next;
+    char *end;
+
+    char *data() { return reinterpret_cast<char *>(this + 1); }
+    const char *data() const { return reinterpret_cast<const char *>(this + 1); }
+};
+
+QBasicAtomicInt QContainerArenaPrivate::arenaCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+#ifdef Q_COMPILER_THREAD_LOCAL
+// the arena of the innermost QContainerArenaScope; its address identifies the thread
+static thread_local QContainerArena *currentThreadArena = nullptr;
+#endif
+
+static inline char *alignedPointer(char *ptr, size_t alignment)
+{
+    return reinterpret_cast<char *>((quintptr(ptr) + alignment - 1) & ~quintptr(alignment - 1));
+}
+
+QContainerArenaPrivate::QContainerArenaPrivate(size_t initialBlockSize)
+    : blocks(nullptr), cursor(nullptr), limit(nullptr), last(nullptr),
+      initialBlockSize(qMax(initialBlockSize, size_t(64))), nextBlockSize(this->initialBlockSize),
+      totalSize(0), ownerThread(nullptr)
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    ownerThread = &currentThreadArena;
+#endif
+    arenaCount.ref();
+}
+
+QContainerArenaPrivate::~QContainerArenaPrivate()
+{
+    Q_ASSERT_X(isOwnedByCurrentThread(), "QContainerArena",
+               "Arena destroyed in a thread other than its own");
+    release();
+    arenaCount.deref();
+}
+
+/*!
+    \internal
+
+    Returns \a size bytes of memory aligned to \a alignment, which must be
+    a power of two, or \c nullptr if no memory could be allocated. Must be
+    called in the arena's own thread.
+*/
+void *QContainerArenaPrivate::allocate(size_t size, size_t alignment)
+{
+    Q_ASSERT(alignment && !(alignment & (alignment - 1)));
+    Q_ASSERT(isOwnedByCurrentThread());
+
+    char *ptr = alignedPointer(cursor, alignment);
+    if (Q_UNLIKELY(quintptr(ptr) > quintptr(limit) || size > size_t(limit - ptr)))
+        return allocateBlock(size, alignment);
+    cursor = ptr + size;
+    last = ptr;
+    return ptr;
+}
+
+void *QContainerArenaPrivate::allocateBlock(size_t size, size_t alignment)
+{
+    if (size > size_t(MaxAllocSize) || alignment > size_t(MaxAllocSize))
+        return nullptr;
+
+    // allocations that would not leave much room in a regular block get a
+    // block of their own, so that the current block can still be used
+    const bool dedicated = size + alignment > nextBlockSize / 2;
+    const size_t blockSize = dedicated ? size + alignment : nextBlockSize;
+
+    Block *block = static_cast<Block *>(::malloc(sizeof(Block) + blockSize));
+    if (!block)
+        return nullptr;
+    block->end = block->data() + blockSize;
+    char *ptr = alignedPointer(block->data(), alignment);
+    totalSize += blockSize;
+
+    if (dedicated && blocks) {
+        block->next = blocks->next;
+        blocks->next = block;
+        return ptr;
+    }
+
+    block->next = blocks;
+    blocks = block;
+    cursor = ptr + size;
+    limit = block->end;
+    last = ptr;
+    if (!dedicated)
+        nextBlockSize *= 2;
+    return ptr;
+}
+
+/*!
+    \internal
+
+    Gives the memory at \a ptr back to the arena. Only the latest allocation
+    is reused, and only if it is given back in the arena's own thread;
+    other memory stays in use until the arena is released.
+*/
+void QContainerArenaPrivate::deallocate(void *ptr)
+{
+    if (ptr == last && isOwnedByCurrentThread()) {
+        cursor = last;
+        last = nullptr;
+    }
+}
+
+/*!
+    \internal
+
+    Frees all blocks of the arena.
+*/
+void QContainerArenaPrivate::release()
+{
+    Q_ASSERT(isOwnedByCurrentThread());
+    while (blocks) {
+        Block *block = blocks;
+        blocks = block->next;
+        ::free(block);
+    }
+    cursor = limit = last = nullptr;
+    nextBlockSize = initialBlockSize;
+    totalSize = 0;
+}
+
+/*!
+    \internal
+
+    Returns \c true if \a ptr points into a block of this arena. Must be
+    called in the arena's own thread.
+*/
+bool QContainerArenaPrivate::owns(const void *ptr) const
+{
+    Q_ASSERT(isOwnedByCurrentThread());
+    const quintptr p = quintptr(ptr);
+    for (const Block *block = blocks; block; block = block->next) {
+        if (p >= quintptr(block->data()) && p < quintptr(block->end))
+            return true;
+    }
+    return false;
+}
+
+/*!
+    \internal
+
+    Returns \c true if the arena was created in the current thread.
+*/
+bool QContainerArenaPrivate::isOwnedByCurrentThread() const
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    return ownerThread == &currentThreadArena;
+#else
+    // containers don't use arenas then, only their creator does
+    return true;
+#endif
+}
+
+QContainerArenaPrivate *QContainerArenaPrivate::currentArena()
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    return get(currentThreadArena);
+#else
+    return nullptr;
+#endif
+}
+
+/*!
+    Constructs an arena that belongs to the current thread. The first block
+    it allocates holds \a initialBlockSize bytes, each further block twice
+    as many as the one before.
+*/
+QContainerArena::QContainerArena(qsizetype initialBlockSize)
+    : d(new QContainerArenaPrivate(size_t(qMax(initialBlockSize, qsizetype(0)))))
+{
+}
+
+/*!
+    Destroys the arena and frees all of its memory. No scope for the arena
+    may be active, and no vector may use its memory anymore. Must be called
+    in the thread that created the arena.
+*/
+QContainerArena::~QContainerArena()
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    Q_ASSERT_X(currentThreadArena != this, "QContainerArena",
+               "Arena destroyed while a scope for it is active");
+#endif
+    delete d;
+}
+
+/*!
+    Frees all memory of the arena at once, so that it starts over with an
+    empty block list. No vector may use the memory anymore. Must be called
+    in the thread that created the arena.
+*/
+void QContainerArena::release()
+{
+    d->release();
+}
+
+/*!
+    Returns the number of bytes in the blocks that the arena holds.
+*/
+qsizetype QContainerArena::capacity() const
+{
+    return qsizetype(d->totalSize);
+}
+
+/*!
+    Returns \c true if \a ptr points into memory of this arena, for instance
+    to check whether a vector's constData() was allocated from it. Must be
+    called in the thread that created the arena.
+*/
+bool QContainerArena::owns(const void *ptr) const
+{
+    return d->owns(ptr);
+}
+
+/*!
+    Returns the arena of the innermost active QContainerArenaScope in the
+    current thread, or \c nullptr if there is none.
+*/
+QContainerArena *QContainerArena::current()
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    return currentThreadArena;
+#else
+    return nullptr;
+#endif
+}
+
+/*!
+    Makes new vectors of the current thread allocate from \a arena, which
+    must have been created in this thread, until the scope is destroyed.
+    If \a arena is \c nullptr, they allocate from the heap.
+*/
+QContainerArenaScope::QContainerArenaScope(QContainerArena *arena)
+#ifdef Q_COMPILER_THREAD_LOCAL
+    : previous(currentThreadArena)
+{
+    Q_ASSERT(!arena || QContainerArenaPrivate::get(arena)->isOwnedByCurrentThread());
+    currentThreadArena = arena;
+}
+#else
+    : previous(nullptr)
+{
+    Q_UNUSED(arena);
+}
+#endif
+
+/*!
+    Makes the arena of the enclosing scope, if any, current again.
+*/
+QContainerArenaScope::~QContainerArenaScope()
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    currentThreadArena = previous;
+#endif
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCONTAINERARENA_P_H
+#define QCONTAINERARENA_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qcontainerarena.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QContainerArenaPrivate
+{
+public:
+    explicit QContainerArenaPrivate(size_t initialBlockSize);
+    ~QContainerArenaPrivate();
+
+    void *allocate(size_t size, size_t alignment);
+    void deallocate(void *ptr);
+    void release();
+
+    bool owns(const void *ptr) const;
+    bool isOwnedByCurrentThread() const;
+
+    static QContainerArenaPrivate *get(QContainerArena *arena)
+    { return arena ? arena->d : nullptr; }
+    static QContainerArenaPrivate *current()
+    { return Q_UNLIKELY(arenaCount.load()) ? currentArena() : nullptr; }
+
+private:
+    Q_DISABLE_COPY(QContainerArenaPrivate)
+
+    struct Block;
+
+    void *allocateBlock(size_t size, size_t alignment);
+
+    static QContainerArenaPrivate *currentArena();
+
+    Block *blocks;
+    char *cursor;
+    char *limit;
+    // start of the latest allocation, which can be given back in place
+    char *last;
+    size_t initialBlockSize;
+    size_t nextBlockSize;
+    size_t totalSize;
+    // identifies the thread that created the arena
+    const void *ownerThread;
+
+    friend class QContainerArena;
+
+    // number of arenas alive in the process; none means no scope can be active
+    static QBasicAtomicInt arenaCount;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONTAINERARENA_P_H
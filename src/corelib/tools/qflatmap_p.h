@@ -0,0 +1,390 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QFLATMAP_P_H
+#define QFLATMAP_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QFlatMap is an associative container with the interface of QMap (the
+    parts of it that Qt's own code uses), which stores its keys and its
+    values in two sorted QVectors instead of a tree of nodes. Lookups are a
+    binary search over contiguous keys, which for small maps is several
+    times faster than walking QMap's nodes, and the map costs two
+    allocations rather than one per entry. The price is that insert() and
+    remove() move the entries after the position they affect, so QFlatMap
+    suits maps that are built once and then mostly read. Building from
+    unsorted input in one go is best done with the constructor taking two
+    vectors, or by merging with insert(const QFlatMap &).
+
+    Like QMap, keys are compared with operator<() and inserting a key that
+    is already present replaces its value but keeps the stored key. The map
+    is implicitly shared through its vectors. Iterators are invalidated by
+    any modification of the map.
+*/
+template <class Key, class T>
+class QFlatMap
+{
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef int size_type;
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class QFlatMap;
+        friend class const_iterator;
+
+        const Key *k;
+        T *v;
+
+        iterator(const Key *key, T *value) : k(key), v(value) {}
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        iterator() : k(nullptr), v(nullptr) {}
+
+        const Key &key() const { return *k; }
+        T &value() const { return *v; }
+        T &operator*() const { return *v; }
+        T *operator->() const { return v; }
+
+        bool operator==(const iterator &o) const { return k == o.k; }
+        bool operator!=(const iterator &o) const { return k != o.k; }
+        bool operator<(const iterator &o) const { return k < o.k; }
+
+        iterator &operator++() { ++k; ++v; return *this; }
+        iterator operator++(int) { iterator r = *this; ++*this; return r; }
+        iterator &operator--() { --k; --v; return *this; }
+        iterator operator--(int) { iterator r = *this; --*this; return r; }
+        iterator &operator+=(difference_type n) { k += n; v += n; return *this; }
+        iterator &operator-=(difference_type n) { k -= n; v -= n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(k + n, v + n); }
+        iterator operator-(difference_type n) const { return iterator(k - n, v - n); }
+        difference_type operator-(const iterator &o) const { return k - o.k; }
+    };
+
+    class const_iterator
+    {
+        friend class QFlatMap;
+
+        const Key *k;
+        const T *v;
+
+        const_iterator(const Key *key, const T *value) : k(key), v(value) {}
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        const_iterator() : k(nullptr), v(nullptr) {}
+        const_iterator(const iterator &o) : k(o.k), v(o.v) {}
+
+        const Key &key() const { return *k; }
+        const T &value() const { return *v; }
+        const T &operator*() const { return *v; }
+        const T *operator->() const { return v; }
+
+        bool operator==(const const_iterator &o) const { return k == o.k; }
+        bool operator!=(const const_iterator &o) const { return k != o.k; }
+        bool operator<(const const_iterator &o) const { return k < o.k; }
+
+        const_iterator &operator++() { ++k; ++v; return *this; }
+        const_iterator operator++(int) { const_iterator r = *this; ++*this; return r; }
+        const_iterator &operator--() { --k; --v; return *this; }
+        const_iterator operator--(int) { const_iterator r = *this; --*this; return r; }
+        const_iterator &operator+=(difference_type n) { k += n; v += n; return *this; }
+        const_iterator &operator-=(difference_type n) { k -= n; v -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(k + n, v + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(k - n, v - n); }
+        difference_type operator-(const const_iterator &o) const { return k - o.k; }
+    };
+
+    QFlatMap() {}
+    QFlatMap(const QVector<Key> &keys, const QVector<T> &values);
+
+    void swap(QFlatMap &other) Q_DECL_NOTHROW
+    {
+        k.swap(other.k);
+        v.swap(other.v);
+    }
+
+    bool operator==(const QFlatMap &other) const { return k == other.k && v == other.v; }
+    bool operator!=(const QFlatMap &other) const { return !(*this == other); }
+
+    int size() const { return k.size(); }
+    int count() const { return k.size(); }
+    bool isEmpty() const { return k.isEmpty(); }
+    void reserve(int size) { k.reserve(size); v.reserve(size); }
+    void clear() { k.clear(); v.clear(); }
+
+    const QVector<Key> &keys() const { return k; }
+    const QVector<T> &values() const { return v; }
+
+    bool contains(const Key &key) const { return indexOf(key) != -1; }
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        const int i = indexOf(key);
+        return i == -1 ? defaultValue : v.at(i);
+    }
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const { return value(key); }
+
+    iterator begin() { return iterator(k.constData(), v.data()); }
+    iterator end() { return begin() + size(); }
+    const_iterator begin() const { return const_iterator(k.constData(), v.constData()); }
+    const_iterator end() const { return begin() + size(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    const_iterator constBegin() const { return begin(); }
+    const_iterator constEnd() const { return end(); }
+
+    iterator find(const Key &key) { return iteratorAt(indexOf(key)); }
+    const_iterator find(const Key &key) const { return constIteratorAt(indexOf(key)); }
+    const_iterator constFind(const Key &key) const { return find(key); }
+    iterator lowerBound(const Key &key) { return begin() + lowerBoundIndex(key); }
+    const_iterator lowerBound(const Key &key) const { return begin() + lowerBoundIndex(key); }
+    iterator upperBound(const Key &key) { return begin() + upperBoundIndex(key); }
+    const_iterator upperBound(const Key &key) const { return begin() + upperBoundIndex(key); }
+
+    iterator insert(const Key &key, const T &value);
+    void insert(const QFlatMap &other);
+    int remove(const Key &key);
+    T take(const Key &key);
+    iterator erase(iterator it);
+
+private:
+    int lowerBoundIndex(const Key &key) const
+    {
+        // a binary search whose steps don't branch on the outcome of the
+        // comparisons, which would be mispredicted half of the time
+        const Key *first = k.constData();
+        const Key *base = first;
+        int n = k.size();
+        if (!n)
+            return 0;
+        while (n > 1) {
+            const int half = n / 2;
+            base += half * int(*(base + half - 1) < key);
+            n -= half;
+        }
+        return int(base - first) + (*base < key);
+    }
+    int upperBoundIndex(const Key &key) const
+    { return int(std::upper_bound(k.constBegin(), k.constEnd(), key) - k.constBegin()); }
+    int indexOf(const Key &key) const
+    {
+        const int i = lowerBoundIndex(key);
+        return (i < k.size() && !(key < k.at(i))) ? i : -1;
+    }
+    iterator iteratorAt(int i) { return i == -1 ? end() : begin() + i; }
+    const_iterator constIteratorAt(int i) const { return i == -1 ? end() : begin() + i; }
+
+    QVector<Key> k;
+    QVector<T> v;
+};
+
+/*
+    Builds the map from \a keys and \a values, which don't have to be
+    sorted. The result is the same as inserting the pairs one by one: of
+    equal keys the first one is kept, with the value of the last one.
+*/
+template <class Key, class T>
+QFlatMap<Key, T>::QFlatMap(const QVector<Key> &keys, const QVector<T> &values)
+{
+    Q_ASSERT(keys.size() == values.size());
+    const int n = keys.size();
+    QVector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+        return keys.at(a) < keys.at(b);
+    });
+
+    k.reserve(n);
+    v.reserve(n);
+    for (int i = 0; i < n; ) {
+        int j = i + 1;
+        while (j < n && !(keys.at(order.at(i)) < keys.at(order.at(j))))
+            ++j;
+        k.append(keys.at(order.at(i)));
+        v.append(values.at(order.at(j - 1)));
+        i = j;
+    }
+}
+
+template <class Key, class T>
+T &QFlatMap<Key, T>::operator[](const Key &key)
+{
+    const int i = lowerBoundIndex(key);
+    if (i == k.size() || key < k.at(i)) {
+        k.insert(i, key);
+        v.insert(i, T());
+    }
+    return v[i];
+}
+
+template <class Key, class T>
+typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::insert(const Key &key, const T &value)
+{
+    const int i = lowerBoundIndex(key);
+    if (i == k.size() || key < k.at(i)) {
+        k.insert(i, key);
+        v.insert(i, value);
+    } else {
+        v[i] = value;
+    }
+    return begin() + i;
+}
+
+/*
+    Inserts all entries of \a other, in time linear in the size of both
+    maps. Where both maps have a key, the value of \a other is kept.
+*/
+template <class Key, class T>
+void QFlatMap<Key, T>::insert(const QFlatMap &other)
+{
+    if (other.isEmpty())
+        return;
+    if (isEmpty()) {
+        *this = other;
+        return;
+    }
+    if (k.constLast() < other.k.constFirst()) {
+        k += other.k;
+        v += other.v;
+        return;
+    }
+
+    QVector<Key> keys;
+    QVector<T> values;
+    keys.reserve(size() + other.size());
+    values.reserve(size() + other.size());
+    int i = 0;
+    int j = 0;
+    while (i < size() && j < other.size()) {
+        if (k.at(i) < other.k.at(j)) {
+            keys.append(k.at(i));
+            values.append(v.at(i));
+            ++i;
+        } else {
+            if (!(other.k.at(j) < k.at(i)))
+                keys.append(k.at(i++));
+            else
+                keys.append(other.k.at(j));
+            values.append(other.v.at(j));
+            ++j;
+        }
+    }
+    for ( ; i < size(); ++i) {
+        keys.append(k.at(i));
+        values.append(v.at(i));
+    }
+    for ( ; j < other.size(); ++j) {
+        keys.append(other.k.at(j));
+        values.append(other.v.at(j));
+    }
+    k.swap(keys);
+    v.swap(values);
+}
+
+template <class Key, class T>
+int QFlatMap<Key, T>::remove(const Key &key)
+{
+    const int i = indexOf(key);
+    if (i == -1)
+        return 0;
+    k.remove(i);
+    v.remove(i);
+    return 1;
+}
+
+template <class Key, class T>
+T QFlatMap<Key, T>::take(const Key &key)
+{
+    const int i = indexOf(key);
+    if (i == -1)
+        return T();
+    T t = v.takeAt(i);
+    k.remove(i);
+    return t;
+}
+
+template <class Key, class T>
+typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::erase(iterator it)
+{
+    const int i = int(it.k - k.constData());
+    Q_ASSERT(i >= 0 && i < size());
+    k.remove(i);
+    v.remove(i);
+    return begin() + i;
+}
+
+QT_END_NAMESPACE
+
+#endif // QFLATMAP_P_H
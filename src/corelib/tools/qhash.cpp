@@ -197,10 +197,116 @@ static uint crc32(...)
 }
 #endif
 
+#if QT_COMPILER_SUPPORTS_HERE(AES) && QT_COMPILER_SUPPORTS_HERE(SSE4_2)
+static inline bool hasFastAesHash()
+{
+    return qCpuHasFeature(AES) && qCpuHasFeature(SSE4_2);
+}
+
+/*
+    Hashes 16 bytes at a time: each block is XORed into the state, which
+    then goes through two AES rounds. Two rounds are the minimum for every
+    byte of the state to depend on every byte of the block. Longer keys are
+    consumed by two (from 32 bytes) or four (from 64 bytes) independent
+    states, so that their rounds overlap in the pipeline. The tail is read
+    with loads overlapping the previous block, never beyond the end of the
+    data; the length is part of the key, so that overlapping doesn't make
+    keys of different lengths collide.
+*/
+QT_FUNCTION_TARGET(AES)
+static inline __m128i aesHashBlock(__m128i state, __m128i block, __m128i key)
+{
+    state = _mm_xor_si128(state, block);
+    state = _mm_aesenc_si128(state, key);
+    return _mm_aesenc_si128(state, key);
+}
+
+QT_FUNCTION_TARGET(AES)
+static inline __m128i aesHashLoad(const uchar *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+QT_FUNCTION_TARGET(AES)
+static inline __m128i aesHashLoadShort(const uchar *p, size_t len)
+{
+    // 0 < len < 16: the loads below cover all bytes once or twice
+    if (len >= 8)
+        return _mm_set_epi64x(qFromUnaligned<qint64>(p + len - 8), qFromUnaligned<qint64>(p));
+    if (len >= 4)
+        return _mm_set_epi32(0, 0, qFromUnaligned<int>(p + len - 4), qFromUnaligned<int>(p));
+    return _mm_cvtsi32_si128(p[0] | (p[len / 2] << 8) | (p[len - 1] << 16));
+}
+
+QT_FUNCTION_TARGET(AES)
+static uint aesHash(const uchar *p, size_t len, uint seed)
+{
+    // like the other implementations, hashing nothing returns the seed
+    if (!len)
+        return seed;
+
+    const uchar *const e = p + len;
+    const __m128i key = _mm_xor_si128(_mm_set1_epi32(int(seed)),
+                                      _mm_set_epi64x(qint64(len), Q_INT64_C(0x1f83d9abfb41bd6b)));
+    __m128i state0 = key;
+    __m128i state1 = _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 1, 2, 3));
+
+    if (len >= 64) {
+        __m128i state2 = _mm_shuffle_epi32(key, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128i state3 = _mm_shuffle_epi32(key, _MM_SHUFFLE(2, 3, 0, 1));
+        for ( ; p + 64 <= e; p += 64) {
+            state0 = aesHashBlock(state0, aesHashLoad(p), key);
+            state1 = aesHashBlock(state1, aesHashLoad(p + 16), key);
+            state2 = aesHashBlock(state2, aesHashLoad(p + 32), key);
+            state3 = aesHashBlock(state3, aesHashLoad(p + 48), key);
+        }
+        if (p != e) {
+            state0 = aesHashBlock(state0, aesHashLoad(e - 64), key);
+            state1 = aesHashBlock(state1, aesHashLoad(e - 48), key);
+            state2 = aesHashBlock(state2, aesHashLoad(e - 32), key);
+            state3 = aesHashBlock(state3, aesHashLoad(e - 16), key);
+        }
+        state0 = _mm_xor_si128(state0, state2);
+        state1 = _mm_xor_si128(state1, state3);
+    } else if (len >= 32) {
+        for ( ; p + 32 <= e; p += 32) {
+            state0 = aesHashBlock(state0, aesHashLoad(p), key);
+            state1 = aesHashBlock(state1, aesHashLoad(p + 16), key);
+        }
+        if (p != e) {
+            state0 = aesHashBlock(state0, aesHashLoad(e - 32), key);
+            state1 = aesHashBlock(state1, aesHashLoad(e - 16), key);
+        }
+    } else if (len >= 16) {
+        state0 = aesHashBlock(state0, aesHashLoad(p), key);
+        state1 = aesHashBlock(state1, aesHashLoad(e - 16), key);
+    } else {
+        state0 = aesHashBlock(state0, aesHashLoadShort(p, len), key);
+    }
+
+    // the same two rounds again, to spread all of both states into the result
+    const __m128i result = aesHashBlock(state0, state1, key);
+    return uint(_mm_cvtsi128_si32(result));
+}
+#else
+static inline bool hasFastAesHash()
+{
+    return false;
+}
+
+static uint aesHash(...)
+{
+    Q_UNREACHABLE();
+    return 0;
+}
+#endif
+
 static inline uint hash(const uchar *p, size_t len, uint seed) Q_DECL_NOTHROW
 {
     uint h = seed;
 
+    if (seed && hasFastAesHash())
+        return aesHash(p, len, seed);
     if (seed && hasFastCrc32())
         return crc32(p, len, h);
 
@@ -219,6 +325,8 @@ static inline uint hash(const QChar *p, size_t len, uint seed) Q_DECL_NOTHROW
 {
     uint h = seed;
 
+    if (seed && hasFastAesHash())
+        return aesHash(reinterpret_cast<const uchar *>(p), len * sizeof(QChar), seed);
     if (seed && hasFastCrc32())
         return crc32(p, len, h);
 
@@ -57,6 +57,7 @@
 #include "qlocale_p.h"
 #include "qstringbuilder.h"
 #include "qstringmatcher.h"
+#include "qstringsearch_p.h"
 #include "qvarlengtharray.h"
 #include "qtools_p.h"
 #include "qdebug.h"
@@ -3511,6 +3512,15 @@ int qFindString(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle0[0], from, cs);
 
+    /*
+        Short needles are searched for with SIMD kernels that check a
+        block of positions at a time.
+    */
+    if (cs == Qt::CaseSensitive && sl < QtPrivate::ShortNeedleSearchLimit) {
+        return int(QtPrivate::findShortNeedle(reinterpret_cast<const ushort *>(haystack0), l, qMax(from, 0),
+                                              reinterpret_cast<const ushort *>(needle0), sl));
+    }
+
     /*
         We use the Boyer-Moore algorithm in cases where the overhead
         for the skip table should pay off, otherwise we use a simple
@@ -0,0 +1,239 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSTRINGSEARCH_P_H
+#define QSTRINGSEARCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of internal files.  This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+/*
+    Case-sensitive search for needles of at least two characters, for both
+    QString (ushort) and QByteArray (uchar) data.
+
+    The kernels compare a block of candidate positions at once with the
+    first and with the last character of the needle, and compare the rest
+    of the needle only at positions where both match. Unlike a Boyer-Moore
+    search, this needs no skip table, so it pays off from the first block
+    on; Boyer-Moore still wins for long needles, whose skips get long.
+
+    All functions take the last position at which a match can start, so
+    that loading a block at the last character never reads past the end of
+    the haystack.
+*/
+enum { ShortNeedleSearchLimit = 32 };
+
+template <typename Char>
+inline bool needleMatchesAt(const Char *p, const Char *needle, qsizetype needleLen)
+{
+    // the first and last characters are known to match
+    return memcmp(p + 1, needle + 1, (needleLen - 2) * sizeof(Char)) == 0;
+}
+
+template <typename Char>
+qsizetype findShortNeedleScalar(const Char *haystack, qsizetype from, qsizetype last,
+                                const Char *needle, qsizetype needleLen)
+{
+    const Char first = needle[0];
+    const Char lastChar = needle[needleLen - 1];
+    for (qsizetype i = from; i <= last; ++i) {
+        if (haystack[i] == first && haystack[i + needleLen - 1] == lastChar
+                && needleMatchesAt(haystack + i, needle, needleLen))
+            return i;
+    }
+    return -1;
+}
+
+#if defined(__SSE2__)
+template <typename Char>
+qsizetype findShortNeedleSse2(const Char *haystack, qsizetype from, qsizetype last,
+                              const Char *needle, qsizetype needleLen)
+{
+    const qsizetype step = sizeof(__m128i) / sizeof(Char);
+    const __m128i first = sizeof(Char) == 1 ? _mm_set1_epi8(char(needle[0]))
+                                            : _mm_set1_epi16(short(needle[0]));
+    const __m128i lastChar = sizeof(Char) == 1 ? _mm_set1_epi8(char(needle[needleLen - 1]))
+                                               : _mm_set1_epi16(short(needle[needleLen - 1]));
+
+    qsizetype i = from;
+    for ( ; i + step - 1 <= last; i += step) {
+        const __m128i atFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i));
+        const __m128i atLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i + needleLen - 1));
+        const __m128i matches = sizeof(Char) == 1
+                ? _mm_and_si128(_mm_cmpeq_epi8(atFirst, first), _mm_cmpeq_epi8(atLast, lastChar))
+                : _mm_and_si128(_mm_cmpeq_epi16(atFirst, first), _mm_cmpeq_epi16(atLast, lastChar));
+
+        // one bit per byte, so a QChar sets two of them
+        uint mask = _mm_movemask_epi8(matches);
+        while (mask) {
+            const uint bit = qCountTrailingZeroBits(mask);
+            const qsizetype pos = i + bit / sizeof(Char);
+            if (needleMatchesAt(haystack + pos, needle, needleLen))
+                return pos;
+            mask &= ~(((1U << sizeof(Char)) - 1) << bit);
+        }
+    }
+    return findShortNeedleScalar(haystack, i, last, needle, needleLen);
+}
+#endif
+
+#if defined(__SSE2__) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+template <typename Char>
+QT_FUNCTION_TARGET(AVX2)
+qsizetype findShortNeedleAvx2(const Char *haystack, qsizetype from, qsizetype last,
+                              const Char *needle, qsizetype needleLen)
+{
+    const qsizetype step = sizeof(__m256i) / sizeof(Char);
+    const __m256i first = sizeof(Char) == 1 ? _mm256_set1_epi8(char(needle[0]))
+                                            : _mm256_set1_epi16(short(needle[0]));
+    const __m256i lastChar = sizeof(Char) == 1 ? _mm256_set1_epi8(char(needle[needleLen - 1]))
+                                               : _mm256_set1_epi16(short(needle[needleLen - 1]));
+
+    qsizetype i = from;
+    for ( ; i + step - 1 <= last; i += step) {
+        const __m256i atFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i));
+        const __m256i atLast = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i + needleLen - 1));
+        const __m256i matches = sizeof(Char) == 1
+                ? _mm256_and_si256(_mm256_cmpeq_epi8(atFirst, first), _mm256_cmpeq_epi8(atLast, lastChar))
+                : _mm256_and_si256(_mm256_cmpeq_epi16(atFirst, first), _mm256_cmpeq_epi16(atLast, lastChar));
+
+        uint mask = _mm256_movemask_epi8(matches);
+        while (mask) {
+            const uint bit = qCountTrailingZeroBits(mask);
+            const qsizetype pos = i + bit / sizeof(Char);
+            if (needleMatchesAt(haystack + pos, needle, needleLen))
+                return pos;
+            mask &= ~(((1U << sizeof(Char)) - 1) << bit);
+        }
+    }
+    // the rest is shorter than a 256-bit block
+    return findShortNeedleSse2(haystack, i, last, needle, needleLen);
+}
+#endif
+
+#if defined(__ARM_NEON__)
+inline bool hasNeedleCandidates(const uchar *atFirst, const uchar *atLast, uint8x16_t first, uint8x16_t lastChar)
+{
+    const uint8x16_t matches = vandq_u8(vceqq_u8(vld1q_u8(atFirst), first),
+                                        vceqq_u8(vld1q_u8(atLast), lastChar));
+    const uint64x2_t halves = vreinterpretq_u64_u8(matches);
+    return (vgetq_lane_u64(halves, 0) | vgetq_lane_u64(halves, 1)) != 0;
+}
+
+inline bool hasNeedleCandidates(const ushort *atFirst, const ushort *atLast, uint16x8_t first, uint16x8_t lastChar)
+{
+    const uint16x8_t matches = vandq_u16(vceqq_u16(vld1q_u16(atFirst), first),
+                                         vceqq_u16(vld1q_u16(atLast), lastChar));
+    const uint64x2_t halves = vreinterpretq_u64_u16(matches);
+    return (vgetq_lane_u64(halves, 0) | vgetq_lane_u64(halves, 1)) != 0;
+}
+
+inline uint8x16_t neonSplat(uchar c) { return vdupq_n_u8(c); }
+inline uint16x8_t neonSplat(ushort c) { return vdupq_n_u16(c); }
+
+template <typename Char>
+qsizetype findShortNeedleNeon(const Char *haystack, qsizetype from, qsizetype last,
+                              const Char *needle, qsizetype needleLen)
+{
+    // NEON has no movemask, so blocks with candidates are rescanned one by one
+    const qsizetype step = 16 / sizeof(Char);
+    const auto first = neonSplat(needle[0]);
+    const auto lastChar = neonSplat(needle[needleLen - 1]);
+
+    qsizetype i = from;
+    for ( ; i + step - 1 <= last; i += step) {
+        if (!hasNeedleCandidates(haystack + i, haystack + i + needleLen - 1, first, lastChar))
+            continue;
+        const qsizetype pos = findShortNeedleScalar(haystack, i, i + step - 1, needle, needleLen);
+        if (pos != -1)
+            return pos;
+    }
+    return findShortNeedleScalar(haystack, i, last, needle, needleLen);
+}
+#endif
+
+/*
+    Returns the position of the first match of \a needle in \a haystack
+    at or after \a from, or -1. \a needleLen must be at least 2 and
+    \a from + \a needleLen at most \a haystackLen.
+*/
+template <typename Char>
+qsizetype findShortNeedle(const Char *haystack, qsizetype haystackLen, qsizetype from,
+                          const Char *needle, qsizetype needleLen)
+{
+    Q_ASSERT(needleLen >= 2);
+    Q_ASSERT(from >= 0 && from + needleLen <= haystackLen);
+    const qsizetype last = haystackLen - needleLen;
+
+#if defined(__SSE2__) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        return findShortNeedleAvx2(haystack, from, last, needle, needleLen);
+#endif
+#if defined(__SSE2__)
+    return findShortNeedleSse2(haystack, from, last, needle, needleLen);
+#elif defined(__ARM_NEON__)
+    return findShortNeedleNeon(haystack, from, last, needle, needleLen);
+#else
+    return findShortNeedleScalar(haystack, from, last, needle, needleLen);
+#endif
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QSTRINGSEARCH_P_H
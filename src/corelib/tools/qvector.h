@@ -359,11 +359,11 @@ inline QVector<T>::QVector(const QVector<T> &v)
         d = v.d;
     } else {
         if (v.d->capacityReserved) {
-            d = Data::allocate(v.d->alloc);
+            d = Data::allocate(v.d->alloc, QArrayData::AllowArena);
             Q_CHECK_PTR(d);
             d->capacityReserved = true;
         } else {
-            d = Data::allocate(v.d->size);
+            d = Data::allocate(v.d->size, QArrayData::AllowArena);
             Q_CHECK_PTR(d);
         }
         if (d->alloc) {
@@ -485,7 +485,7 @@ QVector<T>::QVector(int asize)
 {
     Q_ASSERT_X(asize >= 0, "QVector::QVector", "Size must be greater than or equal to 0.");
     if (Q_LIKELY(asize > 0)) {
-        d = Data::allocate(asize);
+        d = Data::allocate(asize, QArrayData::AllowArena);
         Q_CHECK_PTR(d);
         d->size = asize;
         defaultConstruct(d->begin(), d->end());
@@ -499,7 +499,7 @@ QVector<T>::QVector(int asize, const T &t)
 {
     Q_ASSERT_X(asize >= 0, "QVector::QVector", "Size must be greater than or equal to 0.");
     if (asize > 0) {
-        d = Data::allocate(asize);
+        d = Data::allocate(asize, QArrayData::AllowArena);
         Q_CHECK_PTR(d);
         d->size = asize;
         T* i = d->end();
@@ -520,7 +520,7 @@ template <typename T>
 QVector<T>::QVector(std::initializer_list<T> args)
 {
     if (args.size() > 0) {
-        d = Data::allocate(args.size());
+        d = Data::allocate(args.size(), QArrayData::AllowArena);
         Q_CHECK_PTR(d);
         // std::initializer_list<T>::iterator is guaranteed to be
         // const T* ([support.initlist]/1), so can be memcpy'ed away from by copyConstruct
@@ -554,6 +554,11 @@ void QVector<T>::reallocData(const int asize, const int aalloc, QArrayData::Allo
     Data *x = d;
 
     const bool isShared = d->ref.isShared();
+#if !defined(QT_NO_UNSHARABLE_CONTAINERS)
+    // buffers on the heap stay there, only new and arena ones use the current arena
+    if (!d->alloc || !d->ref.isSharable())
+        options |= QArrayData::AllowArena;
+#endif
 
     if (aalloc != 0) {
         if (aalloc != int(d->alloc) || isShared) {
@@ -563,7 +568,8 @@ void QVector<T>::reallocData(const int asize, const int aalloc, QArrayData::Allo
                 Q_CHECK_PTR(x);
                 // aalloc is bigger then 0 so it is not [un]sharedEmpty
 #if !defined(QT_NO_UNSHARABLE_CONTAINERS)
-                Q_ASSERT(x->ref.isSharable() || options.testFlag(QArrayData::Unsharable));
+                Q_ASSERT(x->ref.isSharable() || options.testFlag(QArrayData::Unsharable)
+                         || options.testFlag(QArrayData::AllowArena));
 #endif
                 Q_ASSERT(!x->ref.isStatic());
                 x->size = asize;
@@ -23,6 +23,7 @@ HEADERS +=  \
         tools/qdatetime_p.h \
         tools/qdoublescanprint_p.h \
         tools/qeasingcurve.h \
+        tools/qflatmap_p.h \
         tools/qfreelist_p.h \
         tools/qhash.h \
         tools/qhashfunctions.h \
@@ -38,6 +39,8 @@ HEADERS +=  \
         tools/qmargins.h \
         tools/qmessageauthenticationcode.h \
         tools/qcontiguouscache.h \
+        tools/qcontainerarena.h \
+        tools/qcontainerarena_p.h \
         tools/qpair.h \
         tools/qpoint.h \
         tools/qqueue.h \
@@ -63,6 +66,7 @@ HEADERS +=  \
         tools/qstringlist.h \
         tools/qstringliteral.h \
         tools/qstringmatcher.h \
+        tools/qstringsearch_p.h \
         tools/qstringview.h \
         tools/qtextboundaryfinder.h \
         tools/qtimeline.h \
@@ -96,6 +100,7 @@ SOURCES += \
         tools/qmargins.cpp \
         tools/qmessageauthenticationcode.cpp \
         tools/qcontiguouscache.cpp \
+        tools/qcontainerarena.cpp \
         tools/qrect.cpp \
         tools/qregexp.cpp \
         tools/qrefcount.cpp \
@@ -73,6 +73,7 @@ SOURCES += \
            ../../corelib/tools/qbytearraymatcher.cpp \
            ../../corelib/tools/qcommandlineparser.cpp \
            ../../corelib/tools/qcommandlineoption.cpp \
+           ../../corelib/tools/qcontainerarena.cpp \
            ../../corelib/tools/qcryptographichash.cpp \
            ../../corelib/tools/qdatetime.cpp \
            ../../corelib/tools/qhash.cpp \
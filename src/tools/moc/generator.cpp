@@ -36,6 +36,7 @@
 #include <QtCore/qjsonvalue.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qplugin.h>
+#include <QtCore/qset.h>
 #include <stdio.h>
 
 #include <private/qmetaobject_p.h> //for the flags.
@@ -372,6 +373,8 @@ void Generator::generateCode()
         index += 4 + (cdef->enumList.at(i).values.count() * 2);
     fprintf(out, "    %4d, %4d, // constructors\n", isConstructible ? cdef->constructorList.count() : 0,
             isConstructible ? index : 0);
+    if (isConstructible)
+        index += cdef->constructorList.count() * 5;
 
     int flags = 0;
     if (cdef->hasQGadget) {
@@ -381,6 +384,7 @@ void Generator::generateCode()
     }
     fprintf(out, "    %4d,       // flags\n", flags);
     fprintf(out, "    %4d,       // signalCount\n", cdef->signalList.count());
+    fprintf(out, "    %4d,       // method hash\n", methodCount ? index : 0);
 
 
 //
@@ -437,6 +441,11 @@ void Generator::generateCode()
     if (isConstructible)
         generateFunctions(cdef->constructorList, "constructor", MethodConstructor, paramsIndex);
 
+//
+// Build method name hash table
+//
+    generateMethodHashTable();
+
 //
 // Terminate data array
 //
@@ -723,6 +732,80 @@ void Generator::generateFunctionRevisions(const QVector<FunctionDef>& list, cons
     }
 }
 
+static void appendMethodNames(QVector<QByteArray> &names, const QVector<FunctionDef> &list)
+{
+    for (const FunctionDef &f : list)
+        names.append(f.name);
+}
+
+void Generator::generateMethodHashTable()
+{
+    QVector<QByteArray> names;
+    appendMethodNames(names, cdef->signalList);
+    appendMethodNames(names, cdef->slotList);
+    appendMethodNames(names, cdef->methodList);
+    if (names.isEmpty())
+        return;
+
+    const QSet<QByteArray> distinctNames = QSet<QByteArray>::fromList(names.toList());
+    uint bucketCount = 2;
+    while (bucketCount < 2 * uint(distinctNames.count()))
+        bucketCount <<= 1;
+
+    // Look for a seed with which no two names share a bucket, which makes
+    // the table a perfect hash; if there is none, take the one with the
+    // fewest collisions.
+    uint seed = 0;
+    int fewestCollisions = distinctNames.count();
+    QVector<bool> usedBuckets(bucketCount);
+    for (uint candidate = 0; candidate < 256 && fewestCollisions; ++candidate) {
+        usedBuckets.fill(false);
+        int collisions = 0;
+        for (const QByteArray &name : distinctNames) {
+            const uint bucket = QMetaObjectPrivate::methodNameHash(name.constData(), name.size(), candidate)
+                    & (bucketCount - 1);
+            if (usedBuckets.at(bucket))
+                ++collisions;
+            usedBuckets[bucket] = true;
+        }
+        if (collisions < fewestCollisions) {
+            fewestCollisions = collisions;
+            seed = candidate;
+        }
+    }
+
+    QVector<QVector<int> > buckets(bucketCount);
+    for (int i = names.count() - 1; i >= 0; --i) {
+        const QByteArray &name = names.at(i);
+        buckets[QMetaObjectPrivate::methodNameHash(name.constData(), name.size(), seed)
+                & (bucketCount - 1)].append(i);
+    }
+
+    QVector<int> offsets;
+    QVector<int> indexes;
+    for (const QVector<int> &bucket : qAsConst(buckets)) {
+        offsets.append(indexes.count());
+        indexes += bucket;
+    }
+    offsets.append(indexes.count());
+
+    fprintf(out, "\n // method name hash: bucket count, seed, bucket offsets, method indexes\n");
+    fprintf(out, "    %4u, %4u,\n", bucketCount, seed);
+    generateIntList(offsets);
+    generateIntList(indexes);
+}
+
+void Generator::generateIntList(const QVector<int> &list)
+{
+    for (int i = 0; i < list.count(); ++i) {
+        if (i % 8 == 0)
+            fprintf(out, "   ");
+        fprintf(out, " %4d,", list.at(i));
+        if (i % 8 == 7 || i == list.count() - 1)
+            fprintf(out, "\n");
+    }
+}
+
 void Generator::generateFunctionParameters(const QVector<FunctionDef>& list, const char *functype)
 {
     if (list.isEmpty())
@@ -0,0 +1,220 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtconcurrentalgorithms.h>
+
+#include <QtTest/QtTest>
+
+#include <algorithm>
+#include <list>
+#include <numeric>
+
+class tst_QtConcurrentAlgorithms: public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void sort_data();
+    void sort();
+    void sortWithLessThan();
+    void inclusiveScan_data();
+    void inclusiveScan();
+    void inclusiveScanWithOperation();
+    void transformReduce_data();
+    void transformReduce();
+    void transformReduceWithoutRandomAccess();
+};
+
+void tst_QtConcurrentAlgorithms::initTestCase()
+{
+    // split the sequences into several chunks even on machines with few cores
+    QThreadPool::globalInstance()->setMaxThreadCount(4);
+}
+
+static QVector<int> randomInts(int count)
+{
+    QVector<int> ints;
+    ints.reserve(count);
+    quint32 value = 1;
+    for (int i = 0; i < count; ++i) {
+        value = value * 1103515245 + 12345;
+        ints << int(value >> 8) % 1000;
+    }
+    return ints;
+}
+
+static void addCountRows()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("empty") << 0;
+    QTest::newRow("one") << 1;
+    QTest::newRow("small") << 100;
+    QTest::newRow("one chunk") << 2047;
+    QTest::newRow("uneven chunks") << 10001;
+    QTest::newRow("large") << 100000;
+}
+
+void tst_QtConcurrentAlgorithms::sort_data()
+{
+    addCountRows();
+}
+
+void tst_QtConcurrentAlgorithms::sort()
+{
+    QFETCH(int, count);
+
+    const QVector<int> input = randomInts(count);
+    QVector<int> expected = input;
+    std::sort(expected.begin(), expected.end());
+
+    QVector<int> ints = input;
+    QtConcurrent::sort(ints).waitForFinished();
+    QCOMPARE(ints, expected);
+
+    ints = input;
+    QtConcurrent::blockingSort(ints);
+    QCOMPARE(ints, expected);
+
+    ints = input;
+    QtConcurrent::sort(ints.begin(), ints.end()).waitForFinished();
+    QCOMPARE(ints, expected);
+
+    ints = input;
+    const QVector<int>::iterator begin = ints.begin();
+    const QVector<int>::iterator end = ints.end();
+    QtConcurrent::blockingSort(begin, end);
+    QCOMPARE(ints, expected);
+
+    ints = input;
+    QtConcurrent::blockingSort(ints.begin(), ints.end(), std::less<int>());
+    QCOMPARE(ints, expected);
+}
+
+void tst_QtConcurrentAlgorithms::sortWithLessThan()
+{
+    QStringList strings;
+    for (int i : randomInts(5000))
+        strings << QString::number(i);
+
+    QStringList expected = strings;
+    std::sort(expected.begin(), expected.end(), std::greater<QString>());
+
+    QtConcurrent::sort(strings, [](const QString &a, const QString &b) { return a > b; })
+            .waitForFinished();
+    QCOMPARE(strings, expected);
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan_data()
+{
+    addCountRows();
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan()
+{
+    QFETCH(int, count);
+
+    const QVector<int> input = randomInts(count);
+    QVector<int> expected = input;
+    std::partial_sum(expected.begin(), expected.end(), expected.begin());
+
+    QVector<int> ints = input;
+    QtConcurrent::inclusiveScan(ints).waitForFinished();
+    QCOMPARE(ints, expected);
+
+    ints = input;
+    QtConcurrent::blockingInclusiveScan(ints);
+    QCOMPARE(ints, expected);
+
+    ints = input;
+    QtConcurrent::blockingInclusiveScan(ints.begin(), ints.end(), std::plus<int>());
+    QCOMPARE(ints, expected);
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScanWithOperation()
+{
+    const QVector<int> input = randomInts(50000);
+    QVector<int> expected = input;
+    const auto maximum = [](int a, int b) { return qMax(a, b); };
+    std::partial_sum(expected.begin(), expected.end(), expected.begin(), maximum);
+
+    QVector<int> ints = input;
+    QtConcurrent::blockingInclusiveScan(ints, maximum);
+    QCOMPARE(ints, expected);
+
+    // not commutative: each item keeps the first value seen so far
+    QVector<QString> strings;
+    for (int i = 0; i < 5000; ++i)
+        strings << QString::number(i);
+    QtConcurrent::blockingInclusiveScan(strings, [](const QString &a, const QString &b) {
+        return a.isEmpty() ? b : a;
+    });
+    QCOMPARE(strings.count(QLatin1String("0")), 5000);
+}
+
+static qint64 square(const int &i)
+{
+    return qint64(i) * i;
+}
+
+void tst_QtConcurrentAlgorithms::transformReduce_data()
+{
+    addCountRows();
+}
+
+void tst_QtConcurrentAlgorithms::transformReduce()
+{
+    QFETCH(int, count);
+
+    const QVector<int> ints = randomInts(count);
+    qint64 expected = 42;
+    for (int i : ints)
+        expected += square(i);
+
+    QFuture<qint64> future = QtConcurrent::transformReduce(ints, qint64(42), std::plus<qint64>(), square);
+    QCOMPARE(future.result(), expected);
+
+    QCOMPARE(QtConcurrent::blockingTransformReduce(ints, qint64(42), std::plus<qint64>(), square),
+             expected);
+    QCOMPARE(QtConcurrent::blockingTransformReduce(ints.constBegin(), ints.constEnd(), qint64(42),
+                                                   std::plus<qint64>(), square),
+             expected);
+}
+
+void tst_QtConcurrentAlgorithms::transformReduceWithoutRandomAccess()
+{
+    const QVector<int> ints = randomInts(1000);
+    const std::list<int> list(ints.constBegin(), ints.constEnd());
+
+    const int expected = *std::max_element(ints.constBegin(), ints.constEnd());
+    const auto maximum = [](int a, int b) { return qMax(a, b); };
+    const auto identity = [](int i) { return i; };
+    QCOMPARE(QtConcurrent::blockingTransformReduce(list, -1, maximum, identity), expected);
+}
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+#include "tst_qtconcurrentalgorithms.moc"
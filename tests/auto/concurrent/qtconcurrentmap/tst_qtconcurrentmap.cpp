@@ -53,6 +53,9 @@ private slots:
     void exceptions();
 #endif
     void incrementalResults();
+    void contiguousResults();
+    void partitioning_data();
+    void partitioning();
     void noDetach();
     void stlContainers();
     void qFutureAssignmentLeak();
@@ -2308,6 +2311,84 @@ void tst_QtConcurrentMap::incrementalResults()
     QCOMPARE(future.results().count(), count);
 }
 
+QString numberToString(const int &i)
+{
+    return QString::number(i);
+}
+
+void tst_QtConcurrentMap::contiguousResults()
+{
+    const int count = 10000;
+    QVector<int> ints;
+    std::list<int> intList;
+    for (int i = 0; i < count; ++i) {
+        ints << i;
+        intList.push_back(i);
+    }
+
+    // random access input: the results are written in place into the store
+    QFuture<QString> future = QtConcurrent::mapped(ints, numberToString);
+    future.waitForFinished();
+    QCOMPARE(future.resultCount(), count);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(future.resultAt(i), QString::number(i));
+
+    int i = 0;
+    for (const QString &result : future) {
+        QCOMPARE(result, QString::number(i));
+        ++i;
+    }
+    QCOMPARE(i, count);
+
+    // input without random access reports the results one by one
+    QFuture<QString> listFuture = QtConcurrent::mapped(intList, numberToString);
+    QCOMPARE(listFuture.results(), future.results());
+}
+
+Q_DECLARE_METATYPE(QtConcurrent::Partitioning)
+
+void tst_QtConcurrentMap::partitioning_data()
+{
+    QTest::addColumn<QtConcurrent::Partitioning>("partitioning");
+    QTest::addColumn<int>("count");
+
+    const int counts[] = { 0, 1, 7, 1000 };
+    for (int count : counts) {
+        QTest::addRow("adaptive %d", count) << QtConcurrent::AdaptivePartitioning << count;
+        QTest::addRow("static %d", count) << QtConcurrent::StaticPartitioning << count;
+        QTest::addRow("guided %d", count) << QtConcurrent::GuidedPartitioning << count;
+    }
+}
+
+void tst_QtConcurrentMap::partitioning()
+{
+    QFETCH(QtConcurrent::Partitioning, partitioning);
+    QFETCH(int, count);
+
+    QVector<int> ints;
+    QVector<int> expected;
+    for (int i = 0; i < count; ++i) {
+        ints << i;
+        expected << 2 * i;
+    }
+
+    // every item is visited exactly once
+    QVector<int> inPlace = ints;
+    QtConcurrent::blockingMap(inPlace, multiplyBy2InPlace, partitioning);
+    QCOMPARE(inPlace, expected);
+
+    inPlace = ints;
+    QtConcurrent::map(inPlace.begin(), inPlace.end(), multiplyBy2InPlace, partitioning)
+            .waitForFinished();
+    QCOMPARE(inPlace, expected);
+
+    QFuture<int> future = QtConcurrent::mapped(ints, multiplyBy2, partitioning);
+    QCOMPARE(future.results().toVector(), expected);
+
+    future = QtConcurrent::mapped(ints.constBegin(), ints.constEnd(), multiplyBy2, partitioning);
+    QCOMPARE(future.results().toVector(), expected);
+}
+
 /*
     Test that mapped does not cause deep copies when holding
     references to Qt containers.
@@ -33,6 +33,7 @@
 #include <QtTest/QtTest>
 
 #include <private/qcoreapplication_p.h>
+#include <private/qcoreevent_p.h>
 #include <private/qeventloop_p.h>
 #include <private/qthread_p.h>
 
@@ -930,6 +931,377 @@ void tst_QCoreApplication::threadedEventDelivery()
     QCOMPARE(receiver.recordedEvents.contains(QEvent::User + 1), eventsReceived);
 }
 
+class SequencedEvent : public QEvent
+{
+public:
+    SequencedEvent(int producer, int sequence)
+        : QEvent(QEvent::User), producer(producer), sequence(sequence)
+    {}
+    int producer;
+    int sequence;
+};
+
+class SequencedEventReceiver : public QObject
+{
+public:
+    explicit SequencedEventReceiver(int producers) : lastSequence(producers, -1), received(0), outOfOrder(0) {}
+    bool event(QEvent *event) override
+    {
+        if (event->type() != QEvent::User)
+            return QObject::event(event);
+        const SequencedEvent *e = static_cast<SequencedEvent *>(event);
+        if (e->sequence <= lastSequence.at(e->producer))
+            ++outOfOrder;
+        lastSequence[e->producer] = e->sequence;
+        ++received;
+        return true;
+    }
+    QVector<int> lastSequence;
+    int received;
+    int outOfOrder;
+};
+
+class SequencedEventProducer : public QThread
+{
+public:
+    SequencedEventProducer(QObject *receiver, int producer, int count)
+        : receiver(receiver), producer(producer), count(count)
+    {}
+    void run() override
+    {
+        for (int i = 0; i < count; ++i) {
+            // mix in some events that cannot take the lock-free path
+            const int priority = (i % 100 == 99) ? int(Qt::HighEventPriority) : int(Qt::NormalEventPriority);
+            if (priority == Qt::NormalEventPriority)
+                QCoreApplication::postEvent(receiver, new SequencedEvent(producer, i), priority);
+            else
+                QCoreApplication::postEvent(receiver, new QEvent(QEvent::Type(QEvent::User + 1)), priority);
+        }
+    }
+    QObject *receiver;
+    int producer;
+    int count;
+};
+
+void tst_QCoreApplication::postEventFromMultipleThreads()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    const int producerCount = 4;
+    const int eventsPerProducer = 2000;
+    const int expected = producerCount * (eventsPerProducer - eventsPerProducer / 100);
+
+    SequencedEventReceiver receiver(producerCount);
+    QVector<SequencedEventProducer *> producers;
+    for (int i = 0; i < producerCount; ++i)
+        producers.append(new SequencedEventProducer(&receiver, i, eventsPerProducer));
+    for (SequencedEventProducer *producer : qAsConst(producers))
+        producer->start();
+
+    QTRY_COMPARE(receiver.received, expected);
+    for (SequencedEventProducer *producer : qAsConst(producers))
+        QVERIFY(producer->wait());
+    qDeleteAll(producers);
+
+    // events of each producer arrive in the order they were posted
+    QCOMPARE(receiver.outOfOrder, 0);
+
+    // nothing is left behind, and removal sees events posted without the lock
+    QCoreApplication::postEvent(&receiver, new SequencedEvent(0, eventsPerProducer));
+    QCoreApplication::removePostedEvents(&receiver, QEvent::User);
+    QCoreApplication::sendPostedEvents(&receiver);
+    QCOMPARE(receiver.received, expected);
+}
+
+// no Q_OBJECT, so that nothing but the vtable tells it from QCoreApplication
+class CompressingApplication : public QCoreApplication
+{
+public:
+    CompressingApplication(int &argc, char **argv) : QCoreApplication(argc, argv) {}
+
+protected:
+    bool compressEvent(QEvent *event, QObject *receiver, QPostEventList *postedEvents) override
+    {
+        if (event->type() == QEvent::User) {
+            for (const QPostEvent &cur : qAsConst(*postedEvents)) {
+                if (cur.receiver == receiver && cur.event && cur.event->type() == QEvent::User) {
+                    delete event;
+                    return true;
+                }
+            }
+        }
+        return QCoreApplication::compressEvent(event, receiver, postedEvents);
+    }
+};
+
+class UserEventCounter : public QObject
+{
+public:
+    UserEventCounter() : received(0) {}
+    bool event(QEvent *event) override
+    {
+        if (event->type() != QEvent::User)
+            return QObject::event(event);
+        ++received;
+        return true;
+    }
+    int received;
+};
+
+void tst_QCoreApplication::compressEventReimplemented()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    CompressingApplication app(argc, argv);
+
+    // events that could be posted without the lock still go through the
+    // reimplemented compressEvent()
+    UserEventCounter receiver;
+    for (int i = 0; i < 3; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+    QCoreApplication::sendPostedEvents(&receiver);
+    QCOMPARE(receiver.received, 1);
+
+    // and so do events queued behind ones posted without the lock
+    UserEventCounter other;
+    QCoreApplication::postEvent(&other, new QEvent(QEvent::Type(QEvent::User + 1)));
+    QCoreApplication::postEvent(&other, new QEvent(QEvent::User));
+    QCoreApplication::postEvent(&other, new QEvent(QEvent::User));
+    QCoreApplication::sendPostedEvents(&other);
+    QCOMPARE(other.received, 1);
+}
+
+class PooledEvent : public QEvent
+{
+public:
+    Q_DECLARE_POOLED_EVENT
+    PooledEvent(int producer, int sequence)
+        : QEvent(QEvent::User), producer(producer), sequence(sequence)
+    {}
+    int producer;
+    int sequence;
+};
+
+class PooledEventReceiver : public QObject
+{
+public:
+    PooledEventReceiver() : received(0), corrupted(0) {}
+    bool event(QEvent *event) override
+    {
+        if (event->type() != QEvent::User)
+            return QObject::event(event);
+        const PooledEvent *e = static_cast<PooledEvent *>(event);
+        if (e->sequence != expectedSequence.value(e->producer))
+            ++corrupted;
+        expectedSequence[e->producer] = e->sequence + 1;
+        ++received;
+        return true;
+    }
+    QHash<int, int> expectedSequence;
+    int received;
+    int corrupted;
+};
+
+class PooledEventProducer : public QThread
+{
+public:
+    PooledEventProducer(QObject *receiver, int producer, int count)
+        : receiver(receiver), producer(producer), count(count)
+    {}
+    void run() override
+    {
+        for (int i = 0; i < count; ++i)
+            QCoreApplication::postEvent(receiver, new PooledEvent(producer, i));
+    }
+    QObject *receiver;
+    int producer;
+    int count;
+};
+
+void tst_QCoreApplication::pooledEvents()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+    const int allocatedBefore = QEventPool::allocatedCount();
+
+    // blocks that do not fit a pool slot come from the heap
+    void *small = QEventPool::allocate(sizeof(PooledEvent));
+    void *large = QEventPool::allocate(QEventPool::MaxEventSize + 1);
+    QVERIFY(small);
+    QVERIFY(large);
+    memset(small, 0xaa, sizeof(PooledEvent));
+    memset(large, 0x55, QEventPool::MaxEventSize + 1);
+    QCOMPARE(QEventPool::allocatedCount(), allocatedBefore + 1);
+    QEventPool::deallocate(large);
+    QEventPool::deallocate(small);
+    QCOMPARE(QEventPool::allocatedCount(), allocatedBefore);
+
+    // a released slot is the next one handed out
+    void *reused = QEventPool::allocate(sizeof(PooledEvent));
+    QCOMPARE(reused, small);
+    QEventPool::deallocate(reused);
+
+    // post more events than the pool holds before the receiver gets to run,
+    // so that some of them are allocated after the pool is exhausted
+    const int producerCount = 4;
+    const int eventsPerProducer = 3000;
+    PooledEventReceiver receiver;
+    QVector<PooledEventProducer *> producers;
+    for (int i = 0; i < producerCount; ++i)
+        producers.append(new PooledEventProducer(&receiver, i, eventsPerProducer));
+    for (PooledEventProducer *producer : qAsConst(producers))
+        producer->start();
+    for (PooledEventProducer *producer : qAsConst(producers))
+        QVERIFY(producer->wait());
+    qDeleteAll(producers);
+
+    QCoreApplication::sendPostedEvents(&receiver);
+    QCOMPARE(receiver.received, producerCount * eventsPerProducer);
+    QCOMPARE(receiver.corrupted, 0);
+    QCOMPARE(QEventPool::allocatedCount(), allocatedBefore);
+
+    // slots are reused once the events have been delivered
+    QCoreApplication::postEvent(&receiver, new PooledEvent(0, eventsPerProducer));
+    QCOMPARE(QEventPool::allocatedCount(), allocatedBefore + 1);
+    QCoreApplication::sendPostedEvents(&receiver);
+    QCOMPARE(receiver.received, producerCount * eventsPerProducer + 1);
+    QCOMPARE(receiver.corrupted, 0);
+    QCOMPARE(QEventPool::allocatedCount(), allocatedBefore);
+}
+
+void tst_QCoreApplication::deleteLaterMany()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    // children deleted before, together with and after their parent
+    QPointer<QObject> parent = new QObject;
+    QVector<QPointer<QObject> > children;
+    for (int i = 0; i < 1000; ++i)
+        children.append(new QObject(parent));
+    for (int i = children.size() - 1; i >= children.size() / 2; --i)
+        children.at(i)->deleteLater();
+    parent->deleteLater();
+    for (int i = 0; i < children.size() / 2; ++i)
+        children.at(i)->deleteLater();
+    children.first()->deleteLater();
+
+    // an object deleted directly leaves the list
+    QObject *deleted = new QObject;
+    deleted->deleteLater();
+    delete deleted;
+
+    // removing the posted events cancels the deletion
+    QObject kept;
+    kept.deleteLater();
+    QCoreApplication::removePostedEvents(&kept, QEvent::DeferredDelete);
+
+    // event filters still see the DeferredDelete event
+    EventSpy spy;
+    QPointer<QObject> filtered = new QObject;
+    filtered->installEventFilter(&spy);
+    filtered->deleteLater();
+
+    QVERIFY(parent);
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(!parent);
+    for (const QPointer<QObject> &child : qAsConst(children))
+        QVERIFY(!child);
+    QVERIFY(!filtered);
+    QCOMPARE(spy.recordedEvents, QList<int>() << QEvent::DeferredDelete);
+
+    // sending the events of one receiver deletes just that receiver
+    QPointer<QObject> one = new QObject;
+    QPointer<QObject> two = new QObject;
+    one->deleteLater();
+    two->deleteLater();
+    QCoreApplication::sendPostedEvents(one.data(), QEvent::DeferredDelete);
+    QVERIFY(!one);
+    QVERIFY(two);
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(!two);
+
+    // deleteLater() called in an event loop is not processed in a nested
+    // loop, only after returning from the loop it was called in
+    QPointer<QObject> nested = new QObject;
+    bool aliveAfterNestedLoop = false;
+    QEventLoop loop;
+    QTimer::singleShot(0, &loop, [&]() {
+        nested->deleteLater();
+        QEventLoop inner;
+        QTimer::singleShot(0, &inner, &QEventLoop::quit);
+        inner.exec();
+        QCoreApplication::processEvents();
+        aliveAfterNestedLoop = !nested.isNull();
+        loop.quit();
+    });
+    loop.exec();
+    QVERIFY(aliveAfterNestedLoop);
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(!nested);
+
+#ifndef QT_NO_THREAD
+    // the deletion follows the object to another thread
+    QThread thread;
+    thread.start();
+    QObject *moved = new QObject;
+    QSignalSpy destroyedSpy(moved, &QObject::destroyed);
+    moved->deleteLater();
+    moved->moveToThread(&thread);
+    QTRY_COMPARE(destroyedSpy.count(), 1);
+    thread.quit();
+    QVERIFY(thread.wait());
+#endif
+}
+
+void tst_QCoreApplication::deleteLaterOrdering()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    const auto processEvents = [] {
+        QEventLoop loop;
+        QTimer::singleShot(0, &loop, &QEventLoop::quit);
+        loop.exec();
+    };
+
+    // a call queued after deleteLater() is not made
+    QPointer<QObject> object = new QObject;
+    bool called = false;
+    object->deleteLater();
+    QMetaObject::invokeMethod(object, [&called] { called = true; }, Qt::QueuedConnection);
+    processEvents();
+    QVERIFY(!object);
+    QVERIFY(!called);
+
+    // one queued before it is
+    object = new QObject;
+    QMetaObject::invokeMethod(object, [&called] { called = true; }, Qt::QueuedConnection);
+    object->deleteLater();
+    processEvents();
+    QVERIFY(!object);
+    QVERIFY(called);
+
+    // events for other objects are delivered in order with the deletions
+    object = new QObject;
+    QPointer<QObject> second = new QObject;
+    QObject other;
+    QVector<bool> alive;
+    const auto recordAlive = [&] { alive << !object.isNull() << !second.isNull(); };
+    QMetaObject::invokeMethod(&other, recordAlive, Qt::QueuedConnection);
+    object->deleteLater();
+    QMetaObject::invokeMethod(&other, recordAlive, Qt::QueuedConnection);
+    second->deleteLater();
+    QMetaObject::invokeMethod(&other, recordAlive, Qt::QueuedConnection);
+    processEvents();
+    QCOMPARE(alive, QVector<bool>() << true << true << false << true << false << false);
+}
+
 #if QT_CONFIG(library)
 void tst_QCoreApplication::addRemoveLibPaths()
 {
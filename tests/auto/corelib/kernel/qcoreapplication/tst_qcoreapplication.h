@@ -59,6 +59,11 @@ private slots:
     void applicationEventFilters_auxThread();
     void threadedEventDelivery_data();
     void threadedEventDelivery();
+    void postEventFromMultipleThreads();
+    void compressEventReimplemented();
+    void pooledEvents();
+    void deleteLaterMany();
+    void deleteLaterOrdering();
 #if QT_CONFIG(library)
     void addRemoveLibPaths();
 #endif
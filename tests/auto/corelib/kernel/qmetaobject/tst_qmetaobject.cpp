@@ -32,6 +32,7 @@
 #include <qmetaobject.h>
 #include <qabstractproxymodel.h>
 #include <private/qmetaobject_p.h>
+#include <private/qmetaobjectbuilder_p.h>
 
 Q_DECLARE_METATYPE(const QMetaObject *)
 
@@ -302,6 +303,7 @@ private slots:
     void indexOfMethod();
 
     void indexOfMethodPMF();
+    void indexOfMethodAllMethods();
 
     void signalOffset_data();
     void signalOffset();
@@ -1603,6 +1605,35 @@ void tst_QMetaObject::indexOfMethodPMF()
     INDEXOFMETHODPMF_HELPER(QtTestCustomObject, sig_custom, (const CustomString &))
 }
 
+void tst_QMetaObject::indexOfMethodAllMethods()
+{
+    const QMetaObject *metaObjects[] = {
+        &staticMetaObject, &QtTestObject::staticMetaObject, &QAbstractProxyModel::staticMetaObject
+    };
+    for (const QMetaObject *mo : metaObjects) {
+        // meta-objects from QMetaObjectBuilder have no method name hash table
+        QMetaObjectBuilder builder(mo);
+        QScopedPointer<QMetaObject, QScopedPointerPodDeleter> copy(builder.toMetaObject());
+        QCOMPARE(copy->methodCount(), mo->methodCount());
+
+        for (int i = 0; i < mo->methodCount(); ++i) {
+            const QMetaMethod method = mo->method(i);
+            const QByteArray signature = method.methodSignature();
+            const int idx = mo->indexOfMethod(signature);
+            // a subclass may declare the same method again, which then wins
+            QVERIFY2(idx >= i, signature.constData());
+            QCOMPARE(mo->method(idx).methodSignature(), signature);
+            QCOMPARE(copy->indexOfMethod(signature), idx);
+            if (method.methodType() == QMetaMethod::Signal)
+                QCOMPARE(mo->indexOfSignal(signature), copy->indexOfSignal(signature));
+            else if (method.methodType() == QMetaMethod::Slot)
+                QCOMPARE(mo->indexOfSlot(signature), copy->indexOfSlot(signature));
+        }
+        QCOMPARE(mo->indexOfMethod("noSuchMethod()"), -1);
+        QCOMPARE(mo->indexOfSignal("deleteLater()"), -1);
+    }
+}
+
 namespace SignalTestHelper
 {
 // These functions use the public QMetaObject/QMetaMethod API to implement
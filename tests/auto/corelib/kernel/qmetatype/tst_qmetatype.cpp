@@ -92,6 +92,7 @@ private slots:
     void constructCopy_data();
     void constructCopy();
     void typedefs();
+    void manyTypedefs();
     void registerType();
     void isRegistered_data();
     void isRegistered();
@@ -1001,6 +1002,25 @@ void tst_QMetaType::typedefs()
     QCOMPARE(QMetaType::type("WhityDouble"), ::qMetaTypeId<WhityDouble>());
 }
 
+void tst_QMetaType::manyTypedefs()
+{
+    // enough names to make the type name lookup table grow several times
+    const int count = 2000;
+    const int fooId = ::qMetaTypeId<TestSpace::Foo>();
+    for (int i = 0; i < count; ++i) {
+        const QByteArray name = "ManyTypedefsFoo" + QByteArray::number(i);
+        QCOMPARE(QMetaType::registerTypedef(name.constData(), fooId), fooId);
+    }
+    for (int i = 0; i < count; ++i) {
+        const QByteArray name = "ManyTypedefsFoo" + QByteArray::number(i);
+        QCOMPARE(QMetaType::type(name.constData()), fooId);
+    }
+    QCOMPARE(QMetaType::type("ManyTypedefsFoo"), int(QMetaType::UnknownType));
+    QCOMPARE(QMetaType::type("QString"), int(QMetaType::QString));
+    QCOMPARE(QMetaType::type("QVariantMap"), int(QMetaType::QVariantMap));
+    QCOMPARE(QMetaType::type("TestSpace::Foo"), fooId);
+}
+
 void tst_QMetaType::registerType()
 {
     // Built-in
@@ -50,6 +50,7 @@
 #endif
 
 #include <math.h>
+#include <algorithm>
 
 class tst_QObject : public QObject
 {
@@ -84,6 +85,7 @@ private slots:
     void qpointerResetBeforeDestroyedSignal();
     void testUserData();
     void childDeletesItsSibling();
+    void manyChildren();
     void dynamicProperties();
     void floatProperty();
     void qrealProperty();
@@ -152,6 +154,14 @@ private slots:
     void mutableFunctor();
     void checkArgumentsForNarrowing();
     void nullReceiver();
+    void batchedConnection();
+    void conflatedConnection();
+    void batchedConnectionFromThread();
+    void batchedConnectionReceiverDeleted();
+    void batchedConnectionSenderDeleted();
+    void autoConnectionFollowsMoveToThread();
+    void emitWhileConnecting();
+    void disconnectFunctorDuringEmission();
 };
 
 struct QObjectCreatedOnShutdown
@@ -2919,6 +2929,49 @@ void tst_QObject::childDeletesItsSibling()
     QVERIFY(!siblingDeleter);
 }
 
+void tst_QObject::manyChildren()
+{
+    const int count = 200;
+    QObject parent;
+    QObjectList expected;
+    for (int i = 0; i < count; ++i)
+        expected << new QObject(&parent);
+    QCOMPARE(parent.children(), expected);
+
+    // remove from the middle, the front and the back in turn
+    QObject otherParent;
+    for (int i = 0; i < count / 2; ++i) {
+        const int index = (i % 3 == 0) ? expected.size() / 2 : (i % 3 == 1) ? 0 : expected.size() - 1;
+        QObject *child = expected.takeAt(index);
+        child->setParent(&otherParent);
+        QCOMPARE(parent.children().size(), expected.size());
+    }
+    QCOMPARE(parent.children(), expected);
+
+    // interleave appending and removing
+    const QObjectList moved = otherParent.children();
+    for (int i = 0; i < moved.size(); ++i) {
+        moved.at(i)->setParent(&parent);
+        expected << moved.at(i);
+        if (i % 2) {
+            // only children that were never moved are deleted
+            delete expected.takeAt(expected.size() / 4);
+        }
+    }
+    QCOMPARE(parent.children(), expected);
+    QVERIFY(otherParent.children().isEmpty());
+
+    // deleting children in any order
+    while (!expected.isEmpty()) {
+        delete expected.takeAt(expected.size() / 3);
+        QCOMPARE(parent.children(), expected);
+    }
+
+    for (int i = 0; i < count; ++i)
+        expected << new QObject(&parent);
+    QCOMPARE(parent.children(), expected);
+}
+
 void tst_QObject::floatProperty()
 {
     PropertyObject obj;
@@ -7445,6 +7498,349 @@ void tst_QObject::nullReceiver()
     QVERIFY(!connect(&o, SIGNAL(destroyed()), nullObj, SLOT(deleteLater())));
 }
 
+class BatchSender : public QObject
+{
+    Q_OBJECT
+signals:
+    void valueChanged(int value);
+    void textChanged(const QString &text);
+};
+
+class BatchReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    BatchReceiver() : metaCallEvents(0), deleteAtValue(INT_MIN) {}
+
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::MetaCall)
+            ++metaCallEvents;
+        return QObject::event(e);
+    }
+
+    QList<int> values;
+    QStringList texts;
+    QList<QObject *> senders;
+    int metaCallEvents;
+    int deleteAtValue;
+
+public slots:
+    void setValue(int value)
+    {
+        values << value;
+        senders << sender();
+        if (value == deleteAtValue)
+            delete this;
+    }
+    void setText(const QString &text) { texts << text; }
+};
+
+void tst_QObject::batchedConnection()
+{
+    BatchSender sender1, sender2;
+    BatchReceiver receiver;
+    const Qt::ConnectionType type = Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection);
+    QVERIFY(connect(&sender1, &BatchSender::valueChanged, &receiver, &BatchReceiver::setValue, type));
+    QVERIFY(connect(&sender2, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int)), type));
+    QVERIFY(connect(&sender1, &BatchSender::textChanged, &receiver, &BatchReceiver::setText, type));
+
+    for (int i = 0; i < 100; ++i) {
+        emit sender1.valueChanged(i);
+        emit sender2.valueChanged(-i);
+    }
+    emit sender1.textChanged(QStringLiteral("done"));
+    QVERIFY(receiver.values.isEmpty());
+
+    QCoreApplication::processEvents();
+    QCOMPARE(receiver.metaCallEvents, 1);
+    QCOMPARE(receiver.values.size(), 200);
+    for (int i = 0; i < 100; ++i) {
+        QCOMPARE(receiver.values.at(2 * i), i);
+        QCOMPARE(receiver.senders.at(2 * i), &sender1);
+        QCOMPARE(receiver.values.at(2 * i + 1), -i);
+        QCOMPARE(receiver.senders.at(2 * i + 1), &sender2);
+    }
+    QCOMPARE(receiver.texts, QStringList() << QStringLiteral("done"));
+
+    // emissions after delivery go into a new batch
+    emit sender1.valueChanged(1000);
+    QCoreApplication::processEvents();
+    QCOMPARE(receiver.metaCallEvents, 2);
+    QCOMPARE(receiver.values.last(), 1000);
+
+    // nothing is delivered once disconnected, or to a unique connection twice
+    QVERIFY(QObject::disconnect(&sender2, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int))));
+    QVERIFY(connect(&sender2, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int)),
+                    Qt::ConnectionType(type | Qt::UniqueConnection)));
+    QVERIFY(!connect(&sender2, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int)),
+                     Qt::ConnectionType(type | Qt::UniqueConnection)));
+    emit sender2.valueChanged(2000);
+    QCoreApplication::processEvents();
+    QCOMPARE(receiver.values.size(), 202);
+    QCOMPARE(receiver.values.last(), 2000);
+}
+
+void tst_QObject::conflatedConnection()
+{
+    BatchSender sender;
+    BatchReceiver receiver;
+    QVERIFY(connect(&sender, &BatchSender::valueChanged, &receiver, &BatchReceiver::setValue,
+                    Qt::ConnectionType(Qt::QueuedConnection | Qt::ConflatedConnection)));
+    QVERIFY(connect(&sender, &BatchSender::textChanged, &receiver, &BatchReceiver::setText,
+                    Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection)));
+
+    emit sender.valueChanged(1);
+    emit sender.textChanged(QStringLiteral("a"));
+    emit sender.valueChanged(2);
+    emit sender.textChanged(QStringLiteral("b"));
+    emit sender.valueChanged(3);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(receiver.metaCallEvents, 1);
+    QCOMPARE(receiver.values, QList<int>() << 3);
+    QCOMPARE(receiver.texts, QStringList() << QStringLiteral("a") << QStringLiteral("b"));
+
+    // a direct connection ignores the flag
+    BatchReceiver direct;
+    QVERIFY(connect(&sender, &BatchSender::valueChanged, &direct, &BatchReceiver::setValue,
+                    Qt::ConnectionType(Qt::DirectConnection | Qt::ConflatedConnection)));
+    emit sender.valueChanged(4);
+    emit sender.valueChanged(5);
+    QCOMPARE(direct.values, QList<int>() << 4 << 5);
+    QCOMPARE(direct.metaCallEvents, 0);
+}
+
+class BatchEmitterThread : public QThread
+{
+public:
+    BatchEmitterThread(BatchSender *sender, int count) : sender(sender), count(count) {}
+    void run() override
+    {
+        for (int i = 0; i < count; ++i) {
+            emit sender->valueChanged(i);
+            emit sender->textChanged(QString::number(i));
+        }
+    }
+    BatchSender *sender;
+    int count;
+};
+
+void tst_QObject::batchedConnectionFromThread()
+{
+    const int count = 10000;
+    BatchSender sender;
+    BatchReceiver receiver;
+    BatchReceiver conflatedReceiver;
+    QVERIFY(connect(&sender, &BatchSender::valueChanged, &receiver, &BatchReceiver::setValue,
+                    Qt::BatchedConnection));
+    QVERIFY(connect(&sender, &BatchSender::textChanged, &receiver, &BatchReceiver::setText,
+                    Qt::BatchedConnection));
+    QVERIFY(connect(&sender, &BatchSender::valueChanged, &conflatedReceiver, &BatchReceiver::setValue,
+                    Qt::ConflatedConnection));
+
+    BatchEmitterThread thread(&sender, count);
+    sender.moveToThread(&thread);
+    thread.start();
+    QVERIFY(thread.wait());
+    QTRY_COMPARE(receiver.values.size(), count);
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(receiver.values.at(i), i);
+        QCOMPARE(receiver.texts.at(i), QString::number(i));
+    }
+    QVERIFY(receiver.metaCallEvents <= count);
+
+    // the last value always arrives, and the values only go forward
+    QTRY_COMPARE(conflatedReceiver.values.last(), count - 1);
+    QVERIFY(std::is_sorted(conflatedReceiver.values.cbegin(), conflatedReceiver.values.cend()));
+    QCOMPARE(conflatedReceiver.metaCallEvents, conflatedReceiver.values.size());
+}
+
+void tst_QObject::batchedConnectionReceiverDeleted()
+{
+    BatchSender sender;
+    QPointer<BatchReceiver> receiver = new BatchReceiver;
+    receiver->deleteAtValue = 2;
+    QVERIFY(connect(&sender, &BatchSender::valueChanged, receiver.data(), &BatchReceiver::setValue,
+                    Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection)));
+    for (int i = 0; i < 5; ++i)
+        emit sender.valueChanged(i);
+    QCoreApplication::processEvents();
+    QVERIFY(receiver.isNull());
+
+    // a receiver deleted with calls pending
+    receiver = new BatchReceiver;
+    QVERIFY(connect(&sender, &BatchSender::valueChanged, receiver.data(), &BatchReceiver::setValue,
+                    Qt::ConnectionType(Qt::QueuedConnection | Qt::ConflatedConnection)));
+    emit sender.valueChanged(1);
+    delete receiver.data();
+    emit sender.valueChanged(2);
+    QCoreApplication::processEvents();
+}
+
+void tst_QObject::batchedConnectionSenderDeleted()
+{
+    // like queued calls, batched calls that were emitted before the sender
+    // went away are still delivered
+    BatchReceiver receiver;
+    BatchSender *sender = new BatchSender;
+    QVERIFY(connect(sender, &BatchSender::valueChanged, &receiver, &BatchReceiver::setValue,
+                    Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection)));
+    QVERIFY(connect(sender, &BatchSender::textChanged, &receiver,
+                    [&receiver](const QString &text) { receiver.texts << text; },
+                    Qt::ConnectionType(Qt::QueuedConnection | Qt::ConflatedConnection)));
+    emit sender->valueChanged(1);
+    emit sender->valueChanged(2);
+    emit sender->textChanged(QStringLiteral("a"));
+    delete sender;
+    QCoreApplication::processEvents();
+    QCOMPARE(receiver.values, QList<int>() << 1 << 2);
+    QCOMPARE(receiver.texts, QStringList() << QStringLiteral("a"));
+
+    // the same for a connection that is disconnected before the delivery
+    BatchSender sender2;
+    const QMetaObject::Connection connection =
+            connect(&sender2, &BatchSender::valueChanged, &receiver, &BatchReceiver::setValue,
+                    Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection));
+    QVERIFY(connection);
+    emit sender2.valueChanged(3);
+    QVERIFY(QObject::disconnect(connection));
+    emit sender2.valueChanged(4);
+    QCoreApplication::processEvents();
+    QCOMPARE(receiver.values, QList<int>() << 1 << 2 << 3);
+}
+
+class ThreadRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    ThreadRecorder() : slotThread(nullptr) {}
+    QThread *slotThread;
+public slots:
+    void record() { slotThread = QThread::currentThread(); }
+};
+
+void tst_QObject::autoConnectionFollowsMoveToThread()
+{
+    BatchSender sender;
+    ThreadRecorder *receiver = new ThreadRecorder;
+    QObject *parent = new QObject;
+    ThreadRecorder *child = new ThreadRecorder;
+    child->setParent(parent);
+    QVERIFY(connect(&sender, SIGNAL(valueChanged(int)), receiver, SLOT(record())));
+    QVERIFY(connect(&sender, &BatchSender::valueChanged, child, &ThreadRecorder::record));
+
+    emit sender.valueChanged(1);
+    QCOMPARE(receiver->slotThread, QThread::currentThread());
+    QCOMPARE(child->slotThread, QThread::currentThread());
+
+    QThread thread;
+    thread.start();
+    receiver->slotThread = child->slotThread = nullptr;
+    receiver->moveToThread(&thread);
+    parent->moveToThread(&thread);
+
+    // the calls have to be queued now
+    emit sender.valueChanged(2);
+    QTRY_COMPARE(receiver->slotThread, &thread);
+    QTRY_COMPARE(child->slotThread, &thread);
+
+    QObject::connect(&thread, &QThread::finished, receiver, &QObject::deleteLater);
+    QObject::connect(&thread, &QThread::finished, parent, &QObject::deleteLater);
+    thread.quit();
+    QVERIFY(thread.wait());
+}
+
+class ConnectingThread : public QThread
+{
+public:
+    ConnectingThread(BatchSender *sender) : sender(sender), count(0) {}
+    void run() override
+    {
+        // connect and disconnect while the main thread emits, also to a
+        // signal that makes the sender grow its connection lists
+        QObject context;
+        for (int i = 0; i < 2000; ++i) {
+            QMetaObject::Connection valueConnection =
+                connect(sender, &BatchSender::valueChanged, &context, [this] { count.ref(); },
+                        Qt::DirectConnection);
+            QMetaObject::Connection textConnection =
+                connect(sender, &BatchSender::textChanged, &context, [this] { count.ref(); },
+                        Qt::DirectConnection);
+            if (i % 10 == 0)
+                QObject::connect(sender, &BatchSender::valueChanged, new QObject(&context), &QObject::deleteLater);
+            disconnect(valueConnection);
+            disconnect(textConnection);
+            if (i % 100 == 0)
+                qDeleteAll(context.children());
+        }
+    }
+    BatchSender *sender;
+    QAtomicInt count;
+};
+
+void tst_QObject::emitWhileConnecting()
+{
+    BatchSender sender;
+    int received = 0;
+    connect(&sender, &BatchSender::valueChanged, [&received](int value) { received += value; });
+
+    ConnectingThread thread(&sender);
+    thread.start();
+    int expected = 0;
+    while (!thread.isFinished()) {
+        emit sender.valueChanged(1);
+        emit sender.textChanged(QString());
+        ++expected;
+    }
+    QVERIFY(thread.wait());
+    emit sender.valueChanged(1);
+    QCOMPARE(received, expected + 1);
+}
+
+void tst_QObject::disconnectFunctorDuringEmission()
+{
+    // the functor of a connection that is disconnected while the signal is
+    // being emitted lives until the emission is done
+    QCOMPARE(countedStructObjectsCount, 0);
+    {
+        GetSenderObject obj;
+        QMetaObject::Connection c;
+        int calls = 0;
+        int alive = 0;
+        {
+            CountedStruct s(&obj);
+            c = connect(&obj, &GetSenderObject::aSignal, [&c, &calls, &alive, s] {
+                ++calls;
+                QObject::disconnect(c);
+                alive = countedStructObjectsCount;
+            });
+        }
+        QCOMPARE(countedStructObjectsCount, 1);
+        emit obj.aSignal();
+        QCOMPARE(calls, 1);
+        QCOMPARE(alive, 1);
+        QCOMPARE(countedStructObjectsCount, 0);
+        emit obj.aSignal();
+        QCOMPARE(calls, 1);
+    }
+    QCOMPARE(countedStructObjectsCount, 0);
+    {
+        // disconnected by a slot that runs before the functor
+        GetSenderObject obj;
+        QObject context;
+        connect(&obj, &GetSenderObject::aSignal, [&obj] {
+            QObject::disconnect(&obj, &GetSenderObject::aSignal, nullptr, nullptr);
+            QCOMPARE(countedStructObjectsCount, 1);
+        });
+        connect(&obj, &GetSenderObject::aSignal, &context, CountedStruct(&obj));
+        QCOMPARE(countedStructObjectsCount, 1);
+        emit obj.aSignal();
+        QCOMPARE(countedStructObjectsCount, 0);
+    }
+    QCOMPARE(countedStructObjectsCount, 0);
+}
+
 // Test for QtPrivate::HasQ_OBJECT_Macro
 Q_STATIC_ASSERT(QtPrivate::HasQ_OBJECT_Macro<tst_QObject>::Value);
 Q_STATIC_ASSERT(!QtPrivate::HasQ_OBJECT_Macro<SiblingDeleter>::Value);
@@ -33,6 +33,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QTemporaryFile>
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QUdpSocket>
@@ -44,6 +45,7 @@
 #define NATIVESOCKETENGINE QNativeSocketEngine
 #ifdef Q_OS_UNIX
 #include <private/qnet_unix_p.h>
+#include <private/qeventdispatcher_unix_p.h>
 #include <sys/select.h>
 #endif
 #include <limits>
@@ -61,6 +63,10 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+    void regularFile();
+#endif
+#if QT_CONFIG(epoll)
+    void epollDispatcher();
 #endif
     void asyncMultipleDatagram();
 
@@ -323,6 +329,144 @@ void tst_QSocketNotifier::posixSockets()
     }
     qt_safe_close(posixSocket);
 }
+
+// regular files cannot be waited for with epoll(7), but poll(2) reports them as always ready
+void tst_QSocketNotifier::regularFile()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write("hello"), qint64(5));
+    QVERIFY(file.flush());
+    QVERIFY(file.seek(0));
+
+    QSocketNotifier rn(file.handle(), QSocketNotifier::Read);
+    connect(&rn, SIGNAL(activated(int)), &QTestEventLoop::instance(), SLOT(exitLoop()));
+    QSignalSpy readSpy(&rn, &QSocketNotifier::activated);
+    QVERIFY(readSpy.isValid());
+
+    QTestEventLoop::instance().enterLoop(3);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QVERIFY(readSpy.count() >= 1);
+    QCOMPARE(readSpy.at(0).at(0).toInt(), file.handle());
+
+    rn.setEnabled(false);
+    QSocketNotifier wn(file.handle(), QSocketNotifier::Write);
+    connect(&wn, SIGNAL(activated(int)), &QTestEventLoop::instance(), SLOT(exitLoop()));
+    QSignalSpy writeSpy(&wn, &QSocketNotifier::activated);
+    QVERIFY(writeSpy.isValid());
+
+    QTestEventLoop::instance().enterLoop(3);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QVERIFY(writeSpy.count() >= 1);
+}
+#endif
+
+#if QT_CONFIG(epoll)
+class QueuedQuitThread : public QThread
+{
+public:
+    explicit QueuedQuitThread(QEventLoop *loop) : loop(loop) {}
+    void run() override
+    {
+        msleep(50);
+        QMetaObject::invokeMethod(loop, "quit", Qt::QueuedConnection);
+    }
+    QEventLoop *loop;
+};
+
+class EpollDispatcherThread : public QThread
+{
+public:
+    EpollDispatcherThread()
+        : timerFired(false), readActivated(false), writeActivated(false),
+          fileActivated(false), wokenUp(false)
+    {}
+
+    void run() override
+    {
+        QEventLoop loop;
+        QTimer timeout;
+        timeout.setSingleShot(true);
+        connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+        // timers arm the timerfd
+        QElapsedTimer elapsed;
+        elapsed.start();
+        QTimer::singleShot(50, Qt::PreciseTimer, &loop, &QEventLoop::quit);
+        loop.exec();
+        timerFired = elapsed.elapsed() >= 50;
+
+        // notifiers are added to and removed from the interest list
+        int fds[2];
+        if (qt_safe_pipe(fds) != 0)
+            return;
+        {
+            QSocketNotifier reader(fds[0], QSocketNotifier::Read);
+            connect(&reader, &QSocketNotifier::activated, &loop, &QEventLoop::quit);
+            timeout.start(5000);
+            qt_safe_write(fds[1], "x", 1);
+            loop.exec();
+            readActivated = timeout.isActive();
+            reader.setEnabled(false);
+
+            QSocketNotifier writer(fds[1], QSocketNotifier::Write);
+            connect(&writer, &QSocketNotifier::activated, &loop, &QEventLoop::quit);
+            timeout.start(5000);
+            loop.exec();
+            writeActivated = timeout.isActive();
+        }
+        qt_safe_close(fds[0]);
+        qt_safe_close(fds[1]);
+
+        // epoll refuses regular files, which are always ready
+        QTemporaryFile file;
+        if (file.open()) {
+            QSocketNotifier fileReader(file.handle(), QSocketNotifier::Read);
+            connect(&fileReader, &QSocketNotifier::activated, &loop, &QEventLoop::quit);
+            timeout.start(5000);
+            loop.exec();
+            fileActivated = timeout.isActive();
+        }
+
+        // events posted from another thread wake up epoll_wait()
+        QueuedQuitThread poster(&loop);
+        poster.start();
+        timeout.start(5000);
+        loop.exec();
+        wokenUp = timeout.isActive();
+        poster.wait();
+    }
+
+    bool timerFired;
+    bool readActivated;
+    bool writeActivated;
+    bool fileActivated;
+    bool wokenUp;
+};
+
+// the epoll backend is otherwise only used with QT_EVENT_DISPATCHER_EPOLL=1
+void tst_QSocketNotifier::epollDispatcher()
+{
+    const bool wasSet = qEnvironmentVariableIsSet("QT_EVENT_DISPATCHER_EPOLL");
+    const QByteArray oldValue = qgetenv("QT_EVENT_DISPATCHER_EPOLL");
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    QEventDispatcherUNIX *dispatcher = new QEventDispatcherUNIX;
+    if (wasSet)
+        qputenv("QT_EVENT_DISPATCHER_EPOLL", oldValue);
+    else
+        qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+    QVERIFY(static_cast<QEventDispatcherUNIXPrivate *>(QObjectPrivate::get(dispatcher))->epollFd != -1);
+
+    EpollDispatcherThread thread;
+    thread.setEventDispatcher(dispatcher);
+    thread.start();
+    QVERIFY(thread.wait(60000));
+    QVERIFY(thread.timerFired);
+    QVERIFY(thread.readActivated);
+    QVERIFY(thread.writeActivated);
+    QVERIFY(thread.fileActivated);
+    QVERIFY(thread.wokenUp);
+}
 #endif
 
 void tst_QSocketNotifier::async_readDatagramSlot()
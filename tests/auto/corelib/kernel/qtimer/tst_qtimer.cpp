@@ -67,6 +67,7 @@ private slots:
     void timerFiresOnlyOncePerProcessEvents();
     void timerIdPersistsAfterThreadExit();
     void cancelLongTimer();
+    void manyTimers();
     void singleShotStaticFunctionZeroTimeout();
     void recurseOnTimeoutAndStopTimer();
     void singleShotToFunctors();
@@ -645,6 +646,43 @@ void tst_QTimer::cancelLongTimer()
     QVERIFY(!timer.isActive());
 }
 
+class TimerOrderRecorder : public QObject
+{
+public:
+    QVector<int> firedTimerIds;
+
+protected:
+    void timerEvent(QTimerEvent *te) override
+    {
+        killTimer(te->timerId());
+        firedTimerIds.append(te->timerId());
+    }
+};
+
+void tst_QTimer::manyTimers()
+{
+    // The intervals span several levels of the timer wheel. Timers started
+    // in ascending order of their intervals must fire in that order.
+    TimerOrderRecorder recorder;
+    QVector<int> timerIds;
+    for (int i = 0; i < 1000; ++i) {
+        const int timerId = recorder.startTimer(i * 3 / 5, Qt::PreciseTimer);
+        QVERIFY(timerId > 0);
+        timerIds.append(timerId);
+    }
+
+    QVector<int> expected;
+    for (int i = 0; i < timerIds.size(); ++i) {
+        if (i % 3)
+            expected.append(timerIds.at(i));
+        else
+            recorder.killTimer(timerIds.at(i));
+    }
+
+    QTRY_COMPARE(recorder.firedTimerIds.size(), expected.size());
+    QCOMPARE(recorder.firedTimerIds, expected);
+}
+
 class TimeoutCounter : public QObject
 {
     Q_OBJECT
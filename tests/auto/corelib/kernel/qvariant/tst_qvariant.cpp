@@ -246,6 +246,7 @@ private slots:
     void numericalConvert();
     void moreCustomTypes();
     void movabilityTest();
+    void moveValueTypes();
     void variantInVariant();
     void userConversion();
     void modelIndexConversion();
@@ -3870,6 +3871,23 @@ void tst_QVariant::movabilityTest()
     QVERIFY(!MyNotMovable::count);
 }
 
+void tst_QVariant::moveValueTypes()
+{
+    QVariant rect(QRectF(1, 2, 3, 4));
+    QVariant line(QLineF(1, 2, 3, 4));
+
+    QVariant copy = rect;
+    copy.setValue(QRectF(5, 6, 7, 8));
+    QCOMPARE(rect.toRectF(), QRectF(1, 2, 3, 4));
+    QCOMPARE(copy.toRectF(), QRectF(5, 6, 7, 8));
+
+    QVariant moved(std::move(rect));
+    QVERIFY(!rect.isValid());
+    QCOMPARE(moved.toRectF(), QRectF(1, 2, 3, 4));
+    line = std::move(moved);
+    QCOMPARE(line.toRectF(), QRectF(1, 2, 3, 4));
+}
+
 void tst_QVariant::variantInVariant()
 {
     QVariant var1 = 5;
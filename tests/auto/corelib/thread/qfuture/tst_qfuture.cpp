@@ -70,9 +70,13 @@ private slots:
     void pause();
     void throttling();
     void voidConversions();
+    void then();
+    void thenMovesResults();
+    void thenExecutors();
 #ifndef QT_NO_EXCEPTIONS
     void exceptions();
     void nestedExceptions();
+    void onFailed();
 #endif
     void nonGlobalThreadPool();
 };
@@ -1272,6 +1276,225 @@ void tst_QFuture::voidConversions()
     }
 }
 
+void tst_QFuture::then()
+{
+    // attached before the future finishes
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        QFuture<QString> then = promise.future().then([](int value) {
+            return QString::number(value);
+        });
+        QVERIFY(!then.isFinished());
+
+        promise.reportResult(42);
+        promise.reportFinished();
+        QVERIFY(then.isFinished());
+        QCOMPARE(then.result(), QString("42"));
+    }
+
+    // attached after the future finished
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        promise.reportResult(1);
+        promise.reportFinished();
+
+        QFuture<int> future = promise.future();
+        int argument = 0;
+        QFuture<void> then = future.then([&argument](int value) { argument = value; });
+        QVERIFY(then.isFinished());
+        QCOMPARE(argument, 1);
+        QCOMPARE(future.result(), 1);
+    }
+
+    // chains of continuations taking no argument, the result or the future
+    {
+        QFutureInterface<void> promise;
+        promise.reportStarted();
+        int steps = 0;
+        QFuture<int> future = promise.future()
+                .then([&steps]() { ++steps; return 2; })
+                .then([&steps](int value) { ++steps; return value * 3; })
+                .then([&steps](QFuture<int> parent) { ++steps; return parent.result() + 1; });
+        QCOMPARE(steps, 0);
+
+        promise.reportFinished();
+        QCOMPARE(future.result(), 7);
+        QCOMPARE(steps, 3);
+    }
+
+    // a canceled future skips continuations taking its result...
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        bool called = false;
+        QFuture<void> then = promise.future().then([&called](int) { called = true; });
+
+        promise.reportCanceled();
+        promise.reportFinished();
+        QVERIFY(!called);
+        QVERIFY(then.isFinished());
+        QVERIFY(then.isCanceled());
+    }
+
+    // ...but not those taking the future
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        QFuture<bool> then = promise.future().then([](QFuture<int> parent) {
+            return parent.isCanceled();
+        });
+
+        promise.reportCanceled();
+        promise.reportFinished();
+        QVERIFY(then.result());
+    }
+
+    // canceling the continuation's future skips the continuation
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        bool called = false;
+        QFuture<void> then = promise.future().then([&called](int) { called = true; });
+        then.cancel();
+
+        promise.reportResult(1);
+        promise.reportFinished();
+        QVERIFY(!called);
+        QVERIFY(then.isFinished());
+    }
+
+    // a future destroyed before finishing cancels its continuation
+    {
+        QFuture<int> then;
+        {
+            QFutureInterface<int> promise;
+            promise.reportStarted();
+            then = promise.future().then([](int value) { return value; });
+        }
+        QVERIFY(then.isFinished());
+        QVERIFY(then.isCanceled());
+    }
+}
+
+struct CopyCounter
+{
+    explicit CopyCounter(int value = 0) : value(value) { }
+    CopyCounter(const CopyCounter &other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter &&other) : value(other.value) { }
+    CopyCounter &operator=(const CopyCounter &other) { value = other.value; ++copies; return *this; }
+    CopyCounter &operator=(CopyCounter &&other) { value = other.value; return *this; }
+
+    int value;
+    static int copies;
+};
+
+int CopyCounter::copies = 0;
+
+void tst_QFuture::thenMovesResults()
+{
+    // nothing else refers to the intermediate results
+    {
+        CopyCounter::copies = 0;
+        QFutureInterface<CopyCounter> promise;
+        promise.reportStarted();
+        QFuture<CopyCounter> future = promise.future()
+                .then([](CopyCounter counter) { counter.value += 1; return counter; })
+                .then([](CopyCounter counter) { counter.value *= 2; return counter; });
+
+        promise.reportAndMoveResult(CopyCounter(1));
+        promise.reportFinished();
+        QCOMPARE(CopyCounter::copies, 0);
+        QCOMPARE(future.result().value, 4);
+    }
+
+    // the results stay available through other futures
+    {
+        CopyCounter::copies = 0;
+        QFutureInterface<CopyCounter> promise;
+        promise.reportStarted();
+        QFuture<CopyCounter> parent = promise.future();
+        QFuture<int> future = parent.then([](CopyCounter counter) { return counter.value; });
+
+        promise.reportAndMoveResult(CopyCounter(1));
+        promise.reportFinished();
+        QCOMPARE(CopyCounter::copies, 1);
+        QCOMPARE(future.result(), 1);
+        QCOMPARE(parent.result().value, 1);
+    }
+}
+
+void tst_QFuture::thenExecutors()
+{
+    // in a thread pool
+    {
+        QThreadPool pool;
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        QThread *thread = nullptr;
+        QFuture<int> future = promise.future().then(&pool, [&thread](int value) {
+            thread = QThread::currentThread();
+            return value + 1;
+        });
+
+        promise.reportResult(1);
+        promise.reportFinished();
+        QCOMPARE(future.result(), 2);
+        QVERIFY(thread);
+        QVERIFY(thread != QThread::currentThread());
+    }
+
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        QThread *thread = nullptr;
+        QFuture<int> future = promise.future().then(QtFuture::Launch::Async, [&thread](int value) {
+            thread = QThread::currentThread();
+            return value + 1;
+        });
+
+        promise.reportResult(1);
+        promise.reportFinished();
+        QCOMPARE(future.result(), 2);
+        QVERIFY(thread != QThread::currentThread());
+    }
+
+    // in the thread of a context object
+    {
+        QObject context;
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        QThread *thread = nullptr;
+        QFuture<void> future = promise.future().then(&context, [&thread](int) {
+            thread = QThread::currentThread();
+        });
+
+        promise.reportResult(1);
+        promise.reportFinished();
+        QVERIFY(!future.isFinished());
+        QTRY_VERIFY(future.isFinished());
+        QCOMPARE(thread, QThread::currentThread());
+    }
+
+    // destroying the context object cancels the continuation
+    {
+        QObject *context = new QObject;
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        bool called = false;
+        QFuture<void> future = promise.future().then(context, [&called](int) { called = true; });
+
+        promise.reportResult(1);
+        promise.reportFinished();
+        delete context;
+        QVERIFY(future.isFinished());
+        QVERIFY(future.isCanceled());
+
+        QCoreApplication::processEvents();
+        QVERIFY(!called);
+    }
+}
 
 #ifndef QT_NO_EXCEPTIONS
 
@@ -1437,6 +1660,96 @@ void tst_QFuture::nestedExceptions()
     QVERIFY(MyClass::caught);
 }
 
+void tst_QFuture::onFailed()
+{
+    // handlers catch exceptions of the type of their argument
+    {
+        QFuture<int> future = createExceptionResultFuture().onFailed([](const QException &) {
+            return -1;
+        });
+        QCOMPARE(future.result(), -1);
+    }
+
+    {
+        bool handled = false;
+        QFuture<void> future = createExceptionFuture().onFailed([&handled](DerivedException &) {
+            handled = true;
+        });
+        QVERIFY(!handled);
+        QVERIFY(future.isCanceled());
+
+        bool caught = false;
+        try {
+            future.waitForFinished();
+        } catch (QException &) {
+            caught = true;
+        }
+        QVERIFY(caught);
+    }
+
+    // exceptions skip continuations taking the result
+    {
+        bool called = false;
+        QFuture<int> future = createExceptionResultFuture()
+                .then([&called](int value) { called = true; return value; })
+                .onFailed([]() { return -2; });
+        QVERIFY(!called);
+        QCOMPARE(future.result(), -2);
+    }
+
+    // exceptions thrown by continuations
+    {
+        QFutureInterface<void> promise;
+        promise.reportStarted();
+        bool handled = false;
+        QFuture<void> future = promise.future()
+                .then([]() { throw DerivedException(); })
+                .onFailed([&handled](DerivedException &) { handled = true; });
+
+        promise.reportFinished();
+        QVERIFY(handled);
+        QVERIFY(future.isFinished());
+        QVERIFY(!future.isCanceled());
+    }
+
+    {
+        QFutureInterface<void> promise;
+        promise.reportStarted();
+        bool handled = false;
+        promise.future()
+                .then([]() { throw 1; })
+                .onFailed([&handled](const QUnhandledException &) { handled = true; });
+
+        promise.reportFinished();
+        QVERIFY(handled);
+    }
+
+    // results are forwarded if nothing failed
+    {
+        QFutureInterface<int> promise;
+        promise.reportStarted();
+        QFuture<int> future = promise.future().onFailed([]() { return -1; });
+
+        promise.reportResult(5);
+        promise.reportFinished();
+        QCOMPARE(future.result(), 5);
+    }
+
+    // in the thread of a context object
+    {
+        QObject context;
+        QThread *thread = nullptr;
+        QFuture<int> future = createExceptionResultFuture().onFailed(&context, [&thread]() {
+            thread = QThread::currentThread();
+            return -1;
+        });
+        QVERIFY(!future.isFinished());
+        QTRY_VERIFY(future.isFinished());
+        QCOMPARE(future.result(), -1);
+        QCOMPARE(thread, QThread::currentThread());
+    }
+}
+
 #endif // QT_NO_EXCEPTIONS
 
 void tst_QFuture::nonGlobalThreadPool()
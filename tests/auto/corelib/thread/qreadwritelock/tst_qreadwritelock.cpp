@@ -81,6 +81,7 @@ private slots:
     void readLockBlockRelease();
     void writeLockBlockRelease();
     void multipleReadersBlockRelease();
+    void writerBlocksReaders();
     void multipleReadersLoop();
     void multipleWritersLoop();
     void multipleReadersWritersLoop();
@@ -693,6 +694,68 @@ void tst_QReadWriteLock::multipleReadersBlockRelease()
     QVERIFY(threadDone);
 }
 
+/*
+    A writer holds the lock while several readers and a timed reader wait for
+    it, then a second writer joins them; everybody gets the lock in the end.
+*/
+class ReadLockCountingThread : public QThread
+{
+public:
+    QReadWriteLock &testRwlock;
+    QAtomicInt &count;
+    int timeout;
+    bool result;
+    inline ReadLockCountingThread(QReadWriteLock &l, QAtomicInt &c, int t = -1)
+        : testRwlock(l), count(c), timeout(t), result(false) { }
+    void run()
+    {
+        result = testRwlock.tryLockForRead(timeout);
+        if (result) {
+            count.ref();
+            testRwlock.unlock();
+        }
+    }
+};
+
+void tst_QReadWriteLock::writerBlocksReaders()
+{
+    QReadWriteLock testLock;
+    QAtomicInt readers;
+    testLock.lockForWrite();
+
+    ReadLockCountingThread rlt1(testLock, readers);
+    ReadLockCountingThread rlt2(testLock, readers);
+    ReadLockCountingThread rlt3(testLock, readers);
+    rlt1.start();
+    rlt2.start();
+    rlt3.start();
+
+    ReadLockCountingThread timedReader(testLock, readers, 100);
+    timedReader.start();
+    QVERIFY(timedReader.wait());
+    QVERIFY(!timedReader.result);
+    QCOMPARE(readers.load(), 0);
+
+    threadDone = false;
+    WriteLockThread wlt(testLock);
+    wlt.start();
+    QTest::qSleep(100);
+    QCOMPARE(readers.load(), 0);
+    QVERIFY(!threadDone);
+
+    testLock.unlock();
+    QVERIFY(rlt1.wait());
+    QVERIFY(rlt2.wait());
+    QVERIFY(rlt3.wait());
+    QVERIFY(wlt.wait());
+    QVERIFY(threadDone);
+    QCOMPARE(readers.load(), 3);
+
+    // nothing is left waiting on the lock
+    QVERIFY(testLock.tryLockForWrite());
+    testLock.unlock();
+}
+
 /*
     Multiple readers locks and unlocks a lock.
 */
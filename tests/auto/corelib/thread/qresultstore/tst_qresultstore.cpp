@@ -53,6 +53,7 @@ private slots:
     void filterMode();
     void addCanceledResult();
     void count();
+    void contiguousResults();
 private:
     int int0;
     int int1;
@@ -477,5 +478,37 @@ void tst_QtConcurrentResultStore::count()
     }
 }
 
+void tst_QtConcurrentResultStore::contiguousResults()
+{
+    ResultStoreInt store;
+    int *results = store.reserveContiguousResults<int>(6);
+    for (int i = 0; i < 6; ++i)
+        results[i] = i * 10;
+
+    QCOMPARE(store.addContiguousResults<int>(3, 3), 3);
+    QCOMPARE(store.count(), 0);
+    QCOMPARE(store.contains(3), true);
+    QCOMPARE(store.contains(0), false);
+
+    QCOMPARE(store.addContiguousResults<int>(0, 2), 0);
+    QCOMPARE(store.count(), 2);
+    QCOMPARE(store.addContiguousResults<int>(2, 1), 2);
+    QCOMPARE(store.count(), 6);
+
+    // the results are read in place, not copied
+    for (int i = 0; i < 6; ++i) {
+        QCOMPARE(store.resultAt(i).value<int>(), i * 10);
+        QCOMPARE(store.resultAt(i).pointer<int>(), results + i);
+    }
+    QCOMPARE(store.contains(6), false);
+
+    ResultIteratorBase it = store.begin();
+    for (int i = 0; i < 6; ++i, ++it) {
+        QCOMPARE(it.resultIndex(), i);
+        QCOMPARE(it.value<int>(), i * 10);
+    }
+    QCOMPARE(it, store.end());
+}
+
 QTEST_MAIN(tst_QtConcurrentResultStore)
 #include "tst_qresultstore.moc"
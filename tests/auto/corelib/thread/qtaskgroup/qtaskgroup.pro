@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qtaskgroup
+QT = core testlib
+SOURCES = tst_qtaskgroup.cpp
@@ -0,0 +1,250 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qtaskgroup.h>
+#include <qthreadpool.h>
+#include <qsemaphore.h>
+
+class tst_QTaskGroup : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void startAndWait();
+    void functionWithoutToken();
+    void runnableOwnership();
+    void waitOnlyForGroup();
+    void waitTimeout();
+    void cancel();
+    void startAfterCancel();
+    void nestedForkJoin_data();
+    void nestedForkJoin();
+};
+
+void tst_QTaskGroup::startAndWait()
+{
+    QThreadPool pool;
+    QAtomicInt count;
+    {
+        QTaskGroup group(&pool);
+        QCOMPARE(group.threadPool(), &pool);
+        for (int i = 0; i < 100; ++i)
+            group.start([&count](const QCancellationToken &) { count.ref(); });
+        QVERIFY(group.wait());
+        QCOMPARE(count.load(), 100);
+        QCOMPARE(group.pendingTaskCount(), 0);
+        QVERIFY(!group.isCanceled());
+    }
+
+    QTaskGroup globalGroup;
+    QCOMPARE(globalGroup.threadPool(), QThreadPool::globalInstance());
+}
+
+void tst_QTaskGroup::functionWithoutToken()
+{
+    QThreadPool pool;
+    QAtomicInt count;
+    QTaskGroup group(&pool);
+    group.start([&count]() { count.ref(); });
+    group.start([&count]() { count.ref(); }, 1);
+    QVERIFY(group.wait());
+    QCOMPARE(count.load(), 2);
+}
+
+class CountingRunnable : public QRunnable
+{
+public:
+    CountingRunnable(QAtomicInt *runs, QAtomicInt *deletions)
+        : runs(runs), deletions(deletions)
+    { }
+    ~CountingRunnable() { deletions->ref(); }
+    void run() override { runs->ref(); }
+
+    QAtomicInt *runs;
+    QAtomicInt *deletions;
+};
+
+void tst_QTaskGroup::runnableOwnership()
+{
+    QThreadPool pool;
+    QAtomicInt runs, deletions;
+
+    CountingRunnable *owned = new CountingRunnable(&runs, &deletions);
+    CountingRunnable notOwned(&runs, &deletions);
+    notOwned.setAutoDelete(false);
+    {
+        QTaskGroup group(&pool);
+        group.start(owned);
+        group.start(owned);
+        group.start(&notOwned);
+        group.start(nullptr);
+        QVERIFY(group.wait());
+    }
+    QCOMPARE(runs.load(), 3);
+    // the autoDelete runnable started twice is only deleted once
+    QCOMPARE(deletions.load(), 1);
+}
+
+void tst_QTaskGroup::waitOnlyForGroup()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+
+    // an unrelated task keeps one thread busy
+    QSemaphore unrelatedStarted, releaseUnrelated;
+    class Unrelated : public QRunnable
+    {
+    public:
+        QSemaphore *started;
+        QSemaphore *release;
+        void run() override
+        {
+            started->release();
+            release->acquire();
+        }
+    };
+    Unrelated *unrelated = new Unrelated;
+    unrelated->started = &unrelatedStarted;
+    unrelated->release = &releaseUnrelated;
+    pool.start(unrelated);
+    unrelatedStarted.acquire();
+
+    QAtomicInt count;
+    QTaskGroup group(&pool);
+    for (int i = 0; i < 10; ++i)
+        group.start([&count]() { count.ref(); });
+    QVERIFY(group.wait(10000));
+    QCOMPARE(count.load(), 10);
+
+    releaseUnrelated.release();
+    QVERIFY(pool.waitForDone());
+}
+
+void tst_QTaskGroup::waitTimeout()
+{
+    QThreadPool pool;
+    QSemaphore started, release;
+    QTaskGroup group(&pool);
+    group.start([&]() { started.release(); release.acquire(); });
+    started.acquire();
+
+    QVERIFY(!group.wait(50));
+    QCOMPARE(group.pendingTaskCount(), 1);
+    release.release();
+    QVERIFY(group.wait());
+    QCOMPARE(group.pendingTaskCount(), 0);
+}
+
+void tst_QTaskGroup::cancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    QSemaphore started, release;
+    QAtomicInt sawCancellation, count;
+    QTaskGroup group(&pool);
+    group.start([&](const QCancellationToken &token) {
+        started.release();
+        release.acquire();
+        if (token.isCanceled())
+            sawCancellation.ref();
+    });
+    started.acquire();
+
+    // the only thread is busy, so these stay queued
+    for (int i = 0; i < 10; ++i)
+        group.start([&count]() { count.ref(); });
+    QCOMPARE(group.pendingTaskCount(), 11);
+
+    QVERIFY(!group.cancellationToken().isCanceled());
+    group.cancel();
+    QVERIFY(group.isCanceled());
+    QVERIFY(group.cancellationToken().isCanceled());
+    QCOMPARE(group.pendingTaskCount(), 1);
+
+    release.release();
+    QVERIFY(group.wait());
+    QCOMPARE(sawCancellation.load(), 1);
+    QCOMPARE(count.load(), 0);
+
+    QVERIFY(!QCancellationToken().isCanceled());
+}
+
+void tst_QTaskGroup::startAfterCancel()
+{
+    QThreadPool pool;
+    QAtomicInt runs, deletions;
+    QTaskGroup group(&pool);
+    group.cancel();
+    group.start(new CountingRunnable(&runs, &deletions));
+    QCOMPARE(group.pendingTaskCount(), 0);
+    QVERIFY(group.wait());
+    QCOMPARE(runs.load(), 0);
+    QCOMPARE(deletions.load(), 1);
+}
+
+static int fibonacci(QThreadPool *pool, int n)
+{
+    if (n < 2)
+        return n;
+    int a = 0, b = 0;
+    QTaskGroup group(pool);
+    group.start([&]() { a = fibonacci(pool, n - 1); });
+    group.start([&]() { b = fibonacci(pool, n - 2); });
+    group.wait();
+    return a + b;
+}
+
+void tst_QTaskGroup::nestedForkJoin_data()
+{
+    QTest::addColumn<bool>("workStealing");
+
+    QTest::newRow("shared queue") << false;
+    QTest::newRow("work stealing") << true;
+}
+
+void tst_QTaskGroup::nestedForkJoin()
+{
+    QFETCH(bool, workStealing);
+
+    // every task waits for two sub-tasks; with only two threads this would
+    // deadlock if waiting threads did not run the queued sub-tasks themselves
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+    pool.setWorkStealingEnabled(workStealing);
+
+    int result = 0;
+    QTaskGroup group(&pool);
+    group.start([&]() { result = fibonacci(&pool, 15); });
+    QVERIFY(group.wait(60000));
+    QCOMPARE(result, 610);
+}
+
+QTEST_MAIN(tst_QTaskGroup)
+#include "tst_qtaskgroup.moc"
@@ -85,6 +85,8 @@ private slots:
     void releaseThread();
     void reserveAndStart();
     void start();
+    void startBatch_data();
+    void startBatch();
     void tryStart();
     void tryStartPeakThreadCount();
     void tryStartCount();
@@ -100,6 +102,8 @@ private slots:
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
+    void workStealing();
+    void workStealingPriority();
 
 private:
     QMutex m_functionTestMutex;
@@ -731,6 +735,44 @@ void tst_QThreadPool::start()
     QCOMPARE(count.load(), runs);
 }
 
+void tst_QThreadPool::startBatch_data()
+{
+    QTest::addColumn<int>("maxThreadCount");
+
+    QTest::newRow("no threads allowed") << 0;
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+void tst_QThreadPool::startBatch()
+{
+    QFETCH(int, maxThreadCount);
+
+    const int runs = 1000;
+    count.store(0);
+    {
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(maxThreadCount);
+
+        QVector<QRunnable *> runnables;
+        for (int i = 0; i < runs; ++i) {
+            runnables.append(new CountingRunnable());
+            if (i % 100 == 0)
+                runnables.append(nullptr);
+        }
+        threadPool.startBatch(runnables);
+        threadPool.startBatch(QVector<QRunnable *>());
+
+        QVector<std::function<void()> > functions;
+        for (int i = 0; i < runs; ++i)
+            functions.append([]() { count.ref(); });
+        threadPool.startBatch(functions, 1);
+
+        QVERIFY(threadPool.waitForDone(10000));
+    }
+    QCOMPARE(count.load(), 2 * runs);
+}
+
 void tst_QThreadPool::tryStart()
 {
     class WaitingTask : public QRunnable
@@ -1343,5 +1385,106 @@ void tst_QThreadPool::waitForDoneAfterTake()
 
 }
 
+void tst_QThreadPool::workStealing()
+{
+    class Spawner : public QRunnable
+    {
+    public:
+        Spawner(QThreadPool *pool, QAtomicInt *leaves, int depth)
+            : pool(pool), leaves(leaves), depth(depth) {}
+
+        void run()
+        {
+            if (depth == 0) {
+                leaves->ref();
+                return;
+            }
+            for (int i = 0; i < 8; ++i)
+                pool->start(new Spawner(pool, leaves, depth - 1));
+        }
+
+    private:
+        QThreadPool *pool;
+        QAtomicInt *leaves;
+        int depth;
+    };
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(4);
+    QVERIFY(!threadPool.isWorkStealingEnabled());
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+
+    for (int i = 0; i < 10; ++i) {
+        QAtomicInt leaves;
+        threadPool.start(new Spawner(&threadPool, &leaves, 4));
+        QVERIFY(threadPool.waitForDone());
+        QCOMPARE(leaves.load(), 8 * 8 * 8 * 8);
+        QCOMPARE(threadPool.activeThreadCount(), 0);
+    }
+}
+
+void tst_QThreadPool::workStealingPriority()
+{
+    class Recorder : public QRunnable
+    {
+    public:
+        Recorder(QStringList *order, const QString &name)
+            : order(order), name(name) {}
+
+        void run()
+        {
+            QMutexLocker locker(tst_QThreadPool::functionTestMutex);
+            order->append(name);
+        }
+
+    private:
+        QStringList *order;
+        QString name;
+    };
+
+    class Spawner : public QRunnable
+    {
+    public:
+        Spawner(QThreadPool *pool, QStringList *order)
+            : pool(pool), order(order) {}
+
+        void run()
+        {
+            // the pool has a single thread, so these all go to its local queue
+            pool->start(new Recorder(order, QLatin1String("a")), 0);
+            pool->start(new Recorder(order, QLatin1String("b")), 0);
+            pool->start(new Recorder(order, QLatin1String("c")), 1);
+            pool->start(new Recorder(order, QLatin1String("d")), -1);
+
+            Recorder *taken = new Recorder(order, QLatin1String("taken"));
+            taken->setAutoDelete(false);
+            pool->start(taken, 0);
+            takeSucceeded = pool->tryTake(taken);
+            delete taken;
+        }
+
+        bool takeSucceeded = false;
+
+    private:
+        QThreadPool *pool;
+        QStringList *order;
+    };
+
+    QStringList order;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    Spawner spawner(&threadPool, &order);
+    spawner.setAutoDelete(false);
+    threadPool.start(&spawner);
+    QVERIFY(threadPool.waitForDone());
+
+    QVERIFY(spawner.takeSucceeded);
+    // highest priority first, most recently started first within a priority
+    QCOMPARE(order, QStringList() << "c" << "b" << "a" << "d");
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -60,6 +60,7 @@ private slots:
     void leakInDestructor();
     void resetInDestructor();
     void valueBased();
+    void manyStorages();
 
 private:
     QString m_crashOnExit;
@@ -520,5 +521,49 @@ void tst_QThreadStorage::valueBased()
 }
 
 
+void tst_QThreadStorage::manyStorages()
+{
+    // enough storages to use both the native thread-local slots and the
+    // per-thread vector; each must keep its own value and clean it up
+    enum { StorageCount = 100 };
+    QVector<QThreadStorage<Pointer *> *> storages;
+    for (int i = 0; i < StorageCount; ++i)
+        storages.append(new QThreadStorage<Pointer *>);
+
+    class Thread : public QThread
+    {
+    public:
+        QVector<QThreadStorage<Pointer *> *> storages;
+        QVector<Pointer *> values;
+        bool ok = true;
+        void run() override
+        {
+            for (QThreadStorage<Pointer *> *storage : qAsConst(storages)) {
+                ok = ok && !storage->hasLocalData();
+                Pointer *p = new Pointer;
+                storage->setLocalData(p);
+                values.append(p);
+            }
+            for (int i = 0; i < storages.size(); ++i)
+                ok = ok && storages.at(i)->localData() == values.at(i);
+        }
+    };
+
+    const int c = Pointer::count;
+    Thread thread1, thread2;
+    thread1.storages = thread2.storages = storages;
+    thread1.start();
+    thread2.start();
+    QVERIFY(thread1.wait());
+    QVERIFY(thread2.wait());
+    QVERIFY(thread1.ok);
+    QVERIFY(thread2.ok);
+    QCOMPARE(Pointer::count, c);
+
+    for (QThreadStorage<Pointer *> *storage : qAsConst(storages))
+        QVERIFY(!storage->hasLocalData());
+    qDeleteAll(storages);
+}
+
 QTEST_MAIN(tst_QThreadStorage)
 #include "tst_qthreadstorage.moc"
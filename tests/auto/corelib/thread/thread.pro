@@ -11,6 +11,7 @@ SUBDIRS=\
     qreadlocker \
     qreadwritelock \
     qsemaphore \
+    qtaskgroup \
     qthread \
     qthreadonce \
     qthreadpool \
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qcontainerarena
+QT = core-private testlib
+SOURCES = tst_qcontainerarena.cpp
@@ -0,0 +1,303 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qcontainerarena.h>
+#include <private/qcontainerarena_p.h>
+#include <qvarlengtharray.h>
+
+#include <thread>
+
+class tst_QContainerArena : public QObject
+{
+    Q_OBJECT
+private slots:
+    void allocate();
+    void reuseLatest();
+    void scope();
+    void nestedScopes();
+    void copiesAreDeep();
+    void alignedElements();
+    void heapDataStaysOnHeap();
+    void othersStayOnHeap();
+    void destroyInOtherThread();
+};
+
+void tst_QContainerArena::allocate()
+{
+    QContainerArena arena(256);
+    QContainerArenaPrivate *d = QContainerArenaPrivate::get(&arena);
+    QCOMPARE(arena.capacity(), qsizetype(0));
+
+    char *a = static_cast<char *>(d->allocate(3, 1));
+    QVERIFY(a);
+    QVERIFY(arena.owns(a));
+    QCOMPARE(arena.capacity(), qsizetype(256));
+
+    void *b = d->allocate(8, 8);
+    QVERIFY(b);
+    QCOMPARE(quintptr(b) % 8, quintptr(0));
+    QVERIFY(arena.owns(b));
+    QVERIFY(static_cast<char *>(b) >= a + 3);
+
+    // more than a block holds
+    void *big = d->allocate(4096, 16);
+    QVERIFY(big);
+    QCOMPARE(quintptr(big) % 16, quintptr(0));
+    QVERIFY(arena.owns(big));
+    memset(big, 0, 4096);
+
+    // the first block is still used after the big allocation
+    void *c = d->allocate(8, 8);
+    QCOMPARE(static_cast<char *>(c), static_cast<char *>(b) + 8);
+
+    int local;
+    QVERIFY(!arena.owns(&local));
+    QVERIFY(!arena.owns(nullptr));
+
+    arena.release();
+    QCOMPARE(arena.capacity(), qsizetype(0));
+    QVERIFY(!arena.owns(b));
+}
+
+void tst_QContainerArena::reuseLatest()
+{
+    QContainerArena arena;
+    QContainerArenaPrivate *d = QContainerArenaPrivate::get(&arena);
+
+    char *a = static_cast<char *>(d->allocate(16, 8));
+    char *b = static_cast<char *>(d->allocate(16, 8));
+    QCOMPARE(b, a + 16);
+
+    d->deallocate(b);
+    QCOMPARE(static_cast<char *>(d->allocate(32, 8)), b);
+
+    // other memory is not reused
+    d->deallocate(a);
+    QCOMPARE(static_cast<char *>(d->allocate(16, 8)), b + 32);
+}
+
+void tst_QContainerArena::scope()
+{
+    QContainerArena arena;
+    QVERIFY(!QContainerArena::current());
+    {
+        QContainerArenaScope scope(&arena);
+        QCOMPARE(QContainerArena::current(), &arena);
+
+        QVector<int> vector;
+        for (int i = 0; i < 1000; ++i)
+            vector.append(i);
+        QVERIFY(arena.owns(vector.constData()));
+        QCOMPARE(vector.size(), 1000);
+        QCOMPARE(vector.last(), 999);
+
+        // arena data grows in the arena of the active scope
+        QVector<int> outliving(10);
+        {
+            QContainerArenaScope heap(nullptr);
+            QVERIFY(!QContainerArena::current());
+            outliving.resize(1000);
+            QVERIFY(!arena.owns(outliving.constData()));
+        }
+        QCOMPARE(QContainerArena::current(), &arena);
+    }
+    QVERIFY(!QContainerArena::current());
+
+    QVector<int> vector(100);
+    QVERIFY(!arena.owns(vector.constData()));
+}
+
+void tst_QContainerArena::nestedScopes()
+{
+    QContainerArena outer;
+    QContainerArenaScope outerScope(&outer);
+    QVector<int> first(2);
+    QVERIFY(outer.owns(first.constData()));
+    {
+        QContainerArena inner;
+        QContainerArenaScope innerScope(&inner);
+        QCOMPARE(QContainerArena::current(), &inner);
+        QVector<int> second(2);
+        QVERIFY(inner.owns(second.constData()));
+        QVERIFY(!outer.owns(second.constData()));
+
+        // data of the outer arena moves to the inner one when it grows
+        first.resize(100);
+        QVERIFY(inner.owns(first.constData()));
+        first = QVector<int>();
+    }
+    QCOMPARE(QContainerArena::current(), &outer);
+    QVector<int> third(3);
+    QVERIFY(outer.owns(third.constData()));
+}
+
+void tst_QContainerArena::copiesAreDeep()
+{
+    QContainerArena arena;
+    QVector<int> vectorCopy;
+    QVector<QString> stringsCopy;
+    {
+        QVector<int> vector;
+        QVector<QString> strings;
+        {
+            QContainerArenaScope scope(&arena);
+            vector << 1 << 2 << 3;
+            strings << QStringLiteral("a") << QString::number(42);
+
+            // within the scope, copies come from the arena too
+            QVector<int> copy = vector;
+            QVERIFY(!copy.isSharedWith(vector));
+            QVERIFY(arena.owns(copy.constData()));
+            QCOMPARE(copy, vector);
+        }
+        vectorCopy = vector;
+        stringsCopy = strings;
+
+        QVERIFY(!vectorCopy.isSharedWith(vector));
+        QVERIFY(!arena.owns(vectorCopy.constData()));
+        QVERIFY(!stringsCopy.isSharedWith(strings));
+        QVERIFY(!arena.owns(stringsCopy.constData()));
+
+        // heap copies are shared as usual
+        QVector<int> shared = vectorCopy;
+        QVERIFY(shared.isSharedWith(vectorCopy));
+    }
+    arena.release();
+
+    QCOMPARE(vectorCopy, QVector<int>() << 1 << 2 << 3);
+    QCOMPARE(stringsCopy, QVector<QString>() << QStringLiteral("a") << QStringLiteral("42"));
+}
+
+struct Q_DECL_ALIGN(64) Aligned
+{
+    int value;
+};
+
+void tst_QContainerArena::alignedElements()
+{
+    QContainerArena arena;
+    QContainerArenaScope scope(&arena);
+    QVector<char> bytes(3);
+    QVector<Aligned> aligned(5);
+    QVERIFY(arena.owns(aligned.constData()));
+    QCOMPARE(quintptr(aligned.constData()) % 64, quintptr(0));
+    for (int i = 0; i < aligned.size(); ++i)
+        aligned[i].value = i;
+
+    // freeing the latest allocation in place makes it available again
+    const Aligned *data = aligned.constData();
+    aligned = QVector<Aligned>();
+    QVector<Aligned> again(5);
+    QCOMPARE(again.constData(), data);
+    QVERIFY(arena.owns(bytes.constData()));
+}
+
+void tst_QContainerArena::heapDataStaysOnHeap()
+{
+    QVector<int> vector(1);
+    QVector<int> sharedVector = vector;
+
+    QContainerArena arena;
+    {
+        QContainerArenaScope scope(&arena);
+        for (int i = 0; i < 1000; ++i)
+            vector.append(i);
+        sharedVector[0] = 1;
+    }
+    QVERIFY(!arena.owns(vector.constData()));
+    QVERIFY(!arena.owns(sharedVector.constData()));
+    QCOMPARE(arena.capacity(), qsizetype(0));
+}
+
+void tst_QContainerArena::othersStayOnHeap()
+{
+    // binaries built against older Qt 5 headers share string data
+    // unconditionally and free QVarLengthArray buffers themselves
+    QContainerArena arena;
+    QString string;
+    QByteArray bytes;
+    QVarLengthArray<int, 4> array;
+    {
+        QContainerArenaScope scope(&arena);
+        string = QString::number(42).repeated(100);
+        bytes = QByteArray::number(42).repeated(100);
+        array.resize(100);
+        QVERIFY(!arena.owns(string.constData()));
+        QVERIFY(!arena.owns(bytes.constData()));
+        QVERIFY(!arena.owns(array.constData()));
+
+        QString copy = string;
+        QVERIFY(copy.isSharedWith(string));
+    }
+    QCOMPARE(arena.capacity(), qsizetype(0));
+}
+
+void tst_QContainerArena::destroyInOtherThread()
+{
+    QContainerArena arena;
+    QVector<int> vector;
+    QVector<int> grown;
+    {
+        QContainerArenaScope scope(&arena);
+        vector.resize(100);
+        grown.resize(100);
+    }
+    QVERIFY(arena.owns(vector.constData()));
+    QVERIFY(arena.owns(grown.constData()));
+
+    // another thread can free arena memory, which stays in use until the
+    // arena is released, and growing there moves it to the heap
+    bool otherArena = true;
+    const auto destroy = [&]() {
+        otherArena = QContainerArena::current() != nullptr;
+        QVector<int> moved = std::move(vector);
+        moved.clear();
+        grown.resize(10000);
+        grown[9999] = 1;
+    };
+    std::thread(destroy).join();
+    QVERIFY(!otherArena);
+    QVERIFY(vector.isEmpty());
+    QVERIFY(!arena.owns(grown.constData()));
+    QCOMPARE(grown.at(9999), 1);
+
+    // the freed memory is not reused
+    const qsizetype capacity = arena.capacity();
+    {
+        QContainerArenaScope scope(&arena);
+        QVector<int> more(100);
+        QVERIFY(arena.owns(more.constData()));
+    }
+    QVERIFY(arena.capacity() >= capacity);
+}
+
+QTEST_APPLESS_MAIN(tst_QContainerArena)
+
+#include "tst_qcontainerarena.moc"
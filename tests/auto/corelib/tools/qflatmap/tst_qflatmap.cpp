@@ -0,0 +1,297 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <private/qflatmap_p.h>
+#include <qmap.h>
+#include <qrandom.h>
+
+// compares like its number, but remembers which of several equal keys it is
+struct TaggedKey
+{
+    TaggedKey() : number(0), tag(0) {}
+    TaggedKey(int n, int t = 0) : number(n), tag(t) {}
+
+    int number;
+    int tag;
+};
+
+static bool operator<(const TaggedKey &lhs, const TaggedKey &rhs)
+{
+    return lhs.number < rhs.number;
+}
+
+typedef QFlatMap<int, QString> IntMap;
+
+class tst_QFlatMap : public QObject
+{
+    Q_OBJECT
+private slots:
+    void constructing();
+    void buildFromUnsorted();
+    void insert();
+    void insertKeepsKey();
+    void insertMap();
+    void remove();
+    void bounds();
+    void erase();
+    void implicitSharing();
+    void sameAsQMap();
+};
+
+void tst_QFlatMap::constructing()
+{
+    IntMap map;
+    QVERIFY(map.isEmpty());
+    QCOMPARE(map.size(), 0);
+    QVERIFY(map.begin() == map.end());
+    QVERIFY(map.constFind(1) == map.constEnd());
+    QVERIFY(!map.contains(1));
+    QCOMPARE(map.value(1), QString());
+    QCOMPARE(map.value(1, QStringLiteral("default")), QStringLiteral("default"));
+
+    const IntMap empty{QVector<int>(), QVector<QString>()};
+    QVERIFY(empty.isEmpty());
+}
+
+void tst_QFlatMap::buildFromUnsorted()
+{
+    const QVector<TaggedKey> keys = { {5, 0}, {1, 1}, {3, 2}, {1, 3}, {5, 4}, {2, 5}, {1, 6} };
+    const QVector<int> values = { 50, 10, 30, 11, 51, 20, 12 };
+    const QFlatMap<TaggedKey, int> map(keys, values);
+
+    // like repeated insert(): the first key is kept, with the last value
+    QCOMPARE(map.size(), 4);
+    QFlatMap<TaggedKey, int>::const_iterator it = map.constBegin();
+    QCOMPARE(it.key().number, 1);
+    QCOMPARE(it.key().tag, 1);
+    QCOMPARE(it.value(), 12);
+    ++it;
+    QCOMPARE(it.key().number, 2);
+    QCOMPARE(it.value(), 20);
+    ++it;
+    QCOMPARE(it.key().number, 3);
+    QCOMPARE(it.value(), 30);
+    ++it;
+    QCOMPARE(it.key().number, 5);
+    QCOMPARE(it.key().tag, 0);
+    QCOMPARE(it.value(), 51);
+    ++it;
+    QVERIFY(it == map.constEnd());
+}
+
+void tst_QFlatMap::insert()
+{
+    IntMap map;
+    IntMap::iterator it = map.insert(3, QStringLiteral("three"));
+    QCOMPARE(it.key(), 3);
+    QCOMPARE(it.value(), QStringLiteral("three"));
+    map.insert(1, QStringLiteral("one"));
+    map.insert(2, QStringLiteral("two"));
+    it = map.insert(2, QStringLiteral("TWO"));
+    QCOMPARE(it.key(), 2);
+    QCOMPARE(*it, QStringLiteral("TWO"));
+
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(map.keys(), QVector<int>({1, 2, 3}));
+    QCOMPARE(map.values(), QVector<QString>({ QStringLiteral("one"), QStringLiteral("TWO"),
+                                              QStringLiteral("three") }));
+
+    map[0] = QStringLiteral("zero");
+    map[3] += QLatin1Char('!');
+    QCOMPARE(map.size(), 4);
+    QCOMPARE(map.value(0), QStringLiteral("zero"));
+    QCOMPARE(map.value(3), QStringLiteral("three!"));
+
+    it = map.find(1);
+    QVERIFY(it != map.end());
+    it.value() = QStringLiteral("ONE");
+    QCOMPARE(map.value(1), QStringLiteral("ONE"));
+    QVERIFY(map.find(4) == map.end());
+}
+
+void tst_QFlatMap::insertKeepsKey()
+{
+    QFlatMap<TaggedKey, int> map;
+    map.insert(TaggedKey(1, 1), 10);
+    map.insert(TaggedKey(1, 2), 11);
+    QCOMPARE(map.size(), 1);
+    QCOMPARE(map.constBegin().key().tag, 1);
+    QCOMPARE(map.constBegin().value(), 11);
+}
+
+void tst_QFlatMap::insertMap()
+{
+    QFlatMap<TaggedKey, int> map;
+    map.insert(QFlatMap<TaggedKey, int>());
+    QVERIFY(map.isEmpty());
+
+    map.insert(QFlatMap<TaggedKey, int>({ {1, 1}, {3, 1} }, { 10, 30 }));
+    QCOMPARE(map.size(), 2);
+
+    // appending after the last key
+    map.insert(QFlatMap<TaggedKey, int>({ {5, 2}, {4, 2} }, { 50, 40 }));
+    QCOMPARE(map.size(), 4);
+
+    // interleaved, with equal keys: the values of the inserted map win
+    map.insert(QFlatMap<TaggedKey, int>({ {0, 3}, {3, 3}, {2, 3}, {6, 3} }, { 0, 31, 20, 60 }));
+    QCOMPARE(map.size(), 7);
+    int expectedNumber = 0;
+    const int expectedValues[] = { 0, 10, 20, 31, 40, 50, 60 };
+    const int expectedTags[] = { 3, 1, 3, 1, 2, 2, 3 };
+    for (QFlatMap<TaggedKey, int>::const_iterator it = map.begin(); it != map.end(); ++it) {
+        QCOMPARE(it.key().number, expectedNumber);
+        QCOMPARE(it.key().tag, expectedTags[expectedNumber]);
+        QCOMPARE(it.value(), expectedValues[expectedNumber]);
+        ++expectedNumber;
+    }
+    QCOMPARE(expectedNumber, 7);
+}
+
+void tst_QFlatMap::remove()
+{
+    IntMap map({ 1, 2, 3 }, { QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c") });
+    QCOMPARE(map.remove(4), 0);
+    QCOMPARE(map.remove(2), 1);
+    QCOMPARE(map.remove(2), 0);
+    QCOMPARE(map.keys(), QVector<int>({1, 3}));
+    QCOMPARE(map.take(3), QStringLiteral("c"));
+    QCOMPARE(map.take(3), QString());
+    QCOMPARE(map.keys(), QVector<int>({1}));
+    map.clear();
+    QVERIFY(map.isEmpty());
+}
+
+void tst_QFlatMap::bounds()
+{
+    const IntMap map({ 10, 20, 30 }, { QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c") });
+    QCOMPARE(map.lowerBound(5).key(), 10);
+    QCOMPARE(map.lowerBound(10).key(), 10);
+    QCOMPARE(map.upperBound(10).key(), 20);
+    QCOMPARE(map.lowerBound(25).key(), 30);
+    QVERIFY(map.lowerBound(31) == map.constEnd());
+    QVERIFY(map.upperBound(30) == map.constEnd());
+
+    IntMap::const_iterator it = map.upperBound(30);
+    --it;
+    QCOMPARE(it.key(), 30);
+    QCOMPARE(map.constEnd() - map.constBegin(), 3);
+}
+
+void tst_QFlatMap::erase()
+{
+    IntMap map;
+    for (int i = 0; i < 10; ++i)
+        map.insert(i, QString::number(i));
+
+    // the way QSettings removes a group
+    IntMap::iterator it = map.lowerBound(3);
+    while (it != map.end() && it.key() < 7)
+        it = map.erase(it);
+    QCOMPARE(it.key(), 7);
+    QCOMPARE(map.keys(), QVector<int>({0, 1, 2, 7, 8, 9}));
+    QCOMPARE(map.values().at(3), QStringLiteral("7"));
+
+    it = map.erase(map.find(9));
+    QVERIFY(it == map.end());
+    QCOMPARE(map.size(), 5);
+}
+
+void tst_QFlatMap::implicitSharing()
+{
+    IntMap map;
+    map.insert(1, QStringLiteral("one"));
+    map.insert(2, QStringLiteral("two"));
+
+    IntMap copy = map;
+    QVERIFY(copy == map);
+    QVERIFY(copy.keys().isSharedWith(map.keys()));
+    QVERIFY(copy.values().isSharedWith(map.values()));
+
+    copy.begin().value() = QStringLiteral("ONE");
+    QCOMPARE(map.value(1), QStringLiteral("one"));
+    QCOMPARE(copy.value(1), QStringLiteral("ONE"));
+    QVERIFY(copy != map);
+
+    copy = map;
+    copy.erase(copy.begin());
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(copy.size(), 1);
+
+    copy = map;
+    copy.insert(3, QStringLiteral("three"));
+    copy.remove(1);
+    QCOMPARE(map.keys(), QVector<int>({1, 2}));
+    QCOMPARE(copy.keys(), QVector<int>({2, 3}));
+}
+
+void tst_QFlatMap::sameAsQMap()
+{
+    QRandomGenerator rng(42);
+    QMap<int, int> reference;
+    QFlatMap<int, int> map;
+
+    for (int round = 0; round < 2000; ++round) {
+        const int key = int(rng.bounded(200));
+        switch (rng.bounded(4)) {
+        case 0:
+        case 1:
+            reference.insert(key, round);
+            map.insert(key, round);
+            break;
+        case 2:
+            QCOMPARE(map.remove(key), reference.remove(key));
+            break;
+        case 3: {
+            QMap<int, int> more;
+            QVector<int> keys;
+            QVector<int> values;
+            for (int i = 0; i < 5; ++i) {
+                const int k = int(rng.bounded(200));
+                more.insert(k, round + i);
+                keys.append(k);
+                values.append(round + i);
+            }
+            for (QMap<int, int>::const_iterator it = more.constBegin(); it != more.constEnd(); ++it)
+                reference.insert(it.key(), it.value());
+            map.insert(QFlatMap<int, int>(keys, values));
+            break;
+        }
+        }
+        QCOMPARE(map.size(), reference.size());
+        QCOMPARE(map.contains(key), reference.contains(key));
+        QCOMPARE(map.value(key, -1), reference.value(key, -1));
+    }
+    QCOMPARE(map.keys().toList(), reference.keys());
+    QCOMPARE(map.values().toList(), reference.values());
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatMap)
+#include "tst_qflatmap.moc"
@@ -50,6 +50,7 @@ public slots:
 
 private Q_SLOTS:
     void consistent();
+    void lengths();
     void qhash();
     void qhash_of_empty_and_null_qstring();
     void qhash_of_empty_and_null_qbytearray();
@@ -73,6 +74,35 @@ void tst_QHashFunctions::consistent()
     }
 }
 
+void tst_QHashFunctions::lengths()
+{
+    // the hashing functions process strings in blocks; make sure every
+    // byte of every length contributes and the overloads stay consistent
+    const QByteArray data = QByteArrayLiteral("0123456789abcdefghijklmnopqrstuvwxyz").repeated(6);
+    for (int len = 0; len <= data.size(); ++len) {
+        const QByteArray ba = data.left(len);
+        const uint h = qHash(ba, seed);
+        QCOMPARE(qHash(QLatin1String(ba), seed), h);
+
+        const QString s = QString::fromLatin1(ba);
+        const uint hs = qHash(s, seed);
+        QCOMPARE(qHash(QStringView(s), seed), hs);
+        QCOMPARE(qHash(QStringRef(&s), seed), hs);
+
+        if (len < data.size()) {
+            QVERIFY(qHash(data.left(len + 1), seed) != h);  // not guaranteed
+        }
+        for (int i = 0; i < len; ++i) {
+            QByteArray changed = ba;
+            changed[i] = '#';
+            QVERIFY2(qHash(changed, seed) != h, qPrintable(QString::number(i)));  // not guaranteed
+            QString changedString = s;
+            changedString[i] = QLatin1Char('#');
+            QVERIFY2(qHash(changedString, seed) != hs, qPrintable(QString::number(i)));  // not guaranteed
+        }
+    }
+}
+
 void tst_QHashFunctions::initTestCase()
 {
     Q_STATIC_ASSERT(int(RandomSeed) > 0);
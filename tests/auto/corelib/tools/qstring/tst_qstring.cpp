@@ -470,6 +470,8 @@ private slots:
     void indexOfInvalidRegex();
     void indexOf2_data();
     void indexOf2();
+    void indexOf_longHaystack_data();
+    void indexOf_longHaystack();
     void indexOf3_data();
 //  void indexOf3();
     void sprintf();
@@ -1602,6 +1604,56 @@ void tst_QString::indexOf2()
     }
 }
 
+void tst_QString::indexOf_longHaystack_data()
+{
+    QTest::addColumn<QChar>("filler");
+    QTest::addColumn<QChar>("edge");
+
+    QTest::newRow("latin1") << QChar('x') << QChar('a');
+    // same low byte as the filler
+    QTest::newRow("utf16") << QChar(0x0178) << QChar(0x4e78);
+}
+
+void tst_QString::indexOf_longHaystack()
+{
+    QFETCH(QChar, filler);
+    QFETCH(QChar, edge);
+
+    // put needles of all short and some long lengths at every position of
+    // a haystack that spans several SIMD blocks, with partial matches
+    // (first and last character) in front of them
+    const int haystackLen = 150;
+    for (int needleLen = 2; needleLen <= 40; needleLen += (needleLen < 34 ? 1 : 3)) {
+        QString needle(needleLen, filler);
+        needle[0] = edge;
+        needle[needleLen - 1] = QChar(edge.unicode() + 1);
+        // matches the first and last character only
+        QString partial = needle;
+        partial[needleLen / 2] = QChar(edge.unicode() + 2);
+        const QByteArray cneedle = needle.toLatin1();
+
+        for (int pos = 0; pos + needleLen <= haystackLen; pos += 7) {
+            QString haystack(haystackLen, filler);
+            if (needleLen > 2 && pos >= needleLen)
+                haystack.replace(pos - needleLen, needleLen, partial);
+            haystack.replace(pos, needleLen, needle);
+
+            QCOMPARE(haystack.indexOf(needle), pos);
+            QCOMPARE(haystack.indexOf(needle, pos), pos);
+            QCOMPARE(haystack.indexOf(needle, pos + 1), -1);
+            QCOMPARE(QStringMatcher(needle).indexIn(haystack), pos);
+            QVERIFY(QStringRef(&haystack).contains(needle));
+            QCOMPARE(haystack.split(needle).size(), 2);
+
+            if (filler.unicode() < 0x100) {
+                const QByteArray chaystack = haystack.toLatin1();
+                QCOMPARE(chaystack.indexOf(cneedle), pos);
+                QCOMPARE(chaystack.indexOf(cneedle, pos + 1), -1);
+            }
+        }
+    }
+}
+
 void tst_QString::indexOfInvalidRegex()
 {
     QTest::ignoreMessage(QtWarningMsg, "QString::indexOf: invalid QRegularExpression object");
@@ -14,12 +14,14 @@ SUBDIRS=\
     qchar \
     qcollator \
     qcommandlineparser \
+    qcontainerarena \
     qcontiguouscache \
     qcryptographichash \
     qdate \
     qdatetime \
     qeasingcurve \
     qexplicitlyshareddatapointer \
+    qflatmap \
     qfreelist \
     qhash \
     qhash_strictiterators \
@@ -0,0 +1,141 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore>
+#include <QtConcurrent>
+#include <qtest.h>
+
+#include <cmath>
+
+Q_DECLARE_METATYPE(QtConcurrent::Partitioning)
+
+class tst_QtConcurrentMap : public QObject
+{
+    Q_OBJECT
+private slots:
+    void blockingMap_data();
+    void blockingMap();
+    void mapped_data();
+    void mapped();
+};
+
+enum Workload { Uniform, Skewed };
+Q_DECLARE_METATYPE(Workload)
+
+static void addPartitioningRows()
+{
+    QTest::addColumn<QtConcurrent::Partitioning>("partitioning");
+    QTest::addColumn<Workload>("workload");
+
+    QTest::newRow("adaptive uniform") << QtConcurrent::AdaptivePartitioning << Uniform;
+    QTest::newRow("static uniform") << QtConcurrent::StaticPartitioning << Uniform;
+    QTest::newRow("guided uniform") << QtConcurrent::GuidedPartitioning << Uniform;
+    QTest::newRow("adaptive skewed") << QtConcurrent::AdaptivePartitioning << Skewed;
+    QTest::newRow("static skewed") << QtConcurrent::StaticPartitioning << Skewed;
+    QTest::newRow("guided skewed") << QtConcurrent::GuidedPartitioning << Skewed;
+}
+
+static const int itemCount = 1 << 20;
+
+// cheap, and the same for every item
+static void scale(double &value)
+{
+    value = value * 1.0001 + 0.5;
+}
+
+// the items at the end of the sequence cost much more than those at the start
+static void skewedWork(double &value)
+{
+    const int rounds = int(value) >> 14;
+    for (int i = 0; i < rounds; ++i)
+        value = std::sqrt(value * value + 1.0);
+}
+
+static QVector<double> makeInput()
+{
+    QVector<double> values(itemCount);
+    for (int i = 0; i < itemCount; ++i)
+        values[i] = i;
+    return values;
+}
+
+void tst_QtConcurrentMap::blockingMap_data()
+{
+    addPartitioningRows();
+}
+
+void tst_QtConcurrentMap::blockingMap()
+{
+    QFETCH(QtConcurrent::Partitioning, partitioning);
+    QFETCH(Workload, workload);
+
+    QVector<double> values = makeInput();
+
+    QBENCHMARK {
+        if (workload == Uniform)
+            QtConcurrent::blockingMap(values, scale, partitioning);
+        else
+            QtConcurrent::blockingMap(values, skewedWork, partitioning);
+    }
+}
+
+static double scaled(const double &value)
+{
+    return value * 1.0001 + 0.5;
+}
+
+static double skewed(const double &value)
+{
+    double result = value;
+    skewedWork(result);
+    return result;
+}
+
+void tst_QtConcurrentMap::mapped_data()
+{
+    addPartitioningRows();
+}
+
+void tst_QtConcurrentMap::mapped()
+{
+    QFETCH(QtConcurrent::Partitioning, partitioning);
+    QFETCH(Workload, workload);
+
+    const QVector<double> values = makeInput();
+
+    QBENCHMARK {
+        QFuture<double> future = workload == Uniform
+                ? QtConcurrent::mapped(values, scaled, partitioning)
+                : QtConcurrent::mapped(values, skewed, partitioning);
+        future.waitForFinished();
+    }
+}
+
+QTEST_MAIN(tst_QtConcurrentMap)
+
+#include "main.moc"
@@ -0,0 +1,6 @@
+QT = core concurrent testlib
+
+TEMPLATE = app
+TARGET = tst_bench_qtconcurrentmap
+
+SOURCES += main.cpp
@@ -83,6 +83,47 @@ int EventTester::foo(int bar)
     return bar + 1;
 }
 
+class EventCounter : public QObject
+{
+public:
+    void expect(int count) { m_remaining = count; }
+
+protected:
+    bool event(QEvent *e);
+
+private:
+    int m_remaining;
+};
+
+bool EventCounter::event(QEvent *e)
+{
+    if (e->type() != QEvent::User)
+        return QObject::event(e);
+    if (--m_remaining == 0)
+        QTestEventLoop::instance().exitLoop();
+    return true;
+}
+
+class EventProducer : public QThread
+{
+public:
+    EventProducer(QObject *receiver, int count, int priority)
+        : m_receiver(receiver), m_count(count), m_priority(priority)
+    {}
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < m_count; ++i)
+            QCoreApplication::postEvent(m_receiver, new QEvent(QEvent::User), m_priority);
+    }
+
+private:
+    QObject *m_receiver;
+    int m_count;
+    int m_priority;
+};
+
 class EventsBench : public QObject
 {
     Q_OBJECT
@@ -96,6 +137,8 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+    void postEventMultipleProducers_data();
+    void postEventMultipleProducers();
 };
 
 void EventsBench::initTestCase()
@@ -169,6 +212,43 @@ void EventsBench::postEvent()
     }
 }
 
+void EventsBench::postEventMultipleProducers_data()
+{
+    QTest::addColumn<int>("producers");
+    QTest::addColumn<int>("priority");
+
+    for (int producers = 1; producers <= 8; producers *= 2) {
+        // normal priority events skip the posted event list mutex, high
+        // priority ones always take it
+        QTest::addRow("%d producers, normal priority", producers)
+                << producers << int(Qt::NormalEventPriority);
+        QTest::addRow("%d producers, high priority", producers)
+                << producers << int(Qt::HighEventPriority);
+    }
+}
+
+void EventsBench::postEventMultipleProducers()
+{
+    QFETCH(int, producers);
+    QFETCH(int, priority);
+    const int eventsPerProducer = 10000;
+
+    EventCounter counter;
+    QBENCHMARK {
+        counter.expect(producers * eventsPerProducer);
+        QVector<EventProducer *> threads;
+        for (int i = 0; i < producers; ++i)
+            threads.append(new EventProducer(&counter, eventsPerProducer, priority));
+        for (EventProducer *thread : qAsConst(threads))
+            thread->start();
+        QTestEventLoop::instance().enterLoop(60);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+        for (EventProducer *thread : qAsConst(threads))
+            thread->wait();
+        qDeleteAll(threads);
+    }
+}
+
 QTEST_MAIN(EventsBench)
 
 #include "main.moc"
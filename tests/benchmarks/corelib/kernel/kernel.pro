@@ -5,7 +5,8 @@ SUBDIRS = \
         qmetatype \
         qobject \
         qvariant \
-        qcoreapplication
+        qcoreapplication \
+        qtimer
 
 !qtHaveModule(widgets): SUBDIRS -= \
     qmetaobject \
@@ -122,6 +122,8 @@ private slots:
     void indexOfSignal();
     void indexOfSlot_data();
     void indexOfSlot();
+    void indexOfSignalLotsOfSignals_data();
+    void indexOfSignalLotsOfSignals();
 
     void unconnected_data();
     void unconnected();
@@ -222,6 +224,26 @@ void tst_qmetaobject::indexOfSlot()
     }
 }
 
+void tst_qmetaobject::indexOfSignalLotsOfSignals_data()
+{
+    QTest::addColumn<QByteArray>("signal");
+    QTest::newRow("first") << QByteArray("extraSignal1()");
+    QTest::newRow("middle") << QByteArray("extraSignal25()");
+    QTest::newRow("last") << QByteArray("extraSignal70()");
+    QTest::newRow("inherited") << QByteArray("destroyed(QObject*)");
+    QTest::newRow("missing") << QByteArray("extraSignal71()");
+}
+
+void tst_qmetaobject::indexOfSignalLotsOfSignals()
+{
+    QFETCH(QByteArray, signal);
+    const char *p = signal.constData();
+    const QMetaObject *mo = &LotsOfSignals::staticMetaObject;
+    QBENCHMARK {
+        (void)mo->indexOfSignal(p);
+    }
+}
+
 void tst_qmetaobject::unconnected_data()
 {
     QTest::addColumn<int>("signal_index");
@@ -28,6 +28,7 @@
 
 #include <qtest.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qvector.h>
 
 class tst_QMetaType : public QObject
 {
@@ -46,6 +47,8 @@ private slots:
     void typeBuiltinNotNormalized();
     void typeCustom();
     void typeCustomNotNormalized();
+    void typeCustomMany();
+    void registerTypedefs();
     void typeNotRegistered();
     void typeNotRegisteredNotNormalized();
 
@@ -157,6 +160,37 @@ void tst_QMetaType::typeCustomNotNormalized()
     }
 }
 
+static QVector<QByteArray> customTypeNames(const char *prefix, int count)
+{
+    QVector<QByteArray> names;
+    names.reserve(count);
+    for (int i = 0; i < count; ++i)
+        names.append(prefix + QByteArray::number(i));
+    return names;
+}
+
+// looking up a name among many registered custom types
+void tst_QMetaType::typeCustomMany()
+{
+    const QVector<QByteArray> names = customTypeNames("ManyFoo", 1500);
+    for (const QByteArray &name : names)
+        QMetaType::registerNormalizedTypedef(name, qRegisterMetaType<Foo>("Foo"));
+    QBENCHMARK {
+        for (const QByteArray &name : names)
+            QMetaType::type(name);
+    }
+}
+
+void tst_QMetaType::registerTypedefs()
+{
+    const int typeId = qRegisterMetaType<Foo>("Foo");
+    const QVector<QByteArray> names = customTypeNames("RegisteredFoo", 1500);
+    QBENCHMARK_ONCE {
+        for (const QByteArray &name : names)
+            QMetaType::registerNormalizedTypedef(name, typeId);
+    }
+}
+
 void tst_QMetaType::typeNotRegistered()
 {
     Q_ASSERT(QMetaType::type("Bar") == 0);
@@ -45,12 +45,20 @@ private slots:
     void signal_slot_benchmark_data();
     void signal_many_receivers();
     void signal_many_receivers_data();
+    void signal_emission_data();
+    void signal_emission();
     void qproperty_benchmark_data();
     void qproperty_benchmark();
     void dynamic_property_benchmark();
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void queued_signal_benchmark_data();
+    void queued_signal_benchmark();
+    void delete_later_benchmark_data();
+    void delete_later_benchmark();
+    void reparent_children_benchmark_data();
+    void reparent_children_benchmark();
 };
 
 struct Functor {
@@ -151,6 +159,34 @@ void QObjectBenchmark::signal_many_receivers()
     }
 }
 
+void QObjectBenchmark::signal_emission_data()
+{
+    QTest::addColumn<int>("receiverCount");
+    QTest::addColumn<bool>("disconnect");
+    QTest::newRow("0 receivers, never connected") << 0 << false;
+    QTest::newRow("0 receivers, disconnected") << 1 << true;
+    QTest::newRow("1 receiver") << 1 << false;
+    QTest::newRow("10 receivers") << 10 << false;
+}
+
+void QObjectBenchmark::signal_emission()
+{
+    QFETCH(int, receiverCount);
+    QFETCH(bool, disconnect);
+    Object sender;
+    std::vector<Object> receivers(receiverCount);
+
+    for (Object &receiver : receivers)
+        QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0);
+    if (disconnect)
+        QObject::disconnect(&sender, &Object::signal0, nullptr, nullptr);
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            sender.emitSignal0();
+    }
+}
+
 void QObjectBenchmark::qproperty_benchmark_data()
 {
     QTest::addColumn<QByteArray>("name");
@@ -258,6 +294,77 @@ void QObjectBenchmark::receiver_destroyed_benchmark()
     }
 }
 
+void QObjectBenchmark::queued_signal_benchmark_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::newRow("queued") << int(Qt::QueuedConnection);
+    QTest::newRow("batched") << int(Qt::QueuedConnection | Qt::BatchedConnection);
+    QTest::newRow("conflated") << int(Qt::QueuedConnection | Qt::ConflatedConnection);
+}
+
+void QObjectBenchmark::queued_signal_benchmark()
+{
+    QFETCH(int, type);
+    Object sender;
+    Object receiver;
+    QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0, Qt::ConnectionType(type));
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            sender.emitSignal0();
+        QCoreApplication::sendPostedEvents();
+    }
+}
+
+void QObjectBenchmark::delete_later_benchmark_data()
+{
+    QTest::addColumn<bool>("reverse");
+    QTest::newRow("children") << false;
+    QTest::newRow("children, reverse") << true;
+}
+
+void QObjectBenchmark::delete_later_benchmark()
+{
+    QFETCH(bool, reverse);
+    const int count = 20000;
+
+    QBENCHMARK {
+        QObject parent;
+        for (int i = 0; i < count; ++i)
+            new QObject(&parent);
+        const QObjectList children = parent.children();
+        for (int i = 0; i < count; ++i)
+            children.at(reverse ? count - 1 - i : i)->deleteLater();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+}
+
+void QObjectBenchmark::reparent_children_benchmark_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("100") << 100;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+void QObjectBenchmark::reparent_children_benchmark()
+{
+    QFETCH(int, count);
+    QObject parent;
+    QObject otherParent;
+    for (int i = 0; i < count; ++i)
+        new QObject(&parent);
+    QObjectList children = parent.children();
+    // reparent the children in a scattered order
+    for (int i = 0; i < count; ++i)
+        children.swap(i, (i * 7919) % count);
+
+    QBENCHMARK_ONCE {
+        for (QObject *child : qAsConst(children))
+            child->setParent(&otherParent);
+    }
+}
+
 QTEST_MAIN(QObjectBenchmark)
 
 #include "main.moc"
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtCore>
+#include <qtest.h>
+
+#include <vector>
+
+Q_DECLARE_METATYPE(Qt::TimerType)
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void startStop_data();
+    void startStop();
+    void restart_data();
+    void restart();
+};
+
+static void addTimerRows()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::TimerType>("timerType");
+
+    const int counts[] = { 1000, 10000, 100000 };
+    for (int count : counts) {
+        QTest::addRow("%d precise", count) << count << Qt::PreciseTimer;
+        QTest::addRow("%d coarse", count) << count << Qt::CoarseTimer;
+        QTest::addRow("%d very coarse", count) << count << Qt::VeryCoarseTimer;
+    }
+}
+
+// spread the intervals like idle timeouts of many connections would be
+static int interval(int i)
+{
+    return 1000 + (i * 7919) % 60000;
+}
+
+void tst_QTimer::startStop_data()
+{
+    addTimerRows();
+}
+
+void tst_QTimer::startStop()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, timerType);
+
+    QObject receiver;
+    std::vector<QBasicTimer> timers(count);
+
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            timers[i].start(interval(i), timerType, &receiver);
+        for (int i = 0; i < count; ++i)
+            timers[i].stop();
+    }
+}
+
+void tst_QTimer::restart_data()
+{
+    addTimerRows();
+}
+
+void tst_QTimer::restart()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, timerType);
+
+    QObject receiver;
+    std::vector<QBasicTimer> timers(count);
+    for (int i = 0; i < count; ++i)
+        timers[i].start(interval(i), timerType, &receiver);
+
+    // restarting a running timer stops it and starts it again, as a
+    // connection does with its idle timeout whenever it sees traffic
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            timers[i].start(interval(i), timerType, &receiver);
+        QCoreApplication::processEvents();
+    }
+
+    for (int i = 0; i < count; ++i)
+        timers[i].stop();
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "main.moc"
@@ -29,6 +29,7 @@
 #include <QtCore>
 #ifdef QT_GUI_LIB
 #  include <QtGui/QPixmap>
+#  include <QtGui/QColor>
 #endif
 #include <qtest.h>
 
@@ -52,9 +53,13 @@ private slots:
     void doubleVariantCreation();
     void floatVariantCreation();
     void rectVariantCreation();
+    void rectFVariantCreation();
+    void pointFVariantCreation();
+    void lineFVariantCreation();
     void stringVariantCreation();
 #ifdef QT_GUI_LIB
     void pixmapVariantCreation();
+    void colorVariantCreation();
 #endif
     void stringListVariantCreation();
     void bigClassVariantCreation();
@@ -64,6 +69,7 @@ private slots:
     void doubleVariantSetValue();
     void floatVariantSetValue();
     void rectVariantSetValue();
+    void rectFVariantSetValue();
     void stringVariantSetValue();
     void stringListVariantSetValue();
     void bigClassVariantSetValue();
@@ -76,9 +82,13 @@ private slots:
     void stringVariantAssignment();
     void stringListVariantAssignment();
 
+    void rectFVariantMove();
+    void stringVariantMove();
+
     void doubleVariantValue();
     void floatVariantValue();
     void rectVariantValue();
+    void rectFVariantValue();
     void stringVariantValue();
 
     void createCoreType_data();
@@ -173,6 +183,21 @@ void tst_qvariant::rectVariantCreation()
     variantCreation<QRect>(QRect(1, 2, 3, 4));
 }
 
+void tst_qvariant::rectFVariantCreation()
+{
+    variantCreation<QRectF>(QRectF(1, 2, 3, 4));
+}
+
+void tst_qvariant::pointFVariantCreation()
+{
+    variantCreation<QPointF>(QPointF(1, 2));
+}
+
+void tst_qvariant::lineFVariantCreation()
+{
+    variantCreation<QLineF>(QLineF(1, 2, 3, 4));
+}
+
 void tst_qvariant::stringVariantCreation()
 {
     variantCreation<QString>(QString());
@@ -183,6 +208,11 @@ void tst_qvariant::pixmapVariantCreation()
 {
     variantCreation<QPixmap>(QPixmap());
 }
+
+void tst_qvariant::colorVariantCreation()
+{
+    variantCreation<QColor>(QColor(Qt::red));
+}
 #endif
 
 void tst_qvariant::stringListVariantCreation()
@@ -232,6 +262,11 @@ void tst_qvariant::rectVariantSetValue()
     variantSetValue<QRect>(QRect());
 }
 
+void tst_qvariant::rectFVariantSetValue()
+{
+    variantSetValue<QRectF>(QRectF());
+}
+
 void tst_qvariant::stringVariantSetValue()
 {
     variantSetValue<QString>(QString());
@@ -293,6 +328,29 @@ void tst_qvariant::stringListVariantAssignment()
     variantAssignment<QStringList>(QStringList());
 }
 
+// Moving a QVariant around should neither allocate nor touch any refcount
+template <typename T>
+static void variantMove(T d)
+{
+    QVariant v(d);
+    QBENCHMARK {
+        for (int i = 0; i < ITERATION_COUNT; ++i) {
+            QVariant tmp(std::move(v));
+            v = std::move(tmp);
+        }
+    }
+}
+
+void tst_qvariant::rectFVariantMove()
+{
+    variantMove<QRectF>(QRectF(1, 2, 3, 4));
+}
+
+void tst_qvariant::stringVariantMove()
+{
+    variantMove<QString>(QStringLiteral("foo"));
+}
+
 void tst_qvariant::doubleVariantValue()
 {
     QVariant v(0.0);
@@ -323,6 +381,16 @@ void tst_qvariant::rectVariantValue()
     }
 }
 
+void tst_qvariant::rectFVariantValue()
+{
+    QVariant v(QRectF(1, 2, 3, 4));
+    QBENCHMARK {
+        for (int i = 0; i < ITERATION_COUNT; ++i) {
+            v.toRectF();
+        }
+    }
+}
+
 void tst_qvariant::stringVariantValue()
 {
     QVariant v = QString();
@@ -136,6 +136,18 @@ private slots:
     void contendedNative();
     void contendedQMutex();
     void contendedQMutexLocker();
+
+    void contendedShortNative_data();
+    void contendedShortQMutex_data() { contendedShortNative_data(); }
+    void contendedShortQMutexTimed_data() { contendedShortNative_data(); }
+
+    void contendedShortNative();
+    void contendedShortQMutex();
+    void contendedShortQMutexTimed();
+
+private:
+    template <typename Policy>
+    void contendedShort(typename Policy::Mutex *mutex);
 };
 
 QSemaphore tst_QMutex::semaphore1;
@@ -451,5 +463,117 @@ void tst_QMutex::contendedQMutexLocker()
     qDeleteAll(threads);
 }
 
+void tst_QMutex::contendedShortNative_data()
+{
+    QTest::addColumn<int>("iterations");
+    QTest::addColumn<int>("criticalSection");
+
+    QTest::newRow("empty") << 10000 << 0;
+    QTest::newRow("short") << 10000 << 20;
+    QTest::newRow("long") << 1000 << 2000;
+}
+
+struct NativeMutexPolicy
+{
+    typedef NativeMutexType Mutex;
+    static void lock(Mutex *mutex) { NativeMutexLock(mutex); }
+    static void unlock(Mutex *mutex) { NativeMutexUnlock(mutex); }
+};
+
+struct QMutexPolicy
+{
+    typedef QMutex Mutex;
+    static void lock(Mutex *mutex) { mutex->lock(); }
+    static void unlock(Mutex *mutex) { mutex->unlock(); }
+};
+
+struct QMutexTimedPolicy
+{
+    typedef QMutex Mutex;
+    static void lock(Mutex *mutex) { while (!mutex->tryLock(1)) { } }
+    static void unlock(Mutex *mutex) { mutex->unlock(); }
+};
+
+// Unlike the threads above, these don't yield between the lock/unlock pairs
+// and don't sleep while holding the lock: they keep hammering the same mutex,
+// so most lock() calls find it held by a thread that is about to release it.
+template <typename Policy>
+class ShortCriticalSectionThread : public QThread
+{
+    typename Policy::Mutex *mutex;
+    int iterations, criticalSection;
+    volatile int counter;
+public:
+    bool done;
+    ShortCriticalSectionThread(typename Policy::Mutex *mutex, int iterations, int criticalSection)
+        : mutex(mutex), iterations(iterations), criticalSection(criticalSection), counter(0), done(false)
+    { }
+    void run() {
+        forever {
+            tst_QMutex::semaphore1.release();
+            tst_QMutex::semaphore2.acquire();
+            if (done)
+                break;
+            for (int i = 0; i < iterations; ++i) {
+                Policy::lock(mutex);
+                for (int j = 0; j < criticalSection; ++j)
+                    counter = counter + 1;
+                Policy::unlock(mutex);
+            }
+            tst_QMutex::semaphore3.release();
+            tst_QMutex::semaphore4.acquire();
+        }
+    }
+};
+
+template <typename Policy>
+void tst_QMutex::contendedShort(typename Policy::Mutex *mutex)
+{
+    QFETCH(int, iterations);
+    QFETCH(int, criticalSection);
+
+    typedef ShortCriticalSectionThread<Policy> Thread;
+    QVector<Thread *> threads(threadCount);
+    for (int i = 0; i < threads.count(); ++i) {
+        threads[i] = new Thread(mutex, iterations, criticalSection);
+        threads[i]->start();
+    }
+
+    QBENCHMARK {
+        semaphore1.acquire(threadCount);
+        semaphore2.release(threadCount);
+        semaphore3.acquire(threadCount);
+        semaphore4.release(threadCount);
+    }
+
+    for (int i = 0; i < threads.count(); ++i)
+        threads[i]->done = true;
+    semaphore1.acquire(threadCount);
+    semaphore2.release(threadCount);
+    for (int i = 0; i < threads.count(); ++i)
+        threads[i]->wait();
+    qDeleteAll(threads);
+}
+
+void tst_QMutex::contendedShortNative()
+{
+    NativeMutexType mutex;
+    NativeMutexInitialize(&mutex);
+    contendedShort<NativeMutexPolicy>(&mutex);
+    NativeMutexDestroy(&mutex);
+}
+
+void tst_QMutex::contendedShortQMutex()
+{
+    QMutex mutex;
+    contendedShort<QMutexPolicy>(&mutex);
+}
+
+void tst_QMutex::contendedShortQMutexTimed()
+{
+    QMutex mutex;
+    contendedShort<QMutexTimedPolicy>(&mutex);
+}
+
 QTEST_MAIN(tst_QMutex)
 #include "tst_qmutex.moc"
@@ -63,7 +63,10 @@ private slots:
     void uncontended();
     void readOnly_data();
     void readOnly();
-    // void readWrite();
+    void writeOnly_data();
+    void writeOnly();
+    void readWrite_data();
+    void readWrite();
 };
 
 struct FunctionPtrHolder
@@ -179,5 +182,127 @@ void tst_QReadWriteLock::readOnly()
     holder.value();
 }
 
+static int global_counter;
+
+template <typename Mutex, typename Locker>
+void testWriteOnly()
+{
+    struct Thread : QThread
+    {
+        Mutex *lock;
+        void run()
+        {
+            for (int i = 0; i < Iterations; ++i) {
+                QString s = QString::number(i); // Do something outside the lock
+                Locker locker(lock);
+                global_counter += s.size(); // very short critical section
+            }
+        }
+    };
+    Mutex lock;
+    QVector<QThread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        auto t = new Thread;
+        t->lock = &lock;
+        threads.append(t);
+    }
+    QBENCHMARK {
+        for (auto t : threads) {
+            t->start();
+        }
+        for (auto t : threads) {
+            t->wait();
+        }
+    }
+    qDeleteAll(threads);
+}
+
+void tst_QReadWriteLock::writeOnly_data()
+{
+    QTest::addColumn<FunctionPtrHolder>("holder");
+
+    QTest::newRow("QMutex") << FunctionPtrHolder(testWriteOnly<QMutex, QMutexLocker>);
+    QTest::newRow("QReadWriteLock") << FunctionPtrHolder(testWriteOnly<QReadWriteLock, QWriteLocker>);
+    QTest::newRow("std::mutex") << FunctionPtrHolder(
+        testWriteOnly<std::mutex, LockerWrapper<std::unique_lock<std::mutex>>>);
+#if defined __cpp_lib_shared_timed_mutex
+    QTest::newRow("std::shared_timed_mutex") << FunctionPtrHolder(
+        testWriteOnly<std::shared_timed_mutex,
+                      LockerWrapper<std::unique_lock<std::shared_timed_mutex>>>);
+#endif
+}
+
+void tst_QReadWriteLock::writeOnly()
+{
+    QFETCH(FunctionPtrHolder, holder);
+    holder.value();
+}
+
+template <typename Mutex, typename ReadLocker, typename WriteLocker>
+void testReadWrite()
+{
+    struct Thread : QThread
+    {
+        Mutex *lock;
+        bool writer;
+        void run()
+        {
+            volatile int sink;
+            for (int i = 0; i < Iterations; ++i) {
+                QString s = QString::number(i); // Do something outside the lock
+                if (writer) {
+                    WriteLocker locker(lock);
+                    global_counter += s.size(); // very short critical section
+                } else {
+                    ReadLocker locker(lock);
+                    sink = global_counter + s.size(); // very short critical section
+                }
+            }
+        }
+    };
+    // a single writer, so that the readers only ever have it to wait for
+    Mutex lock;
+    QVector<QThread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        auto t = new Thread;
+        t->lock = &lock;
+        t->writer = (i == 0);
+        threads.append(t);
+    }
+    QBENCHMARK {
+        for (auto t : threads) {
+            t->start();
+        }
+        for (auto t : threads) {
+            t->wait();
+        }
+    }
+    qDeleteAll(threads);
+}
+
+void tst_QReadWriteLock::readWrite_data()
+{
+    QTest::addColumn<FunctionPtrHolder>("holder");
+
+    QTest::newRow("QMutex") << FunctionPtrHolder(testReadWrite<QMutex, QMutexLocker, QMutexLocker>);
+    QTest::newRow("QReadWriteLock") << FunctionPtrHolder(
+        testReadWrite<QReadWriteLock, QReadLocker, QWriteLocker>);
+    QTest::newRow("std::mutex") << FunctionPtrHolder(
+        testReadWrite<std::mutex, LockerWrapper<std::unique_lock<std::mutex>>,
+                      LockerWrapper<std::unique_lock<std::mutex>>>);
+#if defined __cpp_lib_shared_timed_mutex
+    QTest::newRow("std::shared_timed_mutex") << FunctionPtrHolder(
+        testReadWrite<std::shared_timed_mutex,
+                      LockerWrapper<std::shared_lock<std::shared_timed_mutex>>,
+                      LockerWrapper<std::unique_lock<std::shared_timed_mutex>>>);
+#endif
+}
+
+void tst_QReadWriteLock::readWrite()
+{
+    QFETCH(FunctionPtrHolder, holder);
+    holder.value();
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_qreadwritelock.moc"
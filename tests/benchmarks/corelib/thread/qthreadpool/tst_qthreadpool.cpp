@@ -39,7 +39,11 @@ public:
 
 private slots:
     void startRunnables();
+    void submitMany_data();
+    void submitMany();
     void activeThreadCount();
+    void nestedRunnables_data();
+    void nestedRunnables();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -66,6 +70,37 @@ void tst_QThreadPool::startRunnables()
     }
 }
 
+void tst_QThreadPool::submitMany_data()
+{
+    QTest::addColumn<bool>("batch");
+
+    QTest::newRow("start") << false;
+    QTest::newRow("startBatch") << true;
+}
+
+void tst_QThreadPool::submitMany()
+{
+    QFETCH(bool, batch);
+
+    // submitting a large number of tiny tasks at once, including the time
+    // the pool needs to run them
+    enum { TaskCount = 50000 };
+    QThreadPool threadPool;
+    QVector<QRunnable *> runnables;
+    QBENCHMARK {
+        runnables.resize(TaskCount);
+        for (QRunnable *&runnable : runnables)
+            runnable = new NoOpRunnable();
+        if (batch) {
+            threadPool.startBatch(runnables);
+        } else {
+            for (QRunnable *runnable : qAsConst(runnables))
+                threadPool.start(runnable);
+        }
+        threadPool.waitForDone();
+    }
+}
+
 void tst_QThreadPool::activeThreadCount()
 {
     QThreadPool threadPool;
@@ -75,5 +110,70 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+class NestedRunnable : public QRunnable
+{
+public:
+    enum { Fanout = 16 };
+
+    NestedRunnable(QThreadPool *pool, QSemaphore *done, int depth)
+        : pool(pool), done(done), depth(depth)
+    {
+    }
+
+    void run() override {
+        if (depth > 0) {
+            for (int i = 0; i < Fanout; ++i)
+                pool->start(new NestedRunnable(pool, done, depth - 1));
+            return;
+        }
+        // a little bit of work, so that this measures more than the queue
+        uint hash = 0;
+        for (int i = 0; i < 200; ++i)
+            hash = hash * 31 + i;
+        sink.fetchAndAddRelaxed(int(hash & 1));
+        done->release();
+    }
+
+    static QAtomicInt sink;
+
+private:
+    QThreadPool *pool;
+    QSemaphore *done;
+    int depth;
+};
+
+QAtomicInt NestedRunnable::sink;
+
+void tst_QThreadPool::nestedRunnables_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("workStealing");
+
+    for (int threadCount : {1, 2, 4, 8, 16, 32}) {
+        const QByteArray threads = QByteArray::number(threadCount) + " threads";
+        QTest::newRow((threads + ", shared queue").constData()) << threadCount << false;
+        QTest::newRow((threads + ", work stealing").constData()) << threadCount << true;
+    }
+}
+
+void tst_QThreadPool::nestedRunnables()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+
+    // 16^3 = 4096 leaf runnables per iteration, started from pool threads
+    const int depth = 3;
+    const int leafCount = NestedRunnable::Fanout * NestedRunnable::Fanout * NestedRunnable::Fanout;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(workStealing);
+    QSemaphore done;
+    QBENCHMARK {
+        threadPool.start(new NestedRunnable(&threadPool, &done, depth));
+        done.acquire(leafCount);
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
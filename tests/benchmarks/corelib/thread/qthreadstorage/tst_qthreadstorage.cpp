@@ -47,10 +47,26 @@ public slots:
 
 private slots:
     void construct();
+    void get_data();
     void get();
+    void set_data();
     void set();
+    void getInThreads();
 };
 
+// Enough live storages to push the "many" ones past the ids kept in
+// native thread-local slots.
+enum { ManyStorages = 64 };
+
+static QThreadStorage<int *> *createStorage(bool many, QList<QThreadStorage<int *> *> *padding)
+{
+    if (many) {
+        for (int i = 0; i < ManyStorages; ++i)
+            padding->append(new QThreadStorage<int *>);
+    }
+    return new QThreadStorage<int *>;
+}
+
 tst_QThreadStorage::tst_QThreadStorage()
 {
 }
@@ -79,31 +95,86 @@ void tst_QThreadStorage::construct()
 }
 
 
+void tst_QThreadStorage::get_data()
+{
+    QTest::addColumn<bool>("many");
+
+    QTest::newRow("few storages") << false;
+    QTest::newRow("many storages") << true;
+}
+
 void tst_QThreadStorage::get()
 {
-    QThreadStorage<int *> ts;
-    ts.setLocalData(new int(45));
+    QFETCH(bool, many);
+    QList<QThreadStorage<int *> *> padding;
+    QScopedPointer<QThreadStorage<int *> > ts(createStorage(many, &padding));
+    ts->setLocalData(new int(45));
 
     int count = 0;
     QBENCHMARK {
-        int *i = ts.localData();
+        int *i = ts->localData();
         count += *i;
     }
-    ts.setLocalData(0);
+    ts->setLocalData(0);
+    qDeleteAll(padding);
+}
+
+void tst_QThreadStorage::set_data()
+{
+    get_data();
 }
 
 void tst_QThreadStorage::set()
 {
-    QThreadStorage<int *> ts;
+    QFETCH(bool, many);
+    QList<QThreadStorage<int *> *> padding;
+    QScopedPointer<QThreadStorage<int *> > ts(createStorage(many, &padding));
 
     int count = 0;
     QBENCHMARK {
-        ts.setLocalData(new int(count));
+        ts->setLocalData(new int(count));
         count++;
     }
-    ts.setLocalData(0);
+    ts->setLocalData(0);
+    qDeleteAll(padding);
 }
 
+void tst_QThreadStorage::getInThreads()
+{
+    // each thread lazily creates its value and then reads it back in a loop,
+    // the typical pattern of a per-thread cache
+    QThreadStorage<int *> ts;
+    const int threadCount = qMax(2, QThread::idealThreadCount());
+
+    class Thread : public QThread
+    {
+    public:
+        QThreadStorage<int *> *ts;
+        void run() override
+        {
+            int count = 0;
+            for (int i = 0; i < 1000000; ++i) {
+                if (!ts->hasLocalData())
+                    ts->setLocalData(new int(i));
+                count += *ts->localData();
+            }
+        }
+    };
+
+    QVector<Thread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        Thread *t = new Thread;
+        t->ts = &ts;
+        threads.append(t);
+    }
+    QBENCHMARK {
+        for (Thread *t : threads)
+            t->start();
+        for (Thread *t : threads)
+            t->wait();
+    }
+    qDeleteAll(threads);
+}
 
 QTEST_MAIN(tst_QThreadStorage)
 #include "tst_qthreadstorage.moc"
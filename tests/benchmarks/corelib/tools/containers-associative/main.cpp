@@ -26,6 +26,8 @@
 **
 ****************************************************************************/
 #include <QString>
+#include <QRandomGenerator>
+#include <private/qflatmap_p.h>
 
 #include <qtest.h>
 
@@ -37,6 +39,10 @@ private slots:
     void insert();
     void lookup_data();
     void lookup();
+    void iterate_data();
+    void iterate();
+    void lookup_small_data();
+    void lookup_small();
 };
 
 template <typename T>
@@ -125,5 +131,114 @@ void tst_associative_containers::lookup()
     }
 }
 
+void tst_associative_containers::iterate_data()
+{
+    QTest::addColumn<bool>("useHash");
+    QTest::addColumn<int>("size");
+
+    for (int size = 10; size < 20000; size += 100) {
+
+        const QByteArray sizeString = QByteArray::number(size);
+
+        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
+        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
+    }
+}
+
+template <typename T>
+void testIterate(int size)
+{
+    T container;
+
+    for (int i = 0; i < size; ++i)
+        container.insert(i, i);
+
+    int sum = 0;
+
+    QBENCHMARK {
+        for (typename T::const_iterator it = container.constBegin(), end = container.constEnd(); it != end; ++it)
+            sum += it.value();
+    }
+    Q_UNUSED(sum);
+}
+
+void tst_associative_containers::iterate()
+{
+    QFETCH(bool, useHash);
+    QFETCH(int, size);
+
+    if (useHash) {
+        testIterate<QHash<int, int> >(size);
+    } else {
+        testIterate<QMap<int, int> >(size);
+    }
+}
+
+void tst_associative_containers::lookup_small_data()
+{
+    // maps of the size QSettings and similar users have, looked up in random order
+    QTest::addColumn<bool>("useFlatMap");
+    QTest::addColumn<bool>("stringKeys");
+    QTest::addColumn<int>("size");
+
+    for (int size : {10, 50, 100, 200, 500}) {
+        const QByteArray sizeString = QByteArray::number(size);
+
+        QTest::newRow(QByteArray("map-int--" + sizeString).constData()) << false << false << size;
+        QTest::newRow(QByteArray("flatmap-int--" + sizeString).constData()) << true << false << size;
+        QTest::newRow(QByteArray("map-string--" + sizeString).constData()) << false << true << size;
+        QTest::newRow(QByteArray("flatmap-string--" + sizeString).constData()) << true << true << size;
+    }
+}
+
+template <typename T, typename Key>
+void testLookupSmall(const QVector<Key> &keys)
+{
+    T container;
+    for (int i = 0; i < keys.size(); ++i)
+        container.insert(keys.at(i), i);
+
+    QVector<int> order;
+    QRandomGenerator rng(keys.size());
+    for (int i = 0; i < 4096; ++i)
+        order.append(int(rng.bounded(keys.size())));
+
+    volatile int sink = 0;
+
+    QBENCHMARK {
+        int sum = 0;
+        for (int i : qAsConst(order))
+            sum += container.value(keys.at(i));
+        sink = sum;
+    }
+    Q_UNUSED(sink);
+}
+
+void tst_associative_containers::lookup_small()
+{
+    QFETCH(bool, useFlatMap);
+    QFETCH(bool, stringKeys);
+    QFETCH(int, size);
+
+    QVector<int> intKeys;
+    QVector<QString> stringKeyList;
+    for (int i = 0; i < size; ++i) {
+        intKeys.append(i * 7919 % 100003);
+        stringKeyList.append(QLatin1String("group/subgroup/key") + QString::number(intKeys.last()));
+    }
+
+    if (stringKeys) {
+        if (useFlatMap)
+            testLookupSmall<QFlatMap<QString, int> >(stringKeyList);
+        else
+            testLookupSmall<QMap<QString, int> >(stringKeyList);
+    } else {
+        if (useFlatMap)
+            testLookupSmall<QFlatMap<int, int> >(intKeys);
+        else
+            testLookupSmall<QMap<int, int> >(intKeys);
+    }
+}
+
 QTEST_MAIN(tst_associative_containers)
 #include "main.moc"
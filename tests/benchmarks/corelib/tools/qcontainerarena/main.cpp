@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QContainerArena>
+#include <QString>
+#include <QVarLengthArray>
+#include <QVector>
+
+class tst_QContainerArena : public QObject
+{
+    Q_OBJECT
+private slots:
+    void buildGraph_data();
+    void buildGraph();
+};
+
+void tst_QContainerArena::buildGraph_data()
+{
+    QTest::addColumn<bool>("useArena");
+    QTest::addColumn<int>("records");
+
+    for (int records : {100, 1000, 10000}) {
+        const QByteArray size = QByteArray::number(records);
+        QTest::newRow(("heap--" + size).constData()) << false << records;
+        QTest::newRow(("arena--" + size).constData()) << true << records;
+    }
+}
+
+struct Record
+{
+    QString name;
+    QVector<double> samples;
+    QVector<QString> tags;
+};
+Q_DECLARE_TYPEINFO(Record, Q_MOVABLE_TYPE);
+
+// builds and throws away the kind of data a request handler parses and
+// formats; strings stay on the heap, the vectors use the arena
+static int buildRecords(int records)
+{
+    QVector<Record> graph;
+    graph.reserve(records);
+    for (int i = 0; i < records; ++i) {
+        Record record;
+        record.name = QLatin1String("record-") + QString::number(i);
+        for (int j = 0; j < 16; ++j)
+            record.samples.append(i * 0.5 + j);
+        for (int j = 0; j < 4; ++j)
+            record.tags.append(QString::number(i * 4 + j, 16));
+        QVarLengthArray<ushort, 16> checksum;
+        for (QChar c : record.name)
+            checksum.append(c.unicode());
+        record.tags.append(QString::number(qChecksum(reinterpret_cast<const char *>(checksum.constData()),
+                                                     uint(checksum.size() * sizeof(ushort)))));
+        graph.append(std::move(record));
+    }
+
+    int total = 0;
+    for (const Record &record : qAsConst(graph))
+        total += record.name.size() + record.samples.size() + record.tags.size();
+    return total;
+}
+
+void tst_QContainerArena::buildGraph()
+{
+    QFETCH(bool, useArena);
+    QFETCH(int, records);
+
+    QContainerArena arena(64 * 1024);
+    volatile int sink = 0;
+    QBENCHMARK {
+        if (useArena) {
+            {
+                QContainerArenaScope scope(&arena);
+                sink = buildRecords(records);
+            }
+            arena.release();
+        } else {
+            sink = buildRecords(records);
+        }
+    }
+    Q_UNUSED(sink);
+}
+
+QTEST_APPLESS_MAIN(tst_QContainerArena)
+
+#include "main.moc"
@@ -0,0 +1,3 @@
+TARGET = tst_bench_qcontainerarena
+QT = testlib
+SOURCES += main.cpp
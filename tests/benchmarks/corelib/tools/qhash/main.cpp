@@ -52,6 +52,11 @@ private slots:
     void qhash_javaString_data() { data(); }
     void qhash_javaString() { qhash_template<JavaString>(); }
 
+    void lookup_current_data() { data(); }
+    void lookup_current() { lookup_template<QString>(); }
+    void lookup_miss_current_data() { data(); }
+    void lookup_miss_current() { lookup_miss_template<QString>(); }
+
     void hashing_current_data() { data(); }
     void hashing_current() { hashing_template<QString>(); }
     void hashing_qt50_data() { data(); }
@@ -61,10 +66,21 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void hashing_sizes_qstring_data() { hashing_sizes_data(); }
+    void hashing_sizes_qstring() { hashing_sizes_template<QString>(); }
+    void hashing_sizes_qbytearray_data() { hashing_sizes_data(); }
+    void hashing_sizes_qbytearray() { hashing_sizes_template<QByteArray>(); }
+    void hashing_sizes_qlatin1string_data() { hashing_sizes_data(); }
+    void hashing_sizes_qlatin1string();
+
 private:
     void data();
+    void hashing_sizes_data();
     template <typename String> void qhash_template();
+    template <typename String> void lookup_template();
+    template <typename String> void lookup_miss_template();
     template <typename String> void hashing_template();
+    template <typename String> void hashing_sizes_template();
 
     QStringList smallFilePaths;
     QStringList uuids;
@@ -152,6 +168,47 @@ template <typename String> void tst_QHash::qhash_template()
     }
 }
 
+template <typename String> void tst_QHash::lookup_template()
+{
+    QFETCH(QStringList, items);
+    QHash<String, int> hash;
+
+    QList<String> realitems;
+    foreach (const QString &s, items)
+        realitems.append(s);
+    for (int i = 0, n = realitems.size(); i != n; ++i)
+        hash.insert(realitems.at(i), i);
+
+    int found = 0;
+    QBENCHMARK {
+        for (int i = 0, n = realitems.size(); i != n; ++i)
+            found += hash.contains(realitems.at(i));
+    }
+    QCOMPARE(found % realitems.size(), 0);
+}
+
+template <typename String> void tst_QHash::lookup_miss_template()
+{
+    QFETCH(QStringList, items);
+    QHash<String, int> hash;
+
+    QList<String> realitems;
+    QList<String> missing;
+    foreach (const QString &s, items) {
+        realitems.append(s);
+        missing.append(s + QLatin1Char('*'));
+    }
+    for (int i = 0, n = realitems.size(); i != n; ++i)
+        hash.insert(realitems.at(i), i);
+
+    int found = 0;
+    QBENCHMARK {
+        for (int i = 0, n = missing.size(); i != n; ++i)
+            found += hash.contains(missing.at(i));
+    }
+    QCOMPARE(found, 0);
+}
+
 template <typename String> void tst_QHash::hashing_template()
 {
     // just the hashing function
@@ -168,6 +225,70 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+void tst_QHash::hashing_sizes_data()
+{
+    // keys of a fixed length, hashed with the seed QHash uses
+    QTest::addColumn<int>("size");
+    QTest::newRow("8") << 8;
+    QTest::newRow("16") << 16;
+    QTest::newRow("24") << 24;
+    QTest::newRow("64") << 64;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+static QByteArrayList fixedSizeKeys(int size)
+{
+    QByteArrayList keys;
+    for (int i = 0; i < 1000; ++i) {
+        QByteArray key = QByteArray::number(i * 7919).repeated(size);
+        key.truncate(size);
+        keys.append(key);
+    }
+    return keys;
+}
+
+template <typename String> void tst_QHash::hashing_sizes_template()
+{
+    QFETCH(int, size);
+
+    QVector<String> keys;
+    foreach (const QByteArray &key, fixedSizeKeys(size))
+        keys.append(String(key));
+    const uint seed = uint(qGlobalQHashSeed());
+
+    // qHash() is pure, keep its result alive
+    volatile uint sink = 0;
+    QBENCHMARK {
+        uint result = 0;
+        for (int i = 0, n = keys.size(); i != n; ++i)
+            result += qHash(keys.at(i), seed);
+        sink = result;
+    }
+    Q_UNUSED(sink);
+}
+
+void tst_QHash::hashing_sizes_qlatin1string()
+{
+    QFETCH(int, size);
+
+    const QByteArrayList data = fixedSizeKeys(size);
+    QVector<QLatin1String> keys;
+    foreach (const QByteArray &key, data)
+        keys.append(QLatin1String(key));
+    const uint seed = uint(qGlobalQHashSeed());
+
+    // qHash() is pure, keep its result alive
+    volatile uint sink = 0;
+    QBENCHMARK {
+        uint result = 0;
+        for (int i = 0, n = keys.size(); i != n; ++i)
+            result += qHash(keys.at(i), seed);
+        sink = result;
+    }
+    Q_UNUSED(sink);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "main.moc"
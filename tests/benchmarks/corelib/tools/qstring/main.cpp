@@ -49,6 +49,17 @@ private slots:
     void toCaseFolded_data();
     void toCaseFolded();
 
+    void indexOf_data();
+    void indexOf();
+    void indexOf_matcher_data() { indexOf_data(); }
+    void indexOf_matcher();
+    void indexOf_bytearray_data() { indexOf_data(); }
+    void indexOf_bytearray();
+    void contains_data() { indexOf_data(); }
+    void contains();
+    void split_data();
+    void split();
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
@@ -188,6 +199,114 @@ void tst_QString::toCaseFolded()
     }
 }
 
+static QString searchText(int size)
+{
+    // prose, so that the first and last characters of the needles are common
+    static const char sentence[] = "The quick brown fox jumps over the lazy dog, then naps. ";
+    QString text;
+    text.reserve(size + int(sizeof(sentence)));
+    while (text.size() < size)
+        text += QLatin1String(sentence);
+    text.truncate(size);
+    return text;
+}
+
+void tst_QString::indexOf_data()
+{
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<QString>("needle");
+
+    // the needles only occur at the end of the haystack
+    const char *const needles[] = {
+        "Tx",
+        "the lazy cat",
+        "the quick brown cat, then",
+        "The quick brown fox jumps over the lazy cat, then naps. "
+    };
+    for (int size : {100, 1000, 100000}) {
+        for (const char *needle : needles) {
+            const QString n = QLatin1String(needle);
+            QTest::addRow("%d:%d", size, n.size()) << (searchText(size) + n) << n;
+        }
+    }
+}
+
+void tst_QString::indexOf()
+{
+    QFETCH(QString, haystack);
+    QFETCH(QString, needle);
+
+    volatile int sink = 0;
+    QBENCHMARK {
+        sink = haystack.indexOf(needle);
+    }
+    QCOMPARE(int(sink), haystack.size() - needle.size());
+}
+
+void tst_QString::indexOf_matcher()
+{
+    QFETCH(QString, haystack);
+    QFETCH(QString, needle);
+
+    // Boyer-Moore, including the skip table setup, for comparison
+    volatile int sink = 0;
+    QBENCHMARK {
+        sink = QStringMatcher(needle).indexIn(haystack);
+    }
+    QCOMPARE(int(sink), haystack.size() - needle.size());
+}
+
+void tst_QString::indexOf_bytearray()
+{
+    QFETCH(QString, haystack);
+    QFETCH(QString, needle);
+    const QByteArray h = haystack.toLatin1();
+    const QByteArray n = needle.toLatin1();
+
+    volatile int sink = 0;
+    QBENCHMARK {
+        sink = h.indexOf(n);
+    }
+    QCOMPARE(int(sink), h.size() - n.size());
+}
+
+void tst_QString::contains()
+{
+    QFETCH(QString, haystack);
+    QFETCH(QString, needle);
+    const QStringRef ref(&haystack);
+
+    volatile bool sink = false;
+    QBENCHMARK {
+        sink = ref.contains(needle);
+    }
+    QVERIFY(sink);
+}
+
+void tst_QString::split_data()
+{
+    QTest::addColumn<QString>("s");
+    QTest::addColumn<QString>("separator");
+
+    for (int size : {1000, 100000}) {
+        QTest::addRow("%d:\", \"", size) << searchText(size) << QStringLiteral(", ");
+        QTest::addRow("%d:\"the \"", size) << searchText(size) << QStringLiteral("the ");
+        QTest::addRow("%d:\"naps. \"", size) << searchText(size) << QStringLiteral("naps. ");
+    }
+}
+
+void tst_QString::split()
+{
+    QFETCH(QString, s);
+    QFETCH(QString, separator);
+
+    volatile int sink = 0;
+    QBENCHMARK {
+        sink = s.split(separator).size();
+    }
+    QVERIFY(sink > 1);
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "main.moc"
@@ -3,6 +3,7 @@ SUBDIRS = \
         containers-associative \
         containers-sequential \
         qbytearray \
+        qcontainerarena \
         qcontiguouscache \
         qcryptographichash \
         qdatetime \